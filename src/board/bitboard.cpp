@@ -0,0 +1,92 @@
+#include "bitboard.h"
+
+#include <bit>
+
+namespace TriangleGame {
+
+	bitboard::bitboard(int height)
+		: _height(height), _stride(height + 1)
+	{
+		std::size_t bits = (std::size_t)_height * _stride;
+		_words = (bits + 63) / 64;
+
+		//a jump shifts by at most two diagonal steps
+		_padding = (2 * (std::size_t)_stride + 2) / 64 + 1;
+
+		_occupied = t_words(_words + 2 * _padding, 0);
+		_valid = t_words(_words + 2 * _padding, 0);
+
+		for (int row = 0; row < _height; row++) {
+			for (int index = 0; index <= row; index++) {
+				std::size_t bit = bit_of(row, index);
+				_valid[_padding + bit / 64] |= t_word(1) << (bit % 64);
+			}
+		}
+	}
+
+	int bitboard::get_height() const noexcept {
+		return _height;
+	}
+
+	int bitboard::get_stride() const noexcept {
+		return _stride;
+	}
+
+	std::size_t bitboard::word_count() const noexcept {
+		return _words;
+	}
+
+	std::size_t bitboard::padding() const noexcept {
+		return _padding;
+	}
+
+	const t_word* bitboard::data() const noexcept {
+		return _occupied.data() + _padding;
+	}
+
+	const t_word* bitboard::valid() const noexcept {
+		return _valid.data() + _padding;
+	}
+
+	bool bitboard::is_set(int row, int index) const noexcept {
+		std::size_t bit = bit_of(row, index);
+		return (_occupied[_padding + bit / 64] >> (bit % 64)) & 1;
+	}
+
+	void bitboard::set(int row, int index) noexcept {
+		std::size_t bit = bit_of(row, index);
+		_occupied[_padding + bit / 64] |= t_word(1) << (bit % 64);
+	}
+
+	void bitboard::clear(int row, int index) noexcept {
+		std::size_t bit = bit_of(row, index);
+		_occupied[_padding + bit / 64] &= ~(t_word(1) << (bit % 64));
+	}
+
+	void bitboard::fill() noexcept {
+		_occupied = _valid;
+	}
+
+	int bitboard::count() const noexcept {
+		int total = 0;
+		for (const auto& w : _occupied)
+			total += std::popcount(w);
+		return total;
+	}
+
+	std::size_t bitboard::bit_of(int row, int index) const noexcept {
+		return (std::size_t)row * _stride + index;
+	}
+
+	int bitboard::peg_number_of(std::size_t bit) const noexcept {
+		int row = (int)(bit / _stride);
+		int index = (int)(bit % _stride);
+		return (row * (row + 1)) / 2 + index + 1;
+	}
+
+	bool bitboard::operator==(const bitboard& other) const {
+		return _height == other._height
+			&& _occupied == other._occupied;
+	}
+
+}
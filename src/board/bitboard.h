@@ -0,0 +1,158 @@
+/**
+ * @file bitboard.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the bitboard class, a packed occupancy bitset of the game board.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_BITBOARD__
+#define __H_TRIANGLE_BITBOARD__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace TriangleGame {
+
+	typedef std::uint64_t t_word; //!< A single word (lane) of the bitboard.
+	typedef std::vector<t_word> t_words; //!< A list of bitboard words.
+
+	/**
+	 * @brief The Bitboard Class, a packed occupancy bitset of a triangle board.
+	 *
+	 * Each row of the triangle is stored with a fixed stride of (height + 1) bits,
+	 * so the peg at (row, index) lives at bit (row * stride + index). With this layout
+	 * every one of the six jump directions is a constant bit shift:
+	 * +/-1 along a row, +/-stride straight down/up, and +/-(stride + 1) diagonally.
+	 * The extra, always empty, bit at the end of each row stops shifts from wrapping
+	 * a peg onto the neighbouring row.
+	 *
+	 * The words are surrounded with zero padding, large enough to cover the
+	 * largest jump shift, so vectorized kernels can load neighbouring words
+	 * without any bounds checks.
+	 */
+	class bitboard {
+		public:
+			/**
+			 * @brief Construct a new, empty, bitboard for a board of the given height.
+			 *
+			 * @param height The height of the board, the number of rows.
+			 */
+			bitboard(int height);
+
+			/**
+			 * @brief Returns the height of the board.
+			 *
+			 * @return int The height of the board.
+			 */
+			int get_height() const noexcept;
+
+			/**
+			 * @brief Returns the number of bits used by each row.
+			 *
+			 * @return int The row stride, in bits.
+			 */
+			int get_stride() const noexcept;
+
+			/**
+			 * @brief Returns the number of words holding the board, excluding padding.
+			 *
+			 * @return std::size_t The number of words.
+			 */
+			std::size_t word_count() const noexcept;
+
+			/**
+			 * @brief Returns the number of zero words padding each side of the board.
+			 *
+			 * @return std::size_t The number of padding words.
+			 */
+			std::size_t padding() const noexcept;
+
+			/**
+			 * @brief Returns the occupancy words, the first word of the board (not the padding).
+			 * Words before and after the board, up to padding(), are readable and always zero.
+			 *
+			 * @return const t_word* The occupancy words.
+			 */
+			const t_word* data() const noexcept;
+
+			/**
+			 * @brief Returns the mask of valid holes, with the same layout and padding as data().
+			 *
+			 * @return const t_word* The valid hole words.
+			 */
+			const t_word* valid() const noexcept;
+
+			/**
+			 * @brief Determinds if there is a peg at the given row and index.
+			 *
+			 * @param row The row of the hole.
+			 * @param index The index of the hole.
+			 * @return true If the hole has a peg in it.
+			 * @return false If the hole is empty.
+			 */
+			bool is_set(int row, int index) const noexcept;
+
+			/**
+			 * @brief Places a peg at the given row and index.
+			 *
+			 * @param row The row of the hole.
+			 * @param index The index of the hole.
+			 */
+			void set(int row, int index) noexcept;
+
+			/**
+			 * @brief Removes the peg at the given row and index.
+			 *
+			 * @param row The row of the hole.
+			 * @param index The index of the hole.
+			 */
+			void clear(int row, int index) noexcept;
+
+			/**
+			 * @brief Fills every hole on the board with a peg.
+			 */
+			void fill() noexcept;
+
+			/**
+			 * @brief Counts the number of pegs on the board.
+			 *
+			 * @return int The number of pegs.
+			 */
+			int count() const noexcept;
+
+			/**
+			 * @brief Calculates the bit position of the given row and index.
+			 *
+			 * @param row The row of the hole.
+			 * @param index The index of the hole.
+			 * @return std::size_t The bit position of the hole.
+			 */
+			std::size_t bit_of(int row, int index) const noexcept;
+
+			/**
+			 * @brief Calculates the peg number of the given bit position.
+			 *
+			 * @param bit The bit position of the hole.
+			 * @return int The peg number of the hole.
+			 */
+			int peg_number_of(std::size_t bit) const noexcept;
+
+			bool operator==(const bitboard& other) const;
+
+		private:
+			int _height; //!< The height of the board.
+			int _stride; //!< The number of bits per row.
+			std::size_t _words; //!< The number of words, excluding the padding.
+			std::size_t _padding; //!< The number of padding words on each side.
+			t_words _occupied; //!< The padded occupancy words.
+			t_words _valid; //!< The padded valid hole words.
+	};
+
+}
+
+#endif
@@ -1,15 +1,30 @@
 #include "board.h"
+#include "trace.h"
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 namespace TriangleGame {
 
 	board::board(int height)
-		: _height(height), _history(move_history())
+		: _height(height), _triangle(true), _jumps(_jumps_of(height)), _history(move_history())
 		{
 			_total_pegs = peg::FindLastPegNumber(height);
 			_total_pegs_removed = 0;
 			_init_pegs();
 		}
 
+	board::board(const topology& geometry)
+		: _height(geometry.get_rows()), _triangle(false), _jumps(_jumps_of(geometry)), _history(move_history())
+		{
+			_total_pegs = geometry.get_hole_count();
+			_total_pegs_removed = 0;
+			_init_pegs();
+		}
+
+	bool board::is_triangle() const noexcept {
+		return _triangle;
+	}
+
 	int board::get_total_pegs() {
 		return _total_pegs;
 	}
@@ -30,7 +45,7 @@ namespace TriangleGame {
 
 	bool board::get_peg(int pegNumber, peg& p) {
 		int row, index;
-		peg::LocatePeg(pegNumber, row, index, _height);
+		if (!_locate(pegNumber, row, index)) return false;
 		return get_peg(row, index, p);
 	}
 
@@ -45,7 +60,7 @@ namespace TriangleGame {
 
 	bool board::add_peg(int pegNumber) {
 		int row, index;
-		peg::LocatePeg(pegNumber, row, index, _height);
+		if (!_locate(pegNumber, row, index)) return false;
 		return add_peg(row, index);
 	}
 
@@ -54,6 +69,7 @@ namespace TriangleGame {
 	}
 
 	bool board::remove_peg(int row, int index) {
+		if (!_validate(row, index)) return false;
 		if (!_pegs[row][index].remove()) return false;
 		_total_pegs_removed++;
 		return true;
@@ -61,7 +77,7 @@ namespace TriangleGame {
 
 	bool board::remove_peg(int pegNumber) {
 		int row, index;
-		peg::LocatePeg(pegNumber, row, index);
+		if (!_locate(pegNumber, row, index)) return false;
 		return remove_peg(row, index);
 	}
 
@@ -70,34 +86,23 @@ namespace TriangleGame {
 	}
 
 	bool board::validate_move(const peg& fromPeg, const peg& toPeg) {	
-		if (fromPeg.is_removed()) return false;
-		if (!toPeg.is_removed()) return false;
-
-		//validate jump
-		auto dist = -1;
-		if (fromPeg.get_row() == toPeg.get_row()) {
-			dist = abs(fromPeg.get_index() - toPeg.get_index());
-		} else {
-			dist = abs(fromPeg.get_row() - toPeg.get_row());
-		}
-		if (dist != 2) return false;
-
-		peg middle;
-		_find_middle_peg(fromPeg, toPeg, middle);
-		return !middle.is_removed();
+		t_board_jump_id id;
+		return find_jump(fromPeg.get_number(), toPeg.get_number(), id) && can_make(id);
 	}
 
 	bool board::is_peg_removed(int pegNumber) {
 		int row, index;
-		peg::LocatePeg(pegNumber, row, index);
+		if (!_locate(pegNumber, row, index)) return true;
 		return _pegs[row][index].is_removed();
 	}
 
 	bool board::remove_inital_peg(int pegNumber) {
-		if (!remove_peg(pegNumber))
+		peg p;
+		if (!get_peg(pegNumber, p) || !remove_peg(p))
 			return false;
 
-		_history.add_move(pegNumber);
+		_history.add_move(p);
+		_record_checkpoint();
 		return true;
 	}
 
@@ -106,114 +111,114 @@ namespace TriangleGame {
 		if (!_history.try_get_move(_history.get_index(), m))
 			return false;
 
-		if (m.is_inital_move()) {
-			add_peg(m.get_removed());
-		} else {
-			add_peg(m.get_from());
-			add_peg(m.get_removed());
-			remove_peg(m.get_to());
-		}
-
+		_unapply(m);
 		_history.go_back();
 		return true;
 	}
 
-	bool board::move_peg(const peg& fromPeg, const peg& toPeg) {
-		if (!validate_move(fromPeg, toPeg)) return false;
+	bool board::go_forward() {
+		move m;
+		if (!_history.can_go_forward())
+			return false;
+		if (!_history.try_get_move(_history.get_index() + 1, m))
+			return false;
 
-		remove_peg(fromPeg);
-		add_peg(toPeg);
+		_apply(m);
+		_history.go_forward();
+		return true;
+	}
 
-		//remove jumped peg.
-		peg middle;
-		_find_middle_peg(fromPeg, toPeg, middle);
-		remove_peg(middle);
+	bool board::seek(int ply) {
+		if (ply < 0 || ply > get_last_ply()) return false;
 
-		_history.add_move(fromPeg, toPeg, middle);
+		_ensure_checkpoints();
 
+		//restore the closest checkpoint, when it is closer than stepping
+		int checkpoint = ply / HISTORY_CHECKPOINT_INTERVAL;
+		int checkpointPly = checkpoint * HISTORY_CHECKPOINT_INTERVAL;
+		if (checkpoint < (int)_checkpoints.size() && ply - checkpointPly < abs(ply - get_ply())) {
+			_restore(_checkpoints[checkpoint]);
+			_history.go_to(checkpointPly);
+		}
+
+		while (get_ply() > ply) go_back();
+		while (get_ply() < ply) go_forward();
 		return true;
 	}
 
-	bool board::move_peg(int fromPegNumber, int toPegNumber) {
-		peg f, t;
-		get_peg(fromPegNumber, f);
-		get_peg(toPegNumber, t);
-		return move_peg(f, t);
+	int board::get_ply() const {
+		return (int)_history.get_index();
 	}
 
-	t_open_moves board::get_all_moves() {
-		auto m = t_open_moves();
-		int pegNum = 1;
-		int last = peg::FindLastPegNumber(_height);
+	int board::get_last_ply() const {
+		return (int)_history.total_size() - 1;
+	}
 
-		for (int i = 1; i <= last; i++) {
-			peg p;
-			if (!get_peg(i, p))
-				continue;
+	bool board::move_peg(const peg& fromPeg, const peg& toPeg) {
+		return move_peg(fromPeg.get_number(), toPeg.get_number());
+	}
 
-			if (!p.is_removed())
-				continue;
+	bool board::move_peg(int fromPegNumber, int toPegNumber) {
+		t_board_jump_id id;
+		if (!find_jump(fromPegNumber, toPegNumber, id) || !can_make(id)) return false;
 
-			auto moves = get_moves(p);
-			if (moves.empty())
-				continue;
+		make(id);
 
-			m[p.get_number()] = moves;
-		}
+		const auto& j = _jumps->jumps[id];
+		_history.add_move(_pegs[j.from.row][j.from.index], _pegs[j.to.row][j.to.index], _pegs[j.over.row][j.over.index]);
+		_record_checkpoint();
 
-		return m;
+		return true;
 	}
 
-	t_moves board::get_moves(const peg& toPegNumber) {
-		auto moves = t_moves();
+	const t_board_jumps& board::get_jumps() const noexcept {
+		return _jumps->jumps;
+	}
 
-		int index = toPegNumber.get_index();
-		int row = toPegNumber.get_row();
-
-		//check above:
-		int aboveRow = row - 2;
-		if (aboveRow >= 0) {
-
-			if (toPegNumber.at_begin()) {
-				_add_move(_pegs[aboveRow][0], toPegNumber, moves);
-			} else if (toPegNumber.at_end()) {
-				_add_move( _pegs[aboveRow][aboveRow], toPegNumber, moves);
-			} else {
-				if (index - 2 >= 0)
-					_add_move(_pegs[aboveRow][index - 2], toPegNumber, moves);
-				if (index <= aboveRow) 
-					_add_move(_pegs[aboveRow][index], toPegNumber, moves);
-				if (index + 2 <= aboveRow)
-					_add_move(_pegs[aboveRow][index + 2], toPegNumber, moves);
+	bool board::find_jump(int fromPegNumber, int toPegNumber, t_board_jump_id& id) const {
+		if (fromPegNumber < 1 || fromPegNumber > _total_pegs) return false;
+
+		//a peg has at most six jumps, listed together
+		for (t_board_jump_id i = _jumps->first[fromPegNumber - 1]; i < _jumps->first[fromPegNumber]; i++) {
+			const auto& to = _jumps->jumps[i].to;
+			if (_pegs[to.row][to.index].get_number() == toPegNumber) {
+				id = i;
+				return true;
 			}
+		}
+		return false;
+	}
 
+	void board::get_legal_jumps(std::vector<t_board_jump_id>& ids) const {
+		ids.clear();
+		for (t_board_jump_id i = 0; i < (t_board_jump_id)_jumps->jumps.size(); i++) {
+			if (can_make(i)) ids.push_back(i);
 		}
+	}
 
-		//check current row:
-		if (index - 2 >= 0)
-			_add_move(_pegs[row][index - 2], toPegNumber, moves);
-
-		if (index + 2 <= row)
-			_add_move(_pegs[row][index + 2], toPegNumber, moves);
-
-		//check below:
-		int belowRow = row + 2;
-		if (belowRow < _height) {
-
-			if (toPegNumber.at_begin()) {
-				_add_move(_pegs[belowRow][0], toPegNumber, moves);
-				_add_move(_pegs[belowRow][2], toPegNumber, moves);
-			} else if (toPegNumber.at_end()) {
-				_add_move(_pegs[belowRow][belowRow - 2], toPegNumber, moves);
-				_add_move(_pegs[belowRow][belowRow], toPegNumber, moves);
-			} else {
-				_add_move(_pegs[belowRow][index], toPegNumber, moves);
-				if (index + 2 < belowRow)
-					_add_move(_pegs[belowRow][index + 2], toPegNumber, moves);
-			}
+	t_open_moves board::get_all_moves() {
+		TRIANGLE_TRACE("board::get_all_moves");
+		auto m = t_open_moves();
+		auto ids = std::vector<t_board_jump_id>();
+		get_legal_jumps(ids);
+
+		//the jumps are ordered by the peg that jumps, so each hole's list comes out in peg number order
+		for (auto id : ids) {
+			const auto& j = _jumps->jumps[id];
+			m[_pegs[j.to.row][j.to.index].get_number()].push_back(_pegs[j.from.row][j.from.index].get_number());
+		}
+		return m;
+	}
 
+	t_moves board::get_moves(const peg& toPegNumber) {
+		auto moves = t_moves();
+		int row = toPegNumber.get_row(), index = toPegNumber.get_index();
+
+		for (t_board_jump_id i = 0; i < (t_board_jump_id)_jumps->jumps.size(); i++) {
+			const auto& j = _jumps->jumps[i];
+			if (j.to.row == row && j.to.index == index && can_make(i))
+				moves.push_back(_pegs[j.from.row][j.from.index].get_number());
 		}
-		
 		return moves;
 	}
 
@@ -221,9 +226,44 @@ namespace TriangleGame {
 		return _history;
 	}
 
+	bitboard board::get_bitboard() const {
+		//a topology's rows can be longer than the triangle's, only the triangle fits a bitboard
+		if (!_triangle) return bitboard(0);
+
+		auto b = bitboard(_height);
+		for (const auto& row : _pegs) {
+			for (const auto& p : row) {
+				if (!p.is_removed())
+					b.set(p.get_row(), p.get_index());
+			}
+		}
+		return b;
+	}
+
 	std::string board::to_string() const noexcept {
+		TRIANGLE_TRACE("board::to_string");
 		if (_pegs.empty()) return "";
 		std::stringstream ss;
+
+		//other boards draw each peg where its topology puts it
+		if (!_triangle) {
+			int width = (int)std::to_string(_total_pegs).size();
+			const auto& holes = _jumps->holes;
+			int columns = 0;
+			for (const auto& h : holes) columns = std::max(columns, h.x + 1);
+
+			auto lines = std::vector<std::string>(_height, std::string((columns + 1) * width, ' '));
+			for (int n = 1; n <= _total_pegs; n++) {
+				const auto& place = _jumps->places[n - 1];
+				std::stringstream cell;
+				cell << std::right << std::setw(width) << _pegs[place.row][place.index];
+				lines[holes[n - 1].y].replace(holes[n - 1].x * width, width, cell.str());
+			}
+
+			for (const auto& line : lines)
+				ss << line << std::endl << std::endl;
+			return ss.str();
+		}
 	
 		for (int row = 0; row < _height; row++) {
 
@@ -250,56 +290,142 @@ namespace TriangleGame {
 	//--------------------------------------------------
 
 	const void board::_init_pegs() {
-		for (int row = 0; row < _height; row++) {
-			auto row_p = std::vector<peg>();
+		//a row's pegs are numbered in the order of their index
+		_pegs = t_board(_height);
+		for (int n = 1; n <= _total_pegs; n++) {
+			const auto& place = _jumps->places[n - 1];
+			_pegs[place.row].push_back(peg(n, place.row, place.index));
+		}
+	}
 
-			int e_pos = peg::FindLastPegNumber(row + 1);
-			int s_pos = e_pos - row;
+	bool board::_validate(int row, int index) {
+		if (row < 0 || row >= _height) return false;
+		if (index < 0 || index >= (int)_pegs[row].size()) return false;
 
-			for (int i = s_pos; i <=  e_pos; i++) 
-				row_p.push_back(peg(i, row, (row) - (e_pos - i)) );
+		return true;
+	}
 
-			_pegs.push_back(row_p);
+	void board::_apply(const move& m) {
+		t_board_jump_id id;
+		if (m.is_inital_move())
+			remove_peg(m.get_removed());
+		else if (find_jump(m.get_from().get_number(), m.get_to().get_number(), id))
+			make(id);
+	}
 
-		}
+	void board::_unapply(const move& m) {
+		t_board_jump_id id;
+		if (m.is_inital_move())
+			add_peg(m.get_removed());
+		else if (find_jump(m.get_from().get_number(), m.get_to().get_number(), id))
+			unmake(id);
+	}
 
+	void board::_record_checkpoint() {
+		int ply = get_ply();
+		std::size_t keep = (ply + HISTORY_CHECKPOINT_INTERVAL - 1) / HISTORY_CHECKPOINT_INTERVAL;
+		if (_checkpoints.size() > keep)
+			_checkpoints.resize(keep);
+
+		if (ply % HISTORY_CHECKPOINT_INTERVAL == 0 && _checkpoints.size() == keep)
+			_checkpoints.push_back(_occupancy());
 	}
 
-	const void board::_add_move(const peg& fromPeg, const peg& toPeg, t_moves& moves) {
-		if (!validate_move(fromPeg, toPeg))
-			return;
+	void board::_ensure_checkpoints() {
+		std::size_t needed = (_history.total_size() + HISTORY_CHECKPOINT_INTERVAL - 1) / HISTORY_CHECKPOINT_INTERVAL;
+		if (_checkpoints.size() >= needed) return;
+
+		int ply = get_ply();
+		move m;
+
+		//walk back to the inital move, then forward through every move
+		while (get_ply() > 0 && _history.try_get_move(_history.get_index(), m)) {
+			_unapply(m);
+			_history.go_back();
+		}
+
+		_checkpoints.clear();
+		if (get_ply() == 0)
+			_checkpoints.push_back(_occupancy());
 
-		moves.push_back(fromPeg.get_number());
+		while (go_forward()) {
+			if (get_ply() % HISTORY_CHECKPOINT_INTERVAL == 0)
+				_checkpoints.push_back(_occupancy());
+		}
+
+		while (get_ply() > ply) go_back();
 	}
 
-	bool board::_validate(int row, int index) {
-		if (row < 0 || row >= _height) return false;
-		if (index < 0 || index >= (row+1)) return false;
+	board::t_occupancy board::_occupancy() const {
+		auto b = t_occupancy((_total_pegs + 63) / 64, 0);
+		for (const auto& row : _pegs) {
+			for (const auto& p : row) {
+				int bit = p.get_number() - 1;
+				if (!p.is_removed())
+					b[bit / 64] |= std::uint64_t(1) << (bit % 64);
+			}
+		}
+		return b;
+	}
+
+	void board::_restore(const t_occupancy& b) {
+		int removed = 0;
+		for (auto& row : _pegs) {
+			for (auto& p : row) {
+				int bit = p.get_number() - 1;
+				if ((b[bit / 64] >> (bit % 64)) & 1) {
+					p.replace();
+				} else {
+					p.remove();
+					removed++;
+				}
+			}
+		}
+		_total_pegs_removed = removed;
+	}
 
+	bool board::_locate(int pegNumber, int& row, int& index) const {
+		if (pegNumber < 1 || pegNumber > _total_pegs) return false;
+		const auto& place = _jumps->places[pegNumber - 1];
+		row = place.row;
+		index = place.index;
 		return true;
 	}
 
-	void board::_find_middle_peg(const peg& fromPeg, const peg& toPeg, peg& middlePeg) {
-		if (fromPeg.get_row() == toPeg.get_row()) { //same row
-			int idx = fromPeg > toPeg
-				? fromPeg.get_index()
-				: toPeg.get_index();
+	std::shared_ptr<const board::jump_set> board::_jumps_of(int height) {
+		static std::mutex lock;
+		static std::map<int, std::shared_ptr<const jump_set>> cache;
 
-			middlePeg = _pegs[fromPeg.get_row()][idx - 1];
-			return;
-		}
+		std::lock_guard<std::mutex> guard(lock);
+		auto& found = cache[height];
+		if (found) return found;
+
+		//the triangle's geometry lives in its topology, whose holes are numbered in the same order as the pegs
+		found = _jumps_of(topology::triangle(height));
+		return found;
+	}
+
+	std::shared_ptr<const board::jump_set> board::_jumps_of(const topology& geometry) {
+		auto set = std::make_shared<jump_set>();
+		set->holes = geometry.get_holes();
+
+		auto rowLength = std::vector<int>(geometry.get_rows(), 0);
+		for (const auto& h : set->holes)
+			set->places.push_back({ h.y, rowLength[h.y]++ });
+
+		//a board file can list its jumps in any order, they are grouped by the peg that jumps
+		auto triples = geometry.get_jumps();
+		std::stable_sort(triples.begin(), triples.end(), [](const jump_triple& a, const jump_triple& b) { return a.from < b.from; });
 
-		if (fromPeg.get_index() == toPeg.get_index()) {
-			int row = fromPeg > toPeg
-				? fromPeg.get_row()
-				: toPeg.get_row();
-			middlePeg = _pegs[row - 1][fromPeg.get_index()];
-			return;
+		for (const auto& j : triples) {
+			while ((int)set->first.size() <= j.from)
+				set->first.push_back((t_board_jump_id)set->jumps.size());
+			set->jumps.push_back({ set->places[j.from], set->places[j.over], set->places[j.to] });
 		}
+		while ((int)set->first.size() <= geometry.get_hole_count())
+			set->first.push_back((t_board_jump_id)set->jumps.size());
 
-		middlePeg = fromPeg > toPeg
-			? _pegs[fromPeg.get_row() - 1][fromPeg.get_index() - 1]
-			: _pegs[toPeg.get_row() - 1][toPeg.get_index() - 1];
+		return set;
 	}
 
 
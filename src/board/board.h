@@ -19,20 +19,43 @@
 #include <string>
 #include <iomanip>
 #include <map>
+#include <memory>
 
 #include "../include/abstract/printable.h"
 
 #include "peg.h"
 #include "move_history.h"
+#include "bitboard.h"
+#include "move_generator.h"
+#include "topology.h"
 
 #define EMPTY_PEG -1 //!< The number representation of an empty peg
+#define HISTORY_CHECKPOINT_INTERVAL 16 //!< The number of moves between saved board states, the most moves seek replays
 
 
 namespace TriangleGame {
 
-	typedef std::vector<int> t_moves; //!< A list of moves a peg can make
-	typedef std::map<int, t_moves> t_open_moves; //!< A map of peg numbers to a list of moves that peg can make
 	typedef std::vector<std::vector<peg> > t_board; //!< A 2D vector of pegs, representing the game board
+	typedef int t_board_jump_id; //!< The index of a jump in board::get_jumps
+
+	/**
+	 * @brief A hole of the board, by row and index.
+	 */
+	struct board_hole {
+		int row; //!< The row of the hole.
+		int index; //!< The index of the hole in its row.
+	};
+
+	/**
+	 * @brief A jump the board's shape allows, whether or not it can be made now.
+	 */
+	struct board_jump {
+		board_hole from; //!< The peg that jumps.
+		board_hole over; //!< The peg jumped over, which is removed.
+		board_hole to; //!< The hole it lands in.
+	};
+
+	typedef std::vector<board_jump> t_board_jumps; //!< Every jump of a board, ordered by the peg that jumps.
 
 	/**
 	 * @brief The Board Class, represents the game board.
@@ -46,6 +69,11 @@ namespace TriangleGame {
 	 * A Peg can only jump over another peg if the peg being jumped over is not removed.
 	 * The game is over when there are no remaning moves left.
 	 * 
+	 * A board can also be made from any topology, such as the English cross or a board file.
+	 * Its rows are the rows the holes are drawn on, and its pegs are numbered in the order of
+	 * the topology's holes. Every move is made from the topology's jump triples, the triangle
+	 * is only special in how it is drawn, and in being the only board that can be saved.
+	 * 
 	 */
 	class board : public abstract::printable {
 		public:
@@ -56,6 +84,22 @@ namespace TriangleGame {
 			 */
 			board(int height);
 
+			/**
+			 * @brief Construct a new board object with the holes and jumps of the given topology.
+			 * 
+			 * @param geometry The holes and jumps of the board.
+			 */
+			board(const topology& geometry);
+
+			/**
+			 * @brief Determinds if the board is the triangle, made by board(int height).
+			 * Only the triangle can be drawn as a bitboard, saved, or recorded.
+			 * 
+			 * @return true If the board is the triangle.
+			 * @return false If the board was made from a topology.
+			 */
+			bool is_triangle() const noexcept;
+
 			/**
 			 * @brief Returns the Total Pegs the board has.
 			 * The total number of pegs depends on the board height.
@@ -72,7 +116,7 @@ namespace TriangleGame {
 			int get_total_removed_pegs();
 
 			/**
-			 * @brief Returns the height of the board.
+			 * @brief Returns the height of the board, for a board made from a topology the number of rows it is drawn on.
 			 * 
 			 * @return int The height of the board.
 			 */
@@ -211,6 +255,40 @@ namespace TriangleGame {
 
 			bool go_back();
 
+			/**
+			 * @brief Re-applies the last undone move.
+			 * 
+			 * @return true If a move was re-applied.
+			 * @return false If there are no undone moves.
+			 * @see go_back()
+			 */
+			bool go_forward();
+
+			/**
+			 * @brief Moves the board to the given move in its history, forwards or backwards.
+			 * The board state is saved every HISTORY_CHECKPOINT_INTERVAL moves, so seeking
+			 * restores the closest saved state and replays at most that many moves.
+			 * 
+			 * @param ply The index of the move in the history, in the range [0, get_last_ply()].
+			 * @return true If the board is now at the given move.
+			 * @return false If the move is not in the history.
+			 */
+			bool seek(int ply);
+
+			/**
+			 * @brief Returns the index of the last applied move, -1 when there are no moves.
+			 * 
+			 * @return int The current move index.
+			 */
+			int get_ply() const;
+
+			/**
+			 * @brief Returns the index of the last move in the history, including undone moves.
+			 * 
+			 * @return int The last move index, -1 when there are no moves.
+			 */
+			int get_last_ply() const;
+
 			/**
 			 * @brief Moves the given fromPeg to the toPeg.
 			 * The move is first validated, if the move is valid then
@@ -243,18 +321,90 @@ namespace TriangleGame {
 			 */
 			bool move_peg(int fromPegNumber, int toPegNumber);
 
+			/**
+			 * @brief Returns every jump the board's shape allows, ordered by the peg that jumps.
+			 * The list is shared by every board of the same height.
+			 * 
+			 * @return const t_board_jumps& The jumps, indexed by t_board_jump_id.
+			 */
+			const t_board_jumps& get_jumps() const noexcept;
+
+			/**
+			 * @brief Finds the jump between two peg numbers, whether or not it can be made now.
+			 * 
+			 * @param fromPegNumber The peg number that jumps.
+			 * @param toPegNumber The peg number it lands in.
+			 * @param id The returned jump.
+			 * @return true If the board's shape has the jump.
+			 * @return false If either peg number is not on the board, or they are not two holes apart in a line.
+			 */
+			bool find_jump(int fromPegNumber, int toPegNumber, t_board_jump_id& id) const;
+
+			/**
+			 * @brief Determinds if a jump can be made now, the peg that jumps and the one jumped
+			 * over are on the board, and the hole it lands in is empty.
+			 * 
+			 * @param id The jump.
+			 * @return true If the jump can be made.
+			 * @return false Otherwise.
+			 */
+			bool can_make(t_board_jump_id id) const noexcept {
+				const auto& j = _jumps->jumps[id];
+				return !_pegs[j.from.row][j.from.index]._removed
+					&& !_pegs[j.over.row][j.over.index]._removed
+					&& _pegs[j.to.row][j.to.index]._removed;
+			}
+
+			/**
+			 * @brief Lists the jumps that can be made now.
+			 * 
+			 * @param ids The returned jumps, in the order of get_jumps.
+			 */
+			void get_legal_jumps(std::vector<t_board_jump_id>& ids) const;
+
+			/**
+			 * @brief Makes a jump, for searches that have already checked it with can_make.
+			 * The jump is not validated, and not recorded in the history, so it is undone
+			 * with unmake, not go_back.
+			 * 
+			 * @param id The jump, which must be legal.
+			 * @see unmake(t_board_jump_id id)
+			 */
+			void make(t_board_jump_id id) noexcept {
+				const auto& j = _jumps->jumps[id];
+				_pegs[j.from.row][j.from.index]._removed = true;
+				_pegs[j.over.row][j.over.index]._removed = true;
+				_pegs[j.to.row][j.to.index]._removed = false;
+				_total_pegs_removed++;
+			}
+
+			/**
+			 * @brief Undoes a jump made with make, which must be the last one made.
+			 * 
+			 * @param id The jump.
+			 * @see make(t_board_jump_id id)
+			 */
+			void unmake(t_board_jump_id id) noexcept {
+				const auto& j = _jumps->jumps[id];
+				_pegs[j.from.row][j.from.index]._removed = false;
+				_pegs[j.over.row][j.over.index]._removed = false;
+				_pegs[j.to.row][j.to.index]._removed = true;
+				_total_pegs_removed--;
+			}
+
 			/**
 			 * @brief Returns all the legal, avaliable moves left on the board.
+			 * The moves are the jumps of get_legal_jumps, grouped by the hole they land in.
 			 * 
 			 * @return t_open_moves The avaliable moves left on the board.
 			 * @see t_open_moves
-			 * @see get_moves(const peg& toPeg)
+			 * @see get_legal_jumps(std::vector<t_board_jump_id>& ids)
 			 */
 			t_open_moves get_all_moves();
 
 			/**
 			 * @brief Returns all the legal, avaliable moves left on the board for
-			 * the given peg number.
+			 * the given peg number, the jumps landing in it that can_make allows.
 			 * 
 			 * @param toPegNumber The peg number to get the avaliable moves for.
 			 * @return t_moves The avaliable moves left on the board for the given peg number.
@@ -265,6 +415,14 @@ namespace TriangleGame {
 
 			move_history get_move_history() const;
 
+			/**
+			 * @brief Creates a bitboard of the pegs currently on the board, which must be the triangle.
+			 * 
+			 * @return bitboard The occupancy of the board.
+			 * @see move_generator
+			 */
+			bitboard get_bitboard() const;
+
 			/**
 			 * @brief Creates a string representation of the board.
 			 * 
@@ -273,34 +431,67 @@ namespace TriangleGame {
 			std::string to_string() const noexcept;
 
 		private:
+			friend class snapshot;
+
 			int _height; //!< The height of the board.
 			int _total_pegs; //!< The total number of pegs on the board.
 			t_board _pegs; //!< The board of pegs.
 			int _total_pegs_removed; //!< The total number of pegs removed from the board.
 
+			typedef std::vector<std::uint64_t> t_occupancy; //!< A bit for each peg number, set when the peg is on the board.
+
+			/**
+			 * @brief The holes and jumps of a board's shape, shared by every board of the same shape.
+			 */
+			struct jump_set {
+				t_board_jumps jumps; //!< Every jump, ordered by the peg that jumps.
+				std::vector<t_board_jump_id> first; //!< The first jump of each peg number, and the end of the last.
+				std::vector<board_hole> places; //!< The row and index of each peg number, less one.
+				t_holes holes; //!< Where each peg number, less one, is drawn.
+			};
+
+			bool _triangle; //!< True when the board is the triangle.
+			std::shared_ptr<const jump_set> _jumps; //!< The jumps of the board's shape.
 			move_history _history; //!< The history of moves made on the board.
+			std::vector<t_occupancy> _checkpoints; //!< The board state after every HISTORY_CHECKPOINT_INTERVAL-th move.
 
 			/**
-			 * @brief Initializes the board with the given height.
-			 * Calculates the total number of pegs on the board, and
-			 * initializes the board with the pegs.
+			 * @brief Initializes the pegs of the board, one for each hole of its shape.
 			 */
 			const void _init_pegs();
-			
+
 			/**
-			 * @brief Determinds if the move is valid, 
-			 * if so, the move is added to the moves vector.
+			 * @brief Returns the jumps of a triangle of the given height, creating them the first time.
 			 * 
-			 * @param fromPeg The peg to move from.
-			 * @param toPeg The peg to move to.
-			 * @param moves The vector of moves to add the move to.
+			 * @param height The height of the board.
+			 * @return std::shared_ptr<const jump_set> The jumps.
 			 */
-			const void _add_move(const peg& fromPeg, const peg& toPeg, t_moves& moves);
+			static std::shared_ptr<const jump_set> _jumps_of(int height);
 
+			/**
+			 * @brief Creates the holes and jumps of a board from its topology.
+			 * A hole's row is the row it is drawn on, and its index is the holes numbered before it on that row.
+			 * 
+			 * @param geometry The holes and jumps of the board.
+			 * @return std::shared_ptr<const jump_set> The jumps.
+			 */
+			static std::shared_ptr<const jump_set> _jumps_of(const topology& geometry);
+
+			/**
+			 * @brief Finds the row and index of a peg number.
+			 * 
+			 * @param pegNumber The peg number.
+			 * @param row The returned row.
+			 * @param index The returned index.
+			 * @return true If the peg number is on the board.
+			 * @return false Otherwise.
+			 */
+			bool _locate(int pegNumber, int& row, int& index) const;
+			
 			/**
 			 * @brief Validates that the given row and index are valid.
 			 * A row is valid when it is greater than or equal to 0 and less than the height.
-			 * A index is valid when it is greater than or equal to 0 and less than or equal to the row.
+			 * A index is valid when it is greater than or equal to 0 and less than the length of the row.
 			 * 
 			 * @param row The row to validate.
 			 * @param index The index to validate.
@@ -310,13 +501,44 @@ namespace TriangleGame {
 			bool _validate(int row, int index);
 
 			/**
-			 * @brief Locates the peg that is in the middle of the given fromPeg and toPeg.
+			 * @brief Applies the given move to the pegs, without validating it or recording it.
+			 * 
+			 * @param m The move to apply.
+			 */
+			void _apply(const move& m);
+
+			/**
+			 * @brief Reverses the given move on the pegs, without validating it or recording it.
+			 * 
+			 * @param m The move to reverse.
+			 */
+			void _unapply(const move& m);
+
+			/**
+			 * @brief Saves the board state, if the move just added to the history is a checkpoint.
+			 * Checkpoints of any undone moves the new move replaced are dropped.
+			 */
+			void _record_checkpoint();
+
+			/**
+			 * @brief Returns the pegs on the board, by peg number.
+			 * 
+			 * @return t_occupancy The board state.
+			 */
+			t_occupancy _occupancy() const;
+
+			/**
+			 * @brief Makes sure every checkpoint of the history has been saved.
+			 * Games restored from a snapshot have no checkpoints, they are built on the first seek.
+			 */
+			void _ensure_checkpoints();
+
+			/**
+			 * @brief Sets the pegs to the given board state.
 			 * 
-			 * @param fromPeg The peg to move from.
-			 * @param toPeg The peg to move to.
-			 * @param middle The return peg that is in the middle of the fromPeg and toPeg.
+			 * @param b The board state to restore.
 			 */
-			void _find_middle_peg(const peg& fromPeg, const peg& toPeg, peg& middle);
+			void _restore(const t_occupancy& b);
 	};
 
 }
@@ -0,0 +1,335 @@
+#include "game_record.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+
+namespace TriangleGame {
+
+	namespace {
+
+		const char RECORD_MAGIC[4] = { 'T', 'G', 'R', 'A' };
+		const std::size_t RECORD_BUFFER_BYTES = 1 << 16; //!< The size of the read and write buffers.
+		const int RECORD_MAX_DIGITS = 10; //!< The most digits of a number in a text record, enough for any peg number.
+		const std::size_t RECORD_PIECE_BYTES = 3 * RECORD_MAX_DIGITS + 3; //!< The most bytes of a record's start, or of one of its jumps.
+
+		std::uint64_t peg_count(std::uint64_t height) {
+			return height * (height + 1) / 2;
+		}
+
+		bool read_decimal(const char*& p, const char* end, std::uint64_t& v) {
+			const char* first = p;
+			v = 0;
+			while (p != end && (unsigned)(*p - '0') < 10)
+				v = v * 10 + (std::uint64_t)(*p++ - '0');
+
+			//longer numbers can overflow, but are never peg numbers
+			return p != first && p - first <= RECORD_MAX_DIGITS;
+		}
+
+	}
+
+	//--------------------------------------------------
+	// Game Record
+	//--------------------------------------------------
+
+	game_record::game_record()
+		: _height(0), _start(0)
+	{
+
+	}
+
+	game_record::game_record(int height, int start)
+		: _height(height), _start(start)
+	{
+
+	}
+
+	game_record::game_record(int height, const move_history& history)
+		: _height(height), _start(0)
+	{
+		move m;
+		for (std::size_t i = 0; i < history.size(); i++) {
+			if (!history.try_get_move((t_history_index)i, m)) break;
+
+			if (m.is_inital_move())
+				_start = m.get_removed().get_number();
+			else
+				add_jump(m.get_from().get_number(), m.get_to().get_number());
+		}
+	}
+
+	int game_record::get_height() const noexcept {
+		return _height;
+	}
+
+	int game_record::get_start() const noexcept {
+		return _start;
+	}
+
+	const std::vector<record_jump>& game_record::get_jumps() const noexcept {
+		return _jumps;
+	}
+
+	void game_record::add_jump(int from, int to) {
+		_jumps.push_back({ (std::uint32_t)from, (std::uint32_t)to });
+	}
+
+	void game_record::reset(int height, int start) {
+		_height = height;
+		_start = start;
+		_jumps.clear();
+	}
+
+	bool game_record::replay(board& b) const {
+		if (_height < 1 || (std::uint64_t)_height > RECORD_MAX_HEIGHT) return false;
+
+		auto replayed = board(_height);
+		if (!replayed.remove_inital_peg(_start)) return false;
+		for (const auto& j : _jumps) {
+			if (!replayed.move_peg((int)j.from, (int)j.to)) return false;
+		}
+
+		b = replayed;
+		return true;
+	}
+
+	bool game_record::parse(const std::string& text, game_record& r) {
+		std::stringstream in(text);
+		auto reader = record_reader(in);
+		return reader.get_format() == record_format::text && reader.next(r) && !reader.next(r);
+	}
+
+	std::string game_record::to_string() const noexcept {
+		std::stringstream ss;
+		ss << _height << '/' << _start << ':';
+		for (std::size_t i = 0; i < _jumps.size(); i++) {
+			if (i > 0) ss << ',';
+			ss << _jumps[i].from << '-' << _jumps[i].to;
+		}
+		return ss.str();
+	}
+
+	//--------------------------------------------------
+	// Record Writer
+	//--------------------------------------------------
+
+	record_writer::record_writer(std::ostream& out, record_format format, bool header)
+		: _out(out), _format(format), _buffer(RECORD_BUFFER_BYTES), _used(0), _count(0)
+	{
+		if (_format == record_format::binary && header) {
+			std::copy(RECORD_MAGIC, RECORD_MAGIC + sizeof(RECORD_MAGIC), _buffer.data());
+			_buffer[sizeof(RECORD_MAGIC)] = (char)RECORD_VERSION;
+			_used = sizeof(RECORD_MAGIC) + 1;
+		}
+	}
+
+	record_writer::~record_writer() {
+		finish();
+	}
+
+	bool record_writer::write(const game_record& r) {
+		const auto& jumps = r.get_jumps();
+		if (!_make_room()) return false;
+
+		//every piece is at most RECORD_PIECE_BYTES long, so it is written without bounds checks
+		if (_format == record_format::text) {
+			_put_decimal(r.get_height());
+			_buffer[_used++] = '/';
+			_put_decimal(r.get_start());
+			_buffer[_used++] = ':';
+			for (std::size_t i = 0; i < jumps.size(); i++) {
+				if (!_make_room()) return false;
+				if (i > 0) _buffer[_used++] = ',';
+				_put_decimal(jumps[i].from);
+				_buffer[_used++] = '-';
+				_put_decimal(jumps[i].to);
+			}
+			_buffer[_used++] = '\n';
+		} else {
+			_put_varint(r.get_height());
+			_put_varint(r.get_start());
+			_put_varint(jumps.size());
+			for (const auto& j : jumps) {
+				if (!_make_room()) return false;
+				_put_varint(j.from);
+				_put_varint(j.to);
+			}
+		}
+
+		_count++;
+		return true;
+	}
+
+	bool record_writer::finish() {
+		if (_used > 0) {
+			_out.write(_buffer.data(), _used);
+			_used = 0;
+		}
+		return _out.good();
+	}
+
+	std::uint64_t record_writer::get_count() const noexcept {
+		return _count;
+	}
+
+	bool record_writer::_make_room() {
+		if (_used + RECORD_PIECE_BYTES <= _buffer.size()) return true;
+		return finish();
+	}
+
+	void record_writer::_put_decimal(std::uint64_t v) {
+		//most peg numbers are one or two digits
+		if (v < 100) {
+			if (v >= 10) _buffer[_used++] = (char)('0' + v / 10);
+			_buffer[_used++] = (char)('0' + v % 10);
+			return;
+		}
+
+		char* p = _buffer.data() + _used;
+		_used = std::to_chars(p, p + RECORD_MAX_DIGITS, v).ptr - _buffer.data();
+	}
+
+	void record_writer::_put_varint(std::uint64_t v) {
+		char* p = _buffer.data() + _used;
+		while (v >= 0x80) {
+			*p++ = (char)((v & 0x7f) | 0x80);
+			v >>= 7;
+		}
+		*p++ = (char)v;
+		_used = p - _buffer.data();
+	}
+
+	//--------------------------------------------------
+	// Record Reader
+	//--------------------------------------------------
+
+	record_reader::record_reader(std::istream& in)
+		: _in(in), _format(record_format::text), _buffer(RECORD_BUFFER_BYTES), _pos(0), _end(0), _failed(false), _count(0)
+	{
+		//the header is only looked for in the first block, which is always longer
+		_fill();
+		if (_end > sizeof(RECORD_MAGIC) && std::equal(RECORD_MAGIC, RECORD_MAGIC + sizeof(RECORD_MAGIC), _buffer.data())) {
+			_format = record_format::binary;
+			_failed = (unsigned char)_buffer[sizeof(RECORD_MAGIC)] != RECORD_VERSION;
+			_pos = sizeof(RECORD_MAGIC) + 1;
+		}
+	}
+
+	bool record_reader::next(game_record& r) {
+		if (_failed) return false;
+
+		bool read = _format == record_format::text ? _next_text(r) : _next_binary(r);
+		if (read) _count++;
+		return read;
+	}
+
+	bool record_reader::failed() const noexcept {
+		return _failed;
+	}
+
+	record_format record_reader::get_format() const noexcept {
+		return _format;
+	}
+
+	std::uint64_t record_reader::get_count() const noexcept {
+		return _count;
+	}
+
+	bool record_reader::_fill() {
+		std::size_t left = _end - _pos;
+		std::memmove(_buffer.data(), _buffer.data() + _pos, left);
+		_pos = 0;
+		_end = left;
+
+		if (_end == _buffer.size())
+			_buffer.resize(_buffer.size() * 2);
+
+		if (!_in) return false;
+		_in.read(_buffer.data() + _end, _buffer.size() - _end);
+		std::size_t read = (std::size_t)_in.gcount();
+		_end += read;
+		return read > 0;
+	}
+
+	bool record_reader::_next_line(const char*& line, const char*& end) {
+		const char* newline;
+		std::size_t searched = _pos;
+		while ((newline = (const char*)std::memchr(_buffer.data() + searched, '\n', _end - searched)) == nullptr) {
+			searched = _end - _pos;
+			if (!_fill()) {
+				//the last line does not need a line break
+				if (_pos == _end) return false;
+				newline = _buffer.data() + _end;
+				break;
+			}
+		}
+
+		line = _buffer.data() + _pos;
+		end = newline;
+		_pos = std::min(_end, (std::size_t)(newline - _buffer.data()) + 1);
+		if (end != line && end[-1] == '\r') end--;
+		return true;
+	}
+
+	bool record_reader::_next_text(game_record& r) {
+		//skip blank lines, and comments
+		const char* p;
+		const char* end;
+		do {
+			if (!_next_line(p, end)) return false;
+		} while (p == end || *p == '#');
+
+		std::uint64_t height, start, from, to;
+		_failed = true;
+		if (!read_decimal(p, end, height) || p == end || *p++ != '/' || height < 1 || height > RECORD_MAX_HEIGHT) return false;
+		std::uint64_t total = peg_count(height);
+		if (!read_decimal(p, end, start) || p == end || *p++ != ':' || start < 1 || start > total) return false;
+
+		r.reset((int)height, (int)start);
+		while (p != end) {
+			if (!read_decimal(p, end, from) || p == end || *p++ != '-' || from < 1 || from > total) return false;
+			if (!read_decimal(p, end, to) || to < 1 || to > total) return false;
+			r.add_jump((int)from, (int)to);
+
+			if (p != end && (*p++ != ',' || p == end)) return false;
+		}
+
+		_failed = false;
+		return true;
+	}
+
+	bool record_reader::_next_binary(game_record& r) {
+		std::uint64_t height, start, count, from, to;
+		if (_pos == _end && !_fill()) return false;
+
+		_failed = true;
+		if (!_read_varint(height) || height < 1 || height > RECORD_MAX_HEIGHT) return false;
+		std::uint64_t total = peg_count(height);
+		if (!_read_varint(start) || start < 1 || start > total) return false;
+		if (!_read_varint(count) || count >= total) return false;
+
+		r.reset((int)height, (int)start);
+		for (std::uint64_t i = 0; i < count; i++) {
+			if (!_read_varint(from) || from < 1 || from > total) return false;
+			if (!_read_varint(to) || to < 1 || to > total) return false;
+			r.add_jump((int)from, (int)to);
+		}
+
+		_failed = false;
+		return true;
+	}
+
+	bool record_reader::_read_varint_slow(std::uint64_t& v) {
+		v = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			int c = _get();
+			if (c == -1) return false;
+			v |= (std::uint64_t)(c & 0x7f) << shift;
+			if ((c & 0x80) == 0) return true;
+		}
+		return false;
+	}
+
+}
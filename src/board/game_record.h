@@ -0,0 +1,349 @@
+/**
+ * @file game_record.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the game_record class, a game in a compact notation, and the streaming readers and writers of game archives.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_GAME_RECORD__
+#define __H_TRIANGLE_GAME_RECORD__
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "move_history.h"
+#include "../include/abstract/printable.h"
+
+namespace TriangleGame {
+
+	const std::uint8_t RECORD_VERSION = 1; //!< The current version of the binary archive format.
+	const std::uint64_t RECORD_MAX_HEIGHT = 65535; //!< The tallest board a record can be of, its peg numbers fit in 32 bits.
+
+	/**
+	 * @brief A single jump of a record, by peg numbers.
+	 */
+	struct record_jump {
+		std::uint32_t from; //!< The peg that jumped.
+		std::uint32_t to; //!< The hole it landed in.
+	};
+
+	/**
+	 * @brief The formats a game archive can be written in.
+	 */
+	enum class record_format {
+		text,	//!< One game per line, "height/start:from-to,from-to,...".
+		binary	//!< The magic bytes "TGRA" and the version, then each game as varints.
+	};
+
+	/**
+	 * @brief The Game Record Class, a game as its height, the peg removed first, and its jumps.
+	 *
+	 * The text notation of a game is its height and first removed peg, then its jumps:
+	 * "5/1:4-1,6-4" is a game on a board of height 5, that started by removing peg 1,
+	 * then jumped peg 4 to 1, and peg 6 to 4. The jumped peg is always between the two,
+	 * so it is not written.
+	 */
+	class game_record : public abstract::printable {
+		public:
+			/**
+			 * @brief Construct a new, empty, record.
+			 */
+			game_record();
+
+			/**
+			 * @brief Construct a new record with no jumps.
+			 *
+			 * @param height The height of the board.
+			 * @param start The peg removed first.
+			 */
+			game_record(int height, int start);
+
+			/**
+			 * @brief Construct a new record of the applied moves of a history, undone moves are not recorded.
+			 *
+			 * @param height The height of the board.
+			 * @param history The moves of the game.
+			 */
+			game_record(int height, const move_history& history);
+
+			/**
+			 * @brief Returns the height of the board.
+			 *
+			 * @return int The height.
+			 */
+			int get_height() const noexcept;
+
+			/**
+			 * @brief Returns the peg removed first.
+			 *
+			 * @return int The peg number, 0 when the game has not started.
+			 */
+			int get_start() const noexcept;
+
+			/**
+			 * @brief Returns the jumps, in the order they were made.
+			 *
+			 * @return const std::vector<record_jump>& The jumps.
+			 */
+			const std::vector<record_jump>& get_jumps() const noexcept;
+
+			/**
+			 * @brief Adds a jump to the end of the game.
+			 *
+			 * @param from The peg that jumped.
+			 * @param to The hole it landed in.
+			 */
+			void add_jump(int from, int to);
+
+			/**
+			 * @brief Makes the record an empty game, keeping the memory of its jumps.
+			 *
+			 * @param height The height of the board.
+			 * @param start The peg removed first.
+			 */
+			void reset(int height, int start);
+
+			/**
+			 * @brief Plays the game on a new board, checking that every jump is valid.
+			 *
+			 * @param b The returned board, only changed when every jump is valid.
+			 * @return true If the game was replayed.
+			 * @return false If the start or a jump is not valid.
+			 */
+			bool replay(board& b) const;
+
+			/**
+			 * @brief Reads a record from its text notation.
+			 *
+			 * @param text The notation, "height/start:from-to,...".
+			 * @param r The returned record.
+			 * @return true If the notation was read.
+			 * @return false If it is not a record.
+			 */
+			static bool parse(const std::string& text, game_record& r);
+
+			/**
+			 * @brief Creates the text notation of the game.
+			 *
+			 * @return std::string The notation, "height/start:from-to,...".
+			 */
+			std::string to_string() const noexcept;
+
+		private:
+			int _height; //!< The height of the board.
+			int _start; //!< The peg removed first.
+			std::vector<record_jump> _jumps; //!< The jumps, in the order they were made.
+	};
+
+	/**
+	 * @brief The Record Writer Class, streams game records to an archive.
+	 *
+	 * Records are formatted straight into a buffer, which is written out whenever it
+	 * fills, so an archive of any size is written with a fixed amount of memory.
+	 */
+	class record_writer {
+		public:
+			/**
+			 * @brief Construct a new writer.
+			 *
+			 * @param out The stream to write to, which should be opened in binary mode.
+			 * @param format The format of the archive.
+			 * @param header False when appending to a binary archive that already has its header.
+			 */
+			record_writer(std::ostream& out, record_format format, bool header = true);
+
+			/**
+			 * @brief Destroy the writer, writing out anything still buffered.
+			 */
+			~record_writer();
+
+			/**
+			 * @brief Adds a game to the archive.
+			 *
+			 * @param r The game.
+			 * @return true If the game was added.
+			 * @return false If the stream failed.
+			 */
+			bool write(const game_record& r);
+
+			/**
+			 * @brief Writes out anything still buffered.
+			 *
+			 * @return true If every game was written.
+			 * @return false If the stream failed.
+			 */
+			bool finish();
+
+			/**
+			 * @brief Returns the number of games written.
+			 *
+			 * @return std::uint64_t The number of games.
+			 */
+			std::uint64_t get_count() const noexcept;
+
+		private:
+			std::ostream& _out; //!< The stream written to.
+			record_format _format; //!< The format of the archive.
+			std::vector<char> _buffer; //!< The bytes not yet written.
+			std::size_t _used; //!< The number of bytes in the buffer.
+			std::uint64_t _count; //!< The number of games written.
+
+			/**
+			 * @brief Writes out the buffer, if there is no room for another piece of a record.
+			 *
+			 * @return true If there is room.
+			 * @return false If the stream failed.
+			 */
+			bool _make_room();
+
+			/**
+			 * @brief Appends a number to the buffer, in decimal.
+			 */
+			void _put_decimal(std::uint64_t v);
+
+			/**
+			 * @brief Appends a number to the buffer, as a varint.
+			 */
+			void _put_varint(std::uint64_t v);
+	};
+
+	/**
+	 * @brief The Record Reader Class, streams game records from an archive.
+	 *
+	 * The format is found from the start of the archive. The archive is read in blocks,
+	 * and each record is parsed straight from the block, a whole line at a time for text.
+	 * The record read into keeps the memory of its jumps, so reading allocates nothing
+	 * once the first few games are read.
+	 * Records are checked to be well formed, with peg numbers on their board, but the
+	 * jumps are not checked to be valid, use game_record::replay for that.
+	 */
+	class record_reader {
+		public:
+			/**
+			 * @brief Construct a new reader.
+			 *
+			 * @param in The stream to read from, which should be opened in binary mode.
+			 */
+			record_reader(std::istream& in);
+
+			/**
+			 * @brief Reads the next game.
+			 *
+			 * @param r The returned game.
+			 * @return true If a game was read.
+			 * @return false At the end of the archive, or when a record is not valid.
+			 */
+			bool next(game_record& r);
+
+			/**
+			 * @brief Determinds if reading stopped at a record that is not valid.
+			 *
+			 * @return true If a record was not valid.
+			 * @return false Otherwise.
+			 */
+			bool failed() const noexcept;
+
+			/**
+			 * @brief Returns the format of the archive.
+			 *
+			 * @return record_format The format.
+			 */
+			record_format get_format() const noexcept;
+
+			/**
+			 * @brief Returns the number of games read.
+			 *
+			 * @return std::uint64_t The number of games.
+			 */
+			std::uint64_t get_count() const noexcept;
+
+		private:
+			std::istream& _in; //!< The stream read from.
+			record_format _format; //!< The format of the archive.
+			std::vector<char> _buffer; //!< The unread bytes.
+			std::size_t _pos; //!< The next byte of the buffer.
+			std::size_t _end; //!< The number of bytes in the buffer.
+			bool _failed; //!< True once a record was not valid.
+			std::uint64_t _count; //!< The number of games read.
+
+			/**
+			 * @brief Reads the next byte.
+			 *
+			 * @return int The byte, or -1 at the end of the archive.
+			 */
+			int _get() {
+				if (_pos == _end && !_fill()) return -1;
+				return (unsigned char)_buffer[_pos++];
+			}
+
+			/**
+			 * @brief Moves the unread bytes to the front of the buffer, and reads the next block
+			 * of the archive after them, growing the buffer when it is already full.
+			 *
+			 * @return true If any bytes were read.
+			 * @return false At the end of the archive.
+			 */
+			bool _fill();
+
+			/**
+			 * @brief Reads a game in the text format.
+			 */
+			bool _next_text(game_record& r);
+
+			/**
+			 * @brief Reads a game in the binary format.
+			 */
+			bool _next_binary(game_record& r);
+
+			/**
+			 * @brief Finds the next line of a text archive in the buffer, reading more of the archive as needed.
+			 *
+			 * @param line The returned start of the line.
+			 * @param end The returned end of the line, without its line break.
+			 * @return true If a line was found.
+			 * @return false At the end of the archive.
+			 */
+			bool _next_line(const char*& line, const char*& end);
+
+			/**
+			 * @brief Reads a varint.
+			 *
+			 * @param v The returned number.
+			 * @return true If a number was read.
+			 * @return false At the end of the archive, or if the number is too long.
+			 */
+			bool _read_varint(std::uint64_t& v) {
+				//a whole varint is in the buffer, so it is decoded without checking for the end
+				if (_end - _pos < 10) return _read_varint_slow(v);
+
+				const char* p = _buffer.data() + _pos;
+				v = 0;
+				for (int shift = 0; shift < 64; shift += 7) {
+					unsigned char c = (unsigned char)*p++;
+					v |= (std::uint64_t)(c & 0x7f) << shift;
+					if ((c & 0x80) == 0) {
+						_pos = p - _buffer.data();
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/**
+			 * @brief Reads a varint a byte at a time, near the end of the buffer.
+			 */
+			bool _read_varint_slow(std::uint64_t& v);
+	};
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+#include "latency_histogram.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace TriangleGame {
+
+	latency_histogram::latency_histogram() {
+		clear();
+	}
+
+	void latency_histogram::merge(const latency_histogram& other) noexcept {
+		for (std::size_t b = 0; b < LATENCY_BUCKETS; b++)
+			_buckets[b] += other._buckets[b];
+		_count += other._count;
+		_total += other._total;
+		if (other._max > _max) _max = other._max;
+		if (other._min < _min) _min = other._min;
+	}
+
+	void latency_histogram::clear() noexcept {
+		_buckets.fill(0);
+		_count = 0;
+		_total = 0;
+		_min = UINT64_MAX;
+		_max = 0;
+	}
+
+	std::uint64_t latency_histogram::get_count() const noexcept {
+		return _count;
+	}
+
+	std::uint64_t latency_histogram::get_min() const noexcept {
+		return _count == 0 ? 0 : _min;
+	}
+
+	std::uint64_t latency_histogram::get_max() const noexcept {
+		return _max;
+	}
+
+	double latency_histogram::get_mean() const noexcept {
+		return _count == 0 ? 0 : (double)_total / _count;
+	}
+
+	std::uint64_t latency_histogram::get_percentile(double percent) const noexcept {
+		if (_count == 0) return 0;
+
+		//the rank of the value, counting from 1, at least the first
+		auto rank = (std::uint64_t)std::ceil(percent / 100.0 * _count);
+		if (rank < 1) rank = 1;
+
+		std::uint64_t seen = 0;
+		for (std::size_t b = 0; b < LATENCY_BUCKETS; b++) {
+			seen += _buckets[b];
+			if (seen >= rank) {
+				std::uint64_t highest = highest_in(b);
+				return highest < _max ? highest : _max;
+			}
+		}
+		return _max;
+	}
+
+	std::uint64_t latency_histogram::highest_in(std::size_t bucket) noexcept {
+		const std::size_t half = (std::size_t)1 << (LATENCY_SUB_BITS - 1);
+		if (bucket < 2 * half) return bucket;
+
+		//above the exact buckets, each power of two is split into half of 64 buckets
+		int shift = (int)(bucket / half) - 1;
+		std::uint64_t top = bucket % half + half + 1;
+		return (top << shift) - 1;
+	}
+
+}
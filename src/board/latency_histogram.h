@@ -0,0 +1,133 @@
+/**
+ * @file latency_histogram.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the latency_histogram class, which counts durations in buckets of a fixed relative precision.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_LATENCY_HISTOGRAM__
+#define __H_TRIANGLE_LATENCY_HISTOGRAM__
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace TriangleGame {
+
+	const int LATENCY_SUB_BITS = 6; //!< The bits of a value kept by its bucket, the buckets are within 1 / 32 of their values.
+	const std::size_t LATENCY_BUCKETS = (64 - LATENCY_SUB_BITS + 2) << (LATENCY_SUB_BITS - 1); //!< The buckets needed for any 64 bit value.
+
+	/**
+	 * @brief The Latency Histogram Class, counts durations in buckets, in the style of an HdrHistogram.
+	 *
+	 * Values below 64 each have their own bucket. Above that, each power of two is split
+	 * into 32 buckets, so a bucket is never wider than 1 / 32 of the values in it, and a
+	 * percentile is always within about 3% of the exact value, from a nanosecond to
+	 * centuries. Recording is a few instructions and the histogram is a fixed size, so it
+	 * can record every turn of a long run, and histograms are merged by adding the buckets.
+	 */
+	class latency_histogram {
+		public:
+			/**
+			 * @brief Construct a new, empty, histogram.
+			 */
+			latency_histogram();
+
+			/**
+			 * @brief Counts a value.
+			 *
+			 * @param value The value, such as a duration in nanoseconds.
+			 */
+			void record(std::uint64_t value) noexcept {
+				_buckets[bucket_of(value)]++;
+				_count++;
+				_total += value;
+				if (value > _max) _max = value;
+				if (value < _min) _min = value;
+			}
+
+			/**
+			 * @brief Adds the counts of another histogram.
+			 *
+			 * @param other The histogram to add.
+			 */
+			void merge(const latency_histogram& other) noexcept;
+
+			/**
+			 * @brief Empties the histogram.
+			 */
+			void clear() noexcept;
+
+			/**
+			 * @brief Returns the number of values counted.
+			 *
+			 * @return std::uint64_t The number of values.
+			 */
+			std::uint64_t get_count() const noexcept;
+
+			/**
+			 * @brief Returns the smallest value counted.
+			 *
+			 * @return std::uint64_t The smallest value, 0 when empty.
+			 */
+			std::uint64_t get_min() const noexcept;
+
+			/**
+			 * @brief Returns the largest value counted, exactly.
+			 *
+			 * @return std::uint64_t The largest value, 0 when empty.
+			 */
+			std::uint64_t get_max() const noexcept;
+
+			/**
+			 * @brief Returns the mean of the values counted.
+			 *
+			 * @return double The mean, 0 when empty.
+			 */
+			double get_mean() const noexcept;
+
+			/**
+			 * @brief Returns the value that the given percent of the values are at or below.
+			 * The value is the top of its bucket, so it is never below the exact percentile.
+			 *
+			 * @param percent The percentile, from 0 to 100.
+			 * @return std::uint64_t The value, 0 when empty.
+			 */
+			std::uint64_t get_percentile(double percent) const noexcept;
+
+			/**
+			 * @brief Returns the bucket a value is counted in.
+			 *
+			 * @param value The value.
+			 * @return std::size_t The index of the bucket.
+			 */
+			static std::size_t bucket_of(std::uint64_t value) noexcept {
+				int shift = std::bit_width(value) - LATENCY_SUB_BITS;
+				if (shift <= 0) return (std::size_t)value;
+				return ((std::size_t)shift << (LATENCY_SUB_BITS - 1)) + (std::size_t)(value >> shift);
+			}
+
+			/**
+			 * @brief Returns the largest value counted in a bucket.
+			 *
+			 * @param bucket The index of the bucket.
+			 * @return std::uint64_t The largest value.
+			 */
+			static std::uint64_t highest_in(std::size_t bucket) noexcept;
+
+		private:
+			std::array<std::uint64_t, LATENCY_BUCKETS> _buckets; //!< The number of values counted in each bucket.
+			std::uint64_t _count; //!< The number of values counted.
+			std::uint64_t _total; //!< The sum of the values counted.
+			std::uint64_t _min; //!< The smallest value counted.
+			std::uint64_t _max; //!< The largest value counted.
+	};
+
+}
+
+#endif
@@ -0,0 +1,250 @@
+#include "move_generator.h"
+#include "trace.h"
+
+#include <bit>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TRIANGLE_GAME_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace TriangleGame {
+
+	namespace {
+
+		typedef void (*t_mask_kernel)(const t_word*, const t_word*, t_word*, std::size_t, std::ptrdiff_t);
+
+		//--------------------------------------------------
+		// Scalar Kernel
+		//--------------------------------------------------
+
+		/**
+		 * @brief Reads word k of the occupancy, shifted towards the higher bits by s (or lower when negative).
+		 */
+		inline t_word shifted_word(const t_word* w, std::ptrdiff_t k, std::ptrdiff_t s) {
+			if (s >= 0) {
+				std::ptrdiff_t q = s >> 6;
+				int b = s & 63;
+				t_word lo = w[k - q];
+				return b ? (lo << b) | (w[k - q - 1] >> (64 - b)) : lo;
+			}
+
+			s = -s;
+			std::ptrdiff_t q = s >> 6;
+			int b = s & 63;
+			t_word lo = w[k + q];
+			return b ? (lo >> b) | (w[k + q + 1] << (64 - b)) : lo;
+		}
+
+		void mask_scalar(const t_word* occ, const t_word* valid, t_word* out, std::size_t n, std::ptrdiff_t s) {
+			for (std::size_t k = 0; k < n; k++) {
+				out[k] = valid[k] & ~occ[k]
+					& shifted_word(occ, k, s)
+					& shifted_word(occ, k, 2 * s);
+			}
+		}
+
+#ifdef TRIANGLE_GAME_X86_SIMD
+		//--------------------------------------------------
+		// AVX2 Kernel
+		//--------------------------------------------------
+
+		__attribute__((target("avx2")))
+		inline __m256i shifted_avx2(const t_word* w, std::ptrdiff_t k, std::ptrdiff_t s) {
+			//shifting a 64 bit lane by 64 yields zero, so b == 0 needs no special case.
+			if (s >= 0) {
+				std::ptrdiff_t q = s >> 6;
+				__m128i b = _mm_cvtsi64_si128(s & 63);
+				__m128i rb = _mm_cvtsi64_si128(64 - (s & 63));
+				__m256i lo = _mm256_loadu_si256((const __m256i*)(w + k - q));
+				__m256i hi = _mm256_loadu_si256((const __m256i*)(w + k - q - 1));
+				return _mm256_or_si256(_mm256_sll_epi64(lo, b), _mm256_srl_epi64(hi, rb));
+			}
+
+			s = -s;
+			std::ptrdiff_t q = s >> 6;
+			__m128i b = _mm_cvtsi64_si128(s & 63);
+			__m128i rb = _mm_cvtsi64_si128(64 - (s & 63));
+			__m256i lo = _mm256_loadu_si256((const __m256i*)(w + k + q));
+			__m256i hi = _mm256_loadu_si256((const __m256i*)(w + k + q + 1));
+			return _mm256_or_si256(_mm256_srl_epi64(lo, b), _mm256_sll_epi64(hi, rb));
+		}
+
+		__attribute__((target("avx2")))
+		void mask_avx2(const t_word* occ, const t_word* valid, t_word* out, std::size_t n, std::ptrdiff_t s) {
+			std::size_t k = 0;
+			for (; k + 4 <= n; k += 4) {
+				__m256i o = _mm256_loadu_si256((const __m256i*)(occ + k));
+				__m256i v = _mm256_loadu_si256((const __m256i*)(valid + k));
+				__m256i m = _mm256_andnot_si256(o, v);
+				m = _mm256_and_si256(m, shifted_avx2(occ, k, s));
+				m = _mm256_and_si256(m, shifted_avx2(occ, k, 2 * s));
+				_mm256_storeu_si256((__m256i*)(out + k), m);
+			}
+
+			for (; k < n; k++) {
+				out[k] = valid[k] & ~occ[k]
+					& shifted_word(occ, k, s)
+					& shifted_word(occ, k, 2 * s);
+			}
+		}
+
+		//--------------------------------------------------
+		// AVX-512 Kernel
+		//--------------------------------------------------
+
+		//the zero masked forms, with every lane set, are the same instructions, without the
+		//unmasked forms' undefined source vector that -Wmaybe-uninitialized warns about
+		const __mmask8 AVX512_ALL = 0xFF;
+
+		__attribute__((target("avx512f")))
+		inline __m512i shifted_avx512(const t_word* w, std::ptrdiff_t k, std::ptrdiff_t s) {
+			if (s >= 0) {
+				std::ptrdiff_t q = s >> 6;
+				__m128i b = _mm_cvtsi64_si128(s & 63);
+				__m128i rb = _mm_cvtsi64_si128(64 - (s & 63));
+				__m512i lo = _mm512_loadu_si512((const void*)(w + k - q));
+				__m512i hi = _mm512_loadu_si512((const void*)(w + k - q - 1));
+				return _mm512_or_si512(_mm512_maskz_sll_epi64(AVX512_ALL, lo, b), _mm512_maskz_srl_epi64(AVX512_ALL, hi, rb));
+			}
+
+			s = -s;
+			std::ptrdiff_t q = s >> 6;
+			__m128i b = _mm_cvtsi64_si128(s & 63);
+			__m128i rb = _mm_cvtsi64_si128(64 - (s & 63));
+			__m512i lo = _mm512_loadu_si512((const void*)(w + k + q));
+			__m512i hi = _mm512_loadu_si512((const void*)(w + k + q + 1));
+			return _mm512_or_si512(_mm512_maskz_srl_epi64(AVX512_ALL, lo, b), _mm512_maskz_sll_epi64(AVX512_ALL, hi, rb));
+		}
+
+		__attribute__((target("avx512f")))
+		void mask_avx512(const t_word* occ, const t_word* valid, t_word* out, std::size_t n, std::ptrdiff_t s) {
+			std::size_t k = 0;
+			for (; k + 8 <= n; k += 8) {
+				__m512i o = _mm512_loadu_si512((const void*)(occ + k));
+				__m512i v = _mm512_loadu_si512((const void*)(valid + k));
+				__m512i m = _mm512_maskz_andnot_epi64(AVX512_ALL, o, v);
+				m = _mm512_and_si512(m, shifted_avx512(occ, k, s));
+				m = _mm512_and_si512(m, shifted_avx512(occ, k, 2 * s));
+				_mm512_storeu_si512((void*)(out + k), m);
+			}
+
+			for (; k < n; k++) {
+				out[k] = valid[k] & ~occ[k]
+					& shifted_word(occ, k, s)
+					& shifted_word(occ, k, 2 * s);
+			}
+		}
+#endif
+
+		t_mask_kernel get_kernel(simd_level level) {
+#ifdef TRIANGLE_GAME_X86_SIMD
+			if (level == simd_level::avx512) return mask_avx512;
+			if (level == simd_level::avx2) return mask_avx2;
+#endif
+			return mask_scalar;
+		}
+
+	}
+
+	move_generator::move_generator()
+		: _level(detect_level())
+	{
+
+	}
+
+	move_generator::move_generator(simd_level level)
+		: _level(is_supported(level) ? level : detect_level())
+	{
+
+	}
+
+	simd_level move_generator::get_level() const noexcept {
+		return _level;
+	}
+
+	void move_generator::get_jump_masks(const bitboard& b, t_jump_masks& masks) const {
+		auto kernel = get_kernel(_level);
+		std::size_t n = b.word_count();
+
+		for (int d = 0; d < JUMP_DIRECTIONS; d++) {
+			masks[d].resize(n);
+			kernel(b.data(), b.valid(), masks[d].data(), n, get_direction_shift(b, d));
+		}
+	}
+
+	t_open_moves move_generator::get_all_moves(const bitboard& b) const {
+		TRIANGLE_TRACE("move_generator::get_all_moves");
+		auto m = t_open_moves();
+
+		t_jump_masks masks;
+		get_jump_masks(b, masks);
+
+		std::ptrdiff_t shifts[JUMP_DIRECTIONS];
+		for (int d = 0; d < JUMP_DIRECTIONS; d++)
+			shifts[d] = get_direction_shift(b, d);
+
+		for (std::size_t k = 0; k < b.word_count(); k++) {
+			t_word any = 0;
+			for (int d = 0; d < JUMP_DIRECTIONS; d++)
+				any |= masks[d][k];
+
+			while (any) {
+				int bit = std::countr_zero(any);
+				any &= any - 1;
+
+				std::ptrdiff_t to = (std::ptrdiff_t)(k * 64 + bit);
+
+				//directions are ordered by the jumping peg's position,
+				//so the list comes out sorted, as get_moves does.
+				auto moves = t_moves();
+				for (int d = 0; d < JUMP_DIRECTIONS; d++) {
+					if ((masks[d][k] >> bit) & 1)
+						moves.push_back(b.peg_number_of(to - 2 * shifts[d]));
+				}
+
+				m.emplace_hint(m.end(), b.peg_number_of(to), std::move(moves));
+			}
+		}
+
+		return m;
+	}
+
+	std::ptrdiff_t move_generator::get_direction_shift(const bitboard& b, int direction) {
+		std::ptrdiff_t w = b.get_stride();
+		switch (direction) {
+			case 0:  return w + 1;		// from above, to the left
+			case 1:  return w;			// from directly above
+			case 2:  return 1;			// from the left, same row
+			case 3:  return -1;			// from the right, same row
+			case 4:  return -w;			// from directly below
+			default: return -(w + 1);	// from below, to the right
+		}
+	}
+
+	simd_level move_generator::detect_level() {
+		if (is_supported(simd_level::avx512)) return simd_level::avx512;
+		if (is_supported(simd_level::avx2)) return simd_level::avx2;
+		return simd_level::scalar;
+	}
+
+	bool move_generator::is_supported(simd_level level) {
+		switch (level) {
+#ifdef TRIANGLE_GAME_X86_SIMD
+			case simd_level::avx512: return __builtin_cpu_supports("avx512f");
+			case simd_level::avx2:   return __builtin_cpu_supports("avx2");
+#endif
+			case simd_level::scalar: return true;
+			default: return false;
+		}
+	}
+
+	const char* move_generator::level_name(simd_level level) {
+		switch (level) {
+			case simd_level::avx512: return "avx512";
+			case simd_level::avx2:   return "avx2";
+			default:                 return "scalar";
+		}
+	}
+
+}
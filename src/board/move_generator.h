@@ -0,0 +1,130 @@
+/**
+ * @file move_generator.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the move_generator class, a bit-parallel generator of legal jumps.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_MOVE_GENERATOR__
+#define __H_TRIANGLE_MOVE_GENERATOR__
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "bitboard.h"
+
+namespace TriangleGame {
+
+	typedef std::vector<int> t_moves; //!< A list of moves a peg can make
+	typedef std::map<int, t_moves> t_open_moves; //!< A map of peg numbers to a list of moves that peg can make
+
+	const int JUMP_DIRECTIONS = 6; //!< The number of directions a peg can jump in.
+	typedef std::array<t_words, JUMP_DIRECTIONS> t_jump_masks; //!< One target hole mask per jump direction.
+
+	/**
+	 * @brief The instruction sets the move generator can use.
+	 */
+	enum class simd_level {
+		scalar,	//!< Portable 64 bit words.
+		avx2,	//!< 256 bit AVX2 lanes.
+		avx512	//!< 512 bit AVX-512F lanes.
+	};
+
+	/**
+	 * @brief The Move Generator Class, finds every legal jump on a bitboard at once.
+	 *
+	 * For each of the six jump directions the generator computes, over the whole board,
+	 * the mask of empty holes that have a peg next to them and another peg behind that one:
+	 * (to & ~occupied) & (occupied shifted once) & (occupied shifted twice).
+	 * The shifts and ANDs are run on as many words at a time as the CPU allows,
+	 * the instruction set is selected at runtime.
+	 *
+	 * The results are identical to board::get_all_moves.
+	 */
+	class move_generator {
+		public:
+			/**
+			 * @brief Construct a new move generator, using the best instruction set the CPU supports.
+			 */
+			move_generator();
+
+			/**
+			 * @brief Construct a new move generator, using the given instruction set.
+			 * If the CPU does not support the instruction set, the best supported one is used instead.
+			 *
+			 * @param level The instruction set to use.
+			 */
+			move_generator(simd_level level);
+
+			/**
+			 * @brief Returns the instruction set being used.
+			 *
+			 * @return simd_level The instruction set being used.
+			 */
+			simd_level get_level() const noexcept;
+
+			/**
+			 * @brief Calculates the target hole masks, one per jump direction.
+			 * The directions are ordered by where the jumping peg comes from,
+			 * see get_direction_shift.
+			 *
+			 * @param b The board to find the jumps on.
+			 * @param masks The returned masks, each the size of b.word_count().
+			 */
+			void get_jump_masks(const bitboard& b, t_jump_masks& masks) const;
+
+			/**
+			 * @brief Returns all the legal, avaliable moves left on the board.
+			 *
+			 * @param b The board to find the moves on.
+			 * @return t_open_moves The avaliable moves, in the same format as board::get_all_moves.
+			 */
+			t_open_moves get_all_moves(const bitboard& b) const;
+
+			/**
+			 * @brief Returns the bit shift from the middle peg to the target hole, for the given direction.
+			 * The jumping peg is at (target - 2 * shift).
+			 *
+			 * @param b The board the direction is on.
+			 * @param direction The direction, in the range [0, JUMP_DIRECTIONS).
+			 * @return std::ptrdiff_t The bit shift of the direction.
+			 */
+			static std::ptrdiff_t get_direction_shift(const bitboard& b, int direction);
+
+			/**
+			 * @brief Detects the best instruction set supported by the CPU.
+			 *
+			 * @return simd_level The best supported instruction set.
+			 */
+			static simd_level detect_level();
+
+			/**
+			 * @brief Determinds if the CPU supports the given instruction set.
+			 *
+			 * @param level The instruction set to check.
+			 * @return true If the instruction set is supported.
+			 * @return false Otherwise.
+			 */
+			static bool is_supported(simd_level level);
+
+			/**
+			 * @brief Returns the name of the given instruction set.
+			 *
+			 * @param level The instruction set.
+			 * @return const char* The name of the instruction set.
+			 */
+			static const char* level_name(simd_level level);
+
+		private:
+			simd_level _level; //!< The instruction set being used.
+	};
+
+}
+
+#endif
@@ -9,6 +9,8 @@ namespace TriangleGame {
 	}
 
 	t_history_index move_history::add_move(const move& m) {
+		//a new move replaces any undone moves
+		_history.erase(_history.lower_bound(_index + 1), _history.end());
 		_history[++_index] = m;
 		return _index;
 	}
@@ -23,10 +25,24 @@ namespace TriangleGame {
 
 	t_history_index move_history::go_back() {
 		if (_index == -1) return _index;
-		_history.erase(_index--);
+		return --_index;
+	}
+
+	t_history_index move_history::go_forward() {
+		if (can_go_forward()) _index++;
+		return _index;
+	}
+
+	t_history_index move_history::go_to(t_history_index index) {
+		if (index == -1 || index < _history.size())
+			_index = index;
 		return _index;
 	}
 
+	bool move_history::can_go_forward() const noexcept {
+		return _index + 1 < _history.size();
+	}
+
 	t_history_index move_history::get_index() const {
 		return _index;
 	}
@@ -41,13 +57,20 @@ namespace TriangleGame {
 	}
 
 	std::size_t move_history::size() const noexcept {
+		return _index + 1;
+	}
+
+	std::size_t move_history::total_size() const noexcept {
 		return _history.size();
 	}
 
 	std::string move_history::to_string() const noexcept {
 		std::stringstream ss;
 		for (auto& kv : _history) {
-			ss << kv.first << ".\t" << kv.second.to_string() << std::endl;
+			ss << kv.first << ".\t";
+			if (kv.first >= size())
+				ss << "(Undone) ";
+			ss << kv.second.to_string() << std::endl;
 		}
 		return ss.str();
 	}
@@ -24,15 +24,53 @@ namespace TriangleGame {
 
 			t_history_index go_back();
 
+			/**
+			 * @brief Re-applies the next undone move, if there is one.
+			 * 
+			 * @return t_history_index The index of the current move.
+			 */
+			t_history_index go_forward();
+
+			/**
+			 * @brief Moves the current move to the given index, which must be 
+			 * in the range [-1, total_size()), without changing the stored moves.
+			 * 
+			 * @param index The index of the new current move.
+			 * @return t_history_index The index of the current move.
+			 */
+			t_history_index go_to(t_history_index index);
+
+			/**
+			 * @brief Determinds if there are undone moves that can be re-applied.
+			 * 
+			 * @return true If go_forward would re-apply a move.
+			 * @return false Otherwise.
+			 */
+			bool can_go_forward() const noexcept;
+
 			t_history_index get_index() const;
 
 			bool try_get_move(t_history_index index, move& m) const;
 
+			/**
+			 * @brief Returns the number of moves currently applied, not including undone moves.
+			 * 
+			 * @return std::size_t The number of applied moves.
+			 */
 			std::size_t size() const noexcept;
 
+			/**
+			 * @brief Returns the number of moves stored, including undone moves that can be re-applied.
+			 * 
+			 * @return std::size_t The number of stored moves.
+			 */
+			std::size_t total_size() const noexcept;
+
 			std::string to_string() const noexcept;
 
 		private:
+			friend class snapshot;
+
 			t_history_index _index;
 			t_history_container _history;
 
@@ -33,9 +33,6 @@ namespace TriangleGame {
 		_index = p._index;
 		_number = p._number;
 		_removed = p._removed;
-		_atBegin = p._atBegin;
-		_atMiddle = p._atMiddle;
-		_atEnd = p._atEnd;
 	}
 
 	bool peg::is_empty() const {
@@ -54,18 +51,6 @@ namespace TriangleGame {
 		return _index;
 	}
 
-	bool peg::at_begin() const {
-		return _atBegin;
-	}
-
-	bool peg::at_end() const {
-		return _atEnd;
-	}
-
-	bool peg::at_middle() const {
-		return _atMiddle;
-	}
-
 	const bool peg::remove() {
 		if (_removed) return false;
 		_removed = true;
@@ -127,15 +112,21 @@ namespace TriangleGame {
 	}
 
 	void peg::LocatePeg(int pegNumber, int& row, int& index, int maxHeight) {
-		int last = 0;
-		for (int i = 0; i < maxHeight; i++) {
-			last = FindLastPegNumber(i+1);
-			if (pegNumber <= last) {
-				row = i;
-				break;
-			}
+		if (pegNumber < 1) {
+			row = 0;
+			index = pegNumber - 1;
+			return;
 		}
-		index = pegNumber - (last - row + 1) + 1;
+
+		//row r holds the peg numbers (r(r+1)/2, (r+1)(r+2)/2]
+		row = (int)((std::sqrt(8.0 * pegNumber - 7.0) - 1.0) / 2.0);
+
+		//correct any floating point rounding
+		while (row > 0 && FindLastPegNumber(row) >= pegNumber) row--;
+		while (FindLastPegNumber(row + 1) < pegNumber) row++;
+
+		if (row >= maxHeight) row = maxHeight - 1;
+		index = pegNumber - FindLastPegNumber(row) - 1;
 	}
 
 	//--------------------------------------------------
@@ -144,10 +135,6 @@ namespace TriangleGame {
 
 	void peg::_init_peg() {
 		_removed = false;
-		_atEnd = _index == _row;
-		_atBegin = _index == 0;
-		int middle_idx = floor((_row + 1) / 2.0);
-		_atMiddle = _index == middle_idx && _row % 2 == 0;
 	}
 
 }
\ No newline at end of file
@@ -97,33 +97,6 @@ namespace TriangleGame {
 			 */
 			int get_index() const;
 
-			/**
-			 * @brief Determinds if the peg is currently located
-			 * at the beginning of the row.
-			 * 
-			 * @return true True if the peg is at the beginning of the row.
-			 * @return false False otherwise.
-			 */
-			bool at_begin() const;
-
-			/**
-			 * @brief Determinds if the peg is currently located
-			 * at the end of the row.
-			 * 
-			 * @return true True if the peg is at the end of the row.
-			 * @return false False otherwise.
-			 */
-			bool at_end() const;
-
-			/**
-			 * @brief Determinds if the peg is currently located
-			 * in the middle of row.
-			 * 
-			 * @return true True if the peg is in the middle of the row.
-			 * @return false False otherwise.
-			 */
-			bool at_middle() const;
-
 			/**
 			 * @brief Removes the peg from the board.
 			 * The peg can be removed from the board if it is not already.
@@ -224,6 +197,9 @@ namespace TriangleGame {
 
 			/**
 			 * @brief Calculates the row and index for a given peg number.
+			 * The row is found in constant time, from the inverse of FindLastPegNumber.
+			 * Peg numbers past the last row of maxHeight are placed on the last row, 
+			 * with an index past the end of that row.
 			 * 
 			 * @param pegNumber The peg number to locate the row and index for.
 			 * @param row A reference to the row to be set.
@@ -233,17 +209,15 @@ namespace TriangleGame {
 			static void LocatePeg(int pegNumber, int& row, int& index, int maxHeight = 5);
 
 		private:
+			friend class board;
+
 			int _row; //!< The row of the peg.
 			int _index; //!< The index of the peg.
 			int _number; //!< The peg number.
-			bool _atEnd; //!< Flag determinds if the peg is at the end of the row.
-			bool _atBegin; //!< Flag determinds if the peg is at the beginning of the row.
-			bool _atMiddle; //!< Flag determinds if the peg is in the middle of the row.
 			bool _removed; //!< Flag determinds if the peg has been removed.
 
 			/**
-			 * @brief Initializes the peg.
-			 * Setups the flags for the peg.
+			 * @brief Initializes the peg, which starts on the board.
 			 */
 			void _init_peg();
 	};
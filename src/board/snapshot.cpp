@@ -0,0 +1,165 @@
+#include "snapshot.h"
+
+#include <fstream>
+#include <vector>
+
+namespace TriangleGame {
+
+	namespace {
+
+		const char SNAPSHOT_MAGIC[4] = { 'T', 'G', 'S', 'V' };
+		const std::uint64_t SNAPSHOT_MIN_MOVE_BYTES = 2; //!< The size of the smallest move, the inital move's 0 and removed peg.
+
+		void write_varint(std::ostream& out, std::uint64_t v) {
+			char buf[10];
+			int n = 0;
+			while (v >= 0x80) {
+				buf[n++] = (char)((v & 0x7f) | 0x80);
+				v >>= 7;
+			}
+			buf[n++] = (char)v;
+			out.write(buf, n);
+		}
+
+		bool read_varint(std::istream& in, std::uint64_t& v) {
+			v = 0;
+			for (int shift = 0; shift < 64; shift += 7) {
+				int c = in.get();
+				if (c == EOF) return false;
+				v |= (std::uint64_t)(c & 0x7f) << shift;
+				if ((c & 0x80) == 0) return true;
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Determinds if a stream has at least the given bytes left, streams that cannot seek are assumed to.
+		 */
+		bool has_bytes(std::istream& in, std::uint64_t bytes) {
+			auto here = in.tellg();
+			if (here == std::istream::pos_type(-1)) return true;
+
+			in.seekg(0, std::ios::end);
+			auto end = in.tellg();
+			in.seekg(here);
+			return end != std::istream::pos_type(-1) && (std::uint64_t)(end - here) >= bytes;
+		}
+
+		bool read_peg_number(std::istream& in, int total, int& pegNumber) {
+			std::uint64_t v;
+			if (!read_varint(in, v) || v < 1 || v > (std::uint64_t)total) return false;
+			pegNumber = (int)v;
+			return true;
+		}
+
+	}
+
+	bool snapshot::save(const board& b, std::ostream& out) {
+		if (!b._triangle || b._height > SNAPSHOT_MAX_HEIGHT) return false;
+
+		out.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+		out.put((char)SNAPSHOT_VERSION);
+
+		write_varint(out, b._height);
+		write_varint(out, b._total_pegs_removed);
+		write_varint(out, b._history.size());
+
+		//occupancy, peg number order
+		auto bits = std::vector<char>((b._total_pegs + 7) / 8, 0);
+		for (const auto& row : b._pegs) {
+			for (const auto& p : row) {
+				int bit = p.get_number() - 1;
+				if (!p.is_removed())
+					bits[bit / 8] |= (char)(1 << (bit % 8));
+			}
+		}
+		out.write(bits.data(), bits.size());
+
+		//only the applied moves are saved, not any undone moves
+		for (const auto& kv : b._history._history) {
+			if (kv.first >= b._history.size()) break;
+			const move& m = kv.second;
+			if (m.is_inital_move()) {
+				write_varint(out, 0);
+			} else {
+				write_varint(out, m.get_from().get_number());
+				write_varint(out, m.get_to().get_number());
+			}
+			write_varint(out, m.get_removed().get_number());
+		}
+
+		return out.good();
+	}
+
+	bool snapshot::load(std::istream& in, board& b) {
+		char magic[sizeof(SNAPSHOT_MAGIC)];
+		if (!in.read(magic, sizeof(magic))) return false;
+		if (!std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC)) return false;
+		if (in.get() != SNAPSHOT_VERSION) return false;
+
+		std::uint64_t height, removed, moves;
+		if (!read_varint(in, height) || height < 1 || height > (std::uint64_t)SNAPSHOT_MAX_HEIGHT) return false;
+
+		//the whole header is checked before the board is made
+		int total = (int)(height * (height + 1) / 2);
+		if (!read_varint(in, removed) || removed > (std::uint64_t)total) return false;
+		if (!read_varint(in, moves) || moves > (std::uint64_t)total) return false;
+
+		auto bits = std::vector<char>((total + 7) / 8);
+		if (!has_bytes(in, bits.size() + moves * SNAPSHOT_MIN_MOVE_BYTES)) return false;
+		if (!in.read(bits.data(), bits.size())) return false;
+
+		auto restored = board((int)height);
+
+		//the removed count must agree with the holes, or the board's counters would disagree with its pegs
+		std::uint64_t empty = 0;
+		for (auto& row : restored._pegs) {
+			for (auto& p : row) {
+				int bit = p.get_number() - 1;
+				if (((bits[bit / 8] >> (bit % 8)) & 1) == 0) {
+					p.remove();
+					empty++;
+				}
+			}
+		}
+		if (empty != removed) return false;
+		restored._total_pegs_removed = (int)removed;
+
+		auto locate = [&restored](int pegNumber) -> peg {
+			int row, index;
+			peg::LocatePeg(pegNumber, row, index, restored._height);
+			return peg(pegNumber, row, index);
+		};
+
+		for (std::uint64_t i = 0; i < moves; i++) {
+			std::uint64_t from;
+			int to, removedPeg;
+			if (!read_varint(in, from) || from > (std::uint64_t)total) return false;
+
+			if (from == 0) {
+				if (!read_peg_number(in, total, removedPeg)) return false;
+				restored._history.add_move(locate(removedPeg));
+			} else {
+				if (!read_peg_number(in, total, to)) return false;
+				if (!read_peg_number(in, total, removedPeg)) return false;
+				restored._history.add_move(locate((int)from), locate(to), locate(removedPeg));
+			}
+		}
+
+		b = restored;
+		return true;
+	}
+
+	bool snapshot::save_file(const board& b, const std::string& path) {
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out) return false;
+		return save(b, out);
+	}
+
+	bool snapshot::load_file(const std::string& path, board& b) {
+		std::ifstream in(path, std::ios::binary);
+		if (!in) return false;
+		return load(in, b);
+	}
+
+}
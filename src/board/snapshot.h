@@ -0,0 +1,88 @@
+/**
+ * @file snapshot.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the snapshot class, which saves and restores a game in a compact binary form.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SNAPSHOT__
+#define __H_TRIANGLE_SNAPSHOT__
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "board.h"
+
+namespace TriangleGame {
+
+	const std::uint8_t SNAPSHOT_VERSION = 1; //!< The current version of the snapshot format.
+	const int SNAPSHOT_MAX_HEIGHT = 128; //!< The tallest board a snapshot holds, and so the tallest triangle the game is played on, so a damaged height can never cost more than a few thousand pegs.
+
+	/**
+	 * @brief The Snapshot Class, saves and restores a game in a versioned binary form.
+	 *
+	 * A snapshot holds everything needed to carry on a game:
+	 * - the magic bytes "TGSV" and the format version,
+	 * - the height, the number of pegs removed, and the number of moves, as varints,
+	 * - the occupancy bitset, bit (pegNumber - 1) set when the peg is on the board,
+	 * - the move history, each move as three varints: from, to and removed.
+	 *   The inital move has a from of 0, and no to.
+	 *
+	 * Restoring writes the pegs and history straight into the board, the moves are
+	 * not replayed or validated, so a restore costs the size of the snapshot
+	 * no matter how the game got there. The header is checked against the length of
+	 * the stream before the board is made, so a damaged snapshot is turned down
+	 * without allocating the board it claims to hold.
+	 */
+	class snapshot {
+		public:
+			/**
+			 * @brief Writes the given board to the stream.
+			 *
+			 * @param b The board to save.
+			 * @param out The stream to write to, which should be opened in binary mode.
+			 * @return true If the snapshot was written.
+			 * @return false If the stream failed, the board is not the triangle, or it is taller than SNAPSHOT_MAX_HEIGHT.
+			 */
+			static bool save(const board& b, std::ostream& out);
+
+			/**
+			 * @brief Reads a board from the stream.
+			 *
+			 * @param in The stream to read from, which should be opened in binary mode.
+			 * @param b The returned board, only changed when the snapshot is valid.
+			 * @return true If the snapshot was read.
+			 * @return false If the stream failed, or does not hold a supported snapshot.
+			 */
+			static bool load(std::istream& in, board& b);
+
+			/**
+			 * @brief Writes the given board to a file.
+			 *
+			 * @param b The board to save.
+			 * @param path The path of the file.
+			 * @return true If the file was written.
+			 * @return false Otherwise.
+			 */
+			static bool save_file(const board& b, const std::string& path);
+
+			/**
+			 * @brief Reads a board from a file.
+			 *
+			 * @param path The path of the file.
+			 * @param b The returned board.
+			 * @return true If the file was read.
+			 * @return false Otherwise.
+			 */
+			static bool load_file(const std::string& path, board& b);
+	};
+
+}
+
+#endif
@@ -0,0 +1,216 @@
+#include "topology.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace TriangleGame {
+
+	topology::topology()
+		: _name("")
+	{
+
+	}
+
+	topology::topology(const std::string& name, const t_holes& holes, const t_jump_triples& jumps)
+		: _name(name), _holes(holes), _jumps(jumps)
+	{
+
+	}
+
+	const std::string& topology::get_name() const noexcept {
+		return _name;
+	}
+
+	int topology::get_hole_count() const noexcept {
+		return (int)_holes.size();
+	}
+
+	const t_holes& topology::get_holes() const noexcept {
+		return _holes;
+	}
+
+	const t_jump_triples& topology::get_jumps() const noexcept {
+		return _jumps;
+	}
+
+	int topology::get_rows() const noexcept {
+		int rows = 0;
+		for (const auto& h : _holes)
+			rows = std::max(rows, h.y + 1);
+		return rows;
+	}
+
+	int topology::get_columns() const noexcept {
+		int columns = 0;
+		for (const auto& h : _holes)
+			columns = std::max(columns, h.x + 1);
+		return columns;
+	}
+
+	//--------------------------------------------------
+	// Built-in Boards
+	//--------------------------------------------------
+
+	topology topology::triangle(int height) {
+		auto cells = std::vector<std::pair<int, int> >();
+		auto holes = t_holes();
+
+		for (int row = 0; row < height; row++) {
+			for (int index = 0; index <= row; index++) {
+				cells.push_back({ row, index });
+				holes.push_back({ 2 * index + (height - 1 - row), row });
+			}
+		}
+
+		//along a row, down the left edge's direction, and down the right edge's direction
+		return _from_grid("triangle", cells, { { 0, 1 }, { 1, 0 }, { 1, 1 } }, holes);
+	}
+
+	topology topology::english() {
+		auto cells = std::vector<std::pair<int, int> >();
+		auto holes = t_holes();
+
+		for (int row = 0; row < 7; row++) {
+			for (int column = 0; column < 7; column++) {
+				bool corner = (row < 2 || row > 4) && (column < 2 || column > 4);
+				if (corner) continue;
+				cells.push_back({ row, column });
+				holes.push_back({ 2 * column, row });
+			}
+		}
+
+		return _from_grid("english", cells, { { 0, 1 }, { 1, 0 } }, holes);
+	}
+
+	topology topology::european() {
+		auto cells = std::vector<std::pair<int, int> >();
+		auto holes = t_holes();
+
+		for (int row = 0; row < 7; row++) {
+			for (int column = 0; column < 7; column++) {
+				//each corner loses three holes
+				int r = std::min(row, 6 - row);
+				int c = std::min(column, 6 - column);
+				if (r + c < 2) continue;
+				cells.push_back({ row, column });
+				holes.push_back({ 2 * column, row });
+			}
+		}
+
+		return _from_grid("european", cells, { { 0, 1 }, { 1, 0 } }, holes);
+	}
+
+	topology topology::hexagon(int side) {
+		auto cells = std::vector<std::pair<int, int> >();
+		auto holes = t_holes();
+
+		//axial coordinates (row, q), the hexagon is every cell within side - 1 steps of the centre
+		int n = side - 1;
+		for (int row = -n; row <= n; row++) {
+			for (int q = -n; q <= n; q++) {
+				if (std::abs(q + row) > n) continue;
+				cells.push_back({ row, q });
+				holes.push_back({ 2 * q + row + 2 * n, row + n });
+			}
+		}
+
+		return _from_grid("hexagon", cells, { { 0, 1 }, { 1, 0 }, { 1, -1 } }, holes);
+	}
+
+	bool topology::preset(const std::string& name, int size, topology& t) {
+		if (name == "triangle") t = triangle(size);
+		else if (name == "english") t = english();
+		else if (name == "european") t = european();
+		else if (name == "hexagon") t = hexagon(size);
+		else return false;
+		return true;
+	}
+
+	//--------------------------------------------------
+	// Text Descriptions
+	//--------------------------------------------------
+
+	bool topology::load(std::istream& in, topology& t) {
+		auto loaded = topology();
+		loaded._name = "custom";
+
+		std::string line;
+		while (std::getline(in, line)) {
+			auto comment = line.find('#');
+			if (comment != std::string::npos)
+				line.erase(comment);
+
+			std::stringstream ss(line);
+			std::string kind;
+			if (!(ss >> kind)) continue;
+
+			if (kind == "name") {
+				if (!(ss >> loaded._name)) return false;
+			} else if (kind == "hole") {
+				hole_position h;
+				if (!(ss >> h.x >> h.y) || h.x < 0 || h.y < 0) return false;
+				loaded._holes.push_back(h);
+			} else if (kind == "jump") {
+				jump_triple j;
+				if (!(ss >> j.from >> j.over >> j.to)) return false;
+				j.from--; j.over--; j.to--;
+				loaded._jumps.push_back(j);
+			} else {
+				return false;
+			}
+		}
+
+		int n = loaded.get_hole_count();
+		for (const auto& j : loaded._jumps) {
+			for (int hole : { j.from, j.over, j.to }) {
+				if (hole < 0 || hole >= n) return false;
+			}
+			if (j.from == j.over || j.over == j.to || j.from == j.to) return false;
+		}
+
+		t = loaded;
+		return n > 0;
+	}
+
+	bool topology::load_file(const std::string& path, topology& t) {
+		std::ifstream in(path);
+		if (!in) return false;
+		return load(in, t);
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	topology topology::_from_grid(const std::string& name, const std::vector<std::pair<int, int> >& cells,
+		const std::vector<std::pair<int, int> >& steps, const t_holes& holes) {
+
+		auto index = std::map<std::pair<int, int>, int>();
+		for (int i = 0; i < (int)cells.size(); i++)
+			index[cells[i]] = i;
+
+		auto find = [&index](int a, int b) -> int {
+			auto it = index.find({ a, b });
+			return it == index.end() ? -1 : it->second;
+		};
+
+		auto jumps = t_jump_triples();
+		for (int i = 0; i < (int)cells.size(); i++) {
+			for (const auto& step : steps) {
+				for (int sign : { 1, -1 }) {
+					int da = sign * step.first, db = sign * step.second;
+					int over = find(cells[i].first + da, cells[i].second + db);
+					int to = find(cells[i].first + 2 * da, cells[i].second + 2 * db);
+					if (over < 0 || to < 0) continue;
+					jumps.push_back({ i, over, to });
+				}
+			}
+		}
+
+		return topology(name, holes, jumps);
+	}
+
+}
@@ -0,0 +1,196 @@
+/**
+ * @file topology.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the topology class, the geometry of a peg solitaire board described as data.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_TOPOLOGY__
+#define __H_TRIANGLE_TOPOLOGY__
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace TriangleGame {
+
+	/**
+	 * @brief Where a hole is drawn, in character columns and rows.
+	 */
+	struct hole_position {
+		int x; //!< The column of the hole.
+		int y; //!< The row of the hole.
+	};
+
+	/**
+	 * @brief A jump, as the indices of the three holes on its line.
+	 */
+	struct jump_triple {
+		int from; //!< The hole the peg jumps from.
+		int over; //!< The hole of the peg being jumped over.
+		int to; //!< The hole the peg lands in.
+	};
+
+	typedef std::vector<hole_position> t_holes; //!< A list of holes.
+	typedef std::vector<jump_triple> t_jump_triples; //!< A list of jumps.
+
+	/**
+	 * @brief The Topology Class, the geometry of a board: a hole list and a jump triple table.
+	 *
+	 * Holes are numbered from 0 in the order they are listed, and shown to the player
+	 * as one more than that, so the triangle's holes match its peg numbers.
+	 * Nothing else about the geometry is known, the rest of the engine only ever
+	 * looks at the jump triples.
+	 *
+	 * Topologies can be loaded from a text description, one entry per line:
+	 * - "name <name>" names the board,
+	 * - "hole <x> <y>" adds a hole drawn at column x, row y,
+	 * - "jump <from> <over> <to>" adds a jump between holes, numbered from 1.
+	 *   Jumps are one way, so most boards list each line of three holes twice.
+	 * Blank lines, and anything after a "#", are ignored.
+	 */
+	class topology {
+		public:
+			/**
+			 * @brief Construct a new, empty, topology.
+			 */
+			topology();
+
+			/**
+			 * @brief Construct a new topology from a hole list and jump table.
+			 *
+			 * @param name The name of the board.
+			 * @param holes The holes, in numbering order.
+			 * @param jumps The jumps, by hole index.
+			 */
+			topology(const std::string& name, const t_holes& holes, const t_jump_triples& jumps);
+
+			/**
+			 * @brief Returns the name of the board.
+			 *
+			 * @return const std::string& The name of the board.
+			 */
+			const std::string& get_name() const noexcept;
+
+			/**
+			 * @brief Returns the number of holes on the board.
+			 *
+			 * @return int The number of holes.
+			 */
+			int get_hole_count() const noexcept;
+
+			/**
+			 * @brief Returns the holes on the board.
+			 *
+			 * @return const t_holes& The holes.
+			 */
+			const t_holes& get_holes() const noexcept;
+
+			/**
+			 * @brief Returns the jumps on the board.
+			 *
+			 * @return const t_jump_triples& The jumps.
+			 */
+			const t_jump_triples& get_jumps() const noexcept;
+
+			/**
+			 * @brief Returns the number of rows, the largest hole row plus one.
+			 *
+			 * @return int The number of rows.
+			 */
+			int get_rows() const noexcept;
+
+			/**
+			 * @brief Returns the number of columns, the largest hole column plus one.
+			 *
+			 * @return int The number of columns.
+			 */
+			int get_columns() const noexcept;
+
+			/**
+			 * @brief The triangle board, with the given number of rows.
+			 *
+			 * @param height The height of the board.
+			 * @return topology The triangle board.
+			 */
+			static topology triangle(int height);
+
+			/**
+			 * @brief The 33 hole English cross board.
+			 *
+			 * @return topology The English board.
+			 */
+			static topology english();
+
+			/**
+			 * @brief The 37 hole European (French) board.
+			 *
+			 * @return topology The European board.
+			 */
+			static topology european();
+
+			/**
+			 * @brief The hexagonal board, with the given number of holes along each side.
+			 * Pegs can jump along any of the three lines through a hole.
+			 *
+			 * @param side The number of holes along each side.
+			 * @return topology The hexagonal board.
+			 */
+			static topology hexagon(int side);
+
+			/**
+			 * @brief Finds a built-in board by name.
+			 *
+			 * @param name One of "triangle", "english", "european" or "hexagon".
+			 * @param size The height of the triangle, or the side of the hexagon.
+			 * @param t The returned topology.
+			 * @return true If the board exists.
+			 * @return false Otherwise.
+			 */
+			static bool preset(const std::string& name, int size, topology& t);
+
+			/**
+			 * @brief Reads a topology from its text description.
+			 *
+			 * @param in The stream to read.
+			 * @param t The returned topology.
+			 * @return true If the description is valid.
+			 * @return false If a line could not be read, or a jump uses a hole that does not exist.
+			 */
+			static bool load(std::istream& in, topology& t);
+
+			/**
+			 * @brief Reads a topology from a file.
+			 *
+			 * @param path The path of the file.
+			 * @param t The returned topology.
+			 * @return true If the file was read.
+			 * @return false Otherwise.
+			 */
+			static bool load_file(const std::string& path, topology& t);
+
+		private:
+			std::string _name; //!< The name of the board.
+			t_holes _holes; //!< The holes.
+			t_jump_triples _jumps; //!< The jumps.
+
+			/**
+			 * @brief Creates a board from holes on a grid, jumps are every line of three holes along the given steps.
+			 *
+			 * @param name The name of the board.
+			 * @param cells The grid cells of the holes, in numbering order.
+			 * @param steps The grid steps a peg can jump along, each in one direction only.
+			 * @param holes The drawing position of each cell.
+			 * @return topology The board.
+			 */
+			static topology _from_grid(const std::string& name, const std::vector<std::pair<int, int> >& cells,
+				const std::vector<std::pair<int, int> >& steps, const t_holes& holes);
+	};
+
+}
+
+#endif
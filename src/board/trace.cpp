@@ -0,0 +1,118 @@
+#include "trace.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace TriangleGame {
+
+	namespace {
+
+		std::mutex trace_mutex; //!< Guards the list of buffers.
+		std::vector<std::unique_ptr<trace_buffer>> trace_buffers; //!< Every thread's buffer, kept after the thread ends.
+		std::string trace_path; //!< The file the trace is written to.
+		std::size_t trace_capacity = TRACE_DEFAULT_EVENTS; //!< The spans each new buffer keeps.
+		std::chrono::steady_clock::time_point trace_started; //!< When tracing started.
+		thread_local trace_buffer* thread_buffer = nullptr; //!< The calling thread's buffer, made by its first span.
+
+		void write_at_exit() {
+			tracer::write();
+		}
+
+		//timestamps are in microseconds, written with the nanoseconds as decimals
+		void write_micros(std::ostream& out, std::uint64_t ns) {
+			char decimals[4] = { char('0' + ns / 100 % 10), char('0' + ns / 10 % 10), char('0' + ns % 10), 0 };
+			out << ns / 1000 << '.' << decimals;
+		}
+
+	}
+
+	std::atomic<bool> tracer::_enabled(false);
+
+	trace_buffer::trace_buffer(unsigned thread, std::size_t capacity)
+		: _thread(thread), _events(capacity > 0 ? capacity : 1), _added(0)
+	{
+
+	}
+
+	unsigned trace_buffer::get_thread() const noexcept {
+		return _thread;
+	}
+
+	std::vector<trace_event> trace_buffer::get_events() const {
+		auto events = std::vector<trace_event>();
+		std::uint64_t first = _added > _events.size() ? _added - _events.size() : 0;
+		for (std::uint64_t i = first; i < _added; i++)
+			events.push_back(_events[i % _events.size()]);
+		return events;
+	}
+
+	std::uint64_t trace_buffer::get_dropped() const noexcept {
+		return _added > _events.size() ? _added - _events.size() : 0;
+	}
+
+	void tracer::start(const std::string& path, std::size_t events) {
+		std::lock_guard<std::mutex> lock(trace_mutex);
+		if (_enabled.load()) return;
+
+		trace_path = path;
+		trace_capacity = events;
+		trace_started = std::chrono::steady_clock::now();
+		std::atexit(write_at_exit);
+		_enabled.store(true);
+	}
+
+	std::uint64_t tracer::now() noexcept {
+		return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - trace_started).count();
+	}
+
+	void tracer::add(const trace_event& e) {
+		if (thread_buffer == nullptr) {
+			std::lock_guard<std::mutex> lock(trace_mutex);
+			trace_buffers.push_back(std::make_unique<trace_buffer>((unsigned)trace_buffers.size(), trace_capacity));
+			thread_buffer = trace_buffers.back().get();
+		}
+		thread_buffer->add(e);
+	}
+
+	bool tracer::write(std::ostream& out) {
+		std::lock_guard<std::mutex> lock(trace_mutex);
+		std::uint64_t dropped = 0;
+
+		out << "{\"traceEvents\":[" << std::endl;
+		out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"triangle-game\"}}";
+		for (const auto& buffer : trace_buffers) {
+			unsigned tid = buffer->get_thread();
+			out << "," << std::endl << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+				<< ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+			for (const auto& e : buffer->get_events()) {
+				out << "," << std::endl << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+				write_micros(out, e.start);
+				out << ",\"dur\":";
+				write_micros(out, e.end - e.start);
+				if (e.value != TRACE_NO_VALUE)
+					out << ",\"args\":{\"value\":" << e.value << "}";
+				out << "}";
+			}
+			dropped += buffer->get_dropped();
+		}
+		out << std::endl << "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_spans\":\"" << dropped << "\"}}" << std::endl;
+		return (bool)out;
+	}
+
+	bool tracer::write() {
+		std::string path;
+		{
+			std::lock_guard<std::mutex> lock(trace_mutex);
+			path = trace_path;
+		}
+		if (path.empty()) return false;
+
+		std::ofstream out(path, std::ios::trunc);
+		return out && write(out);
+	}
+
+}
@@ -0,0 +1,205 @@
+/**
+ * @file trace.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the tracer, which records timed spans of work on each thread, and writes them out as a Chrome trace.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_TRACE__
+#define __H_TRIANGLE_TRACE__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Times the rest of the enclosing scope as a span with the given name, a string
+ * literal, and optionally a number shown with it. Spans are only compiled in when the
+ * build is configured with TRIANGLE_GAME_TRACE on, otherwise the macro and its arguments
+ * are compiled out, and cost nothing.
+ */
+#ifdef TRIANGLE_GAME_TRACE
+#define TRIANGLE_TRACE_JOIN_(a, b) a##b
+#define TRIANGLE_TRACE_JOIN(a, b) TRIANGLE_TRACE_JOIN_(a, b)
+#define TRIANGLE_TRACE(...) TriangleGame::trace_span TRIANGLE_TRACE_JOIN(_trace_span_, __LINE__)(__VA_ARGS__)
+#else
+#define TRIANGLE_TRACE(...) do {} while (0)
+#endif
+
+namespace TriangleGame {
+
+	const std::int64_t TRACE_NO_VALUE = INT64_MIN; //!< The value of a span shown without a number.
+	const std::size_t TRACE_DEFAULT_EVENTS = 1 << 16; //!< The spans each thread keeps, by default.
+
+	/**
+	 * @brief A finished span.
+	 */
+	struct trace_event {
+		const char* name; //!< The name of the span, a string literal.
+		std::uint64_t start; //!< When the span started, in nanoseconds since tracing started.
+		std::uint64_t end; //!< When the span ended, in nanoseconds since tracing started.
+		std::int64_t value; //!< The number shown with the span, or TRACE_NO_VALUE.
+	};
+
+	/**
+	 * @brief The Trace Buffer Class, the last spans finished on one thread.
+	 *
+	 * The buffer is a ring, only written by its own thread, so adding a span takes no lock.
+	 * Once it is full, each span overwrites the oldest, so a long run keeps its last spans.
+	 */
+	class trace_buffer {
+		public:
+			/**
+			 * @brief Construct a new buffer.
+			 *
+			 * @param thread The number of the thread, in the order threads first traced a span.
+			 * @param capacity The most spans kept.
+			 */
+			trace_buffer(unsigned thread, std::size_t capacity);
+
+			/**
+			 * @brief Adds a span, overwriting the oldest when the buffer is full.
+			 *
+			 * @param e The span.
+			 */
+			void add(const trace_event& e) noexcept {
+				_events[_added % _events.size()] = e;
+				_added++;
+			}
+
+			/**
+			 * @brief Returns the number of the thread.
+			 *
+			 * @return unsigned The thread number.
+			 */
+			unsigned get_thread() const noexcept;
+
+			/**
+			 * @brief Returns the spans kept, oldest first.
+			 *
+			 * @return std::vector<trace_event> The spans.
+			 */
+			std::vector<trace_event> get_events() const;
+
+			/**
+			 * @brief Returns the number of spans overwritten.
+			 *
+			 * @return std::uint64_t The number of spans lost.
+			 */
+			std::uint64_t get_dropped() const noexcept;
+
+		private:
+			unsigned _thread; //!< The number of the thread.
+			std::vector<trace_event> _events; //!< The ring of spans.
+			std::uint64_t _added; //!< The number of spans ever added.
+	};
+
+	/**
+	 * @brief The Tracer, records spans from every thread into their own trace buffers,
+	 * and writes them out in the Chrome trace event format, for chrome://tracing or Perfetto.
+	 *
+	 * Tracing is off until started, and a span then only checks a flag. Each thread makes
+	 * its buffer the first time it finishes a span, and the buffers are kept after their
+	 * threads end, so every thread's spans are written. Once started, the trace is written
+	 * when the program exits.
+	 */
+	class tracer {
+		public:
+			/**
+			 * @brief Starts tracing, and writes the trace to the given file when the program exits.
+			 *
+			 * @param path The file to write.
+			 * @param events The spans each thread keeps.
+			 */
+			static void start(const std::string& path, std::size_t events = TRACE_DEFAULT_EVENTS);
+
+			/**
+			 * @brief Determinds if tracing has been started.
+			 *
+			 * @return true If spans are recorded.
+			 * @return false Otherwise.
+			 */
+			static bool is_enabled() noexcept {
+				return _enabled.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Returns the time since tracing started.
+			 *
+			 * @return std::uint64_t The time, in nanoseconds.
+			 */
+			static std::uint64_t now() noexcept;
+
+			/**
+			 * @brief Adds a finished span to the calling thread's buffer.
+			 *
+			 * @param e The span.
+			 */
+			static void add(const trace_event& e);
+
+			/**
+			 * @brief Writes every thread's spans as a Chrome trace.
+			 *
+			 * @param out The stream to write to.
+			 * @return true If the trace was written.
+			 * @return false If the stream failed.
+			 */
+			static bool write(std::ostream& out);
+
+			/**
+			 * @brief Writes the trace to the file given to start.
+			 *
+			 * @return true If the trace was written.
+			 * @return false If the file could not be written.
+			 */
+			static bool write();
+
+		private:
+			static std::atomic<bool> _enabled; //!< True once tracing has started.
+	};
+
+	/**
+	 * @brief The Trace Span Class, times its own lifetime, and adds it to the tracer when it ends.
+	 * Use it through TRIANGLE_TRACE, so it is compiled out of builds without tracing.
+	 */
+	class trace_span {
+		public:
+			/**
+			 * @brief Starts a span, when tracing is on.
+			 *
+			 * @param name The name of the span, a string literal.
+			 * @param value A number shown with the span, or TRACE_NO_VALUE.
+			 */
+			explicit trace_span(const char* name, std::int64_t value = TRACE_NO_VALUE) noexcept
+				: _name(name), _value(value), _active(tracer::is_enabled()), _start(_active ? tracer::now() : 0)
+			{
+
+			}
+
+			trace_span(const trace_span&) = delete;
+			trace_span& operator=(const trace_span&) = delete;
+
+			/**
+			 * @brief Ends the span, and adds it to the tracer.
+			 */
+			~trace_span() {
+				if (_active) tracer::add({ _name, _start, tracer::now(), _value });
+			}
+
+		private:
+			const char* _name; //!< The name of the span.
+			std::int64_t _value; //!< The number shown with the span.
+			bool _active; //!< True when tracing was on as the span started.
+			std::uint64_t _start; //!< When the span started.
+	};
+
+}
+
+#endif
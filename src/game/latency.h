@@ -0,0 +1,122 @@
+#pragma once
+#ifndef __H_TRI_GAME_LATENCY__
+#define __H_TRI_GAME_LATENCY__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <latency_histogram.h>
+
+static std::atomic<bool> latency_dump_requested(false);
+
+/**
+ * @brief Asks for the turn latencies to be shown, at the next turn or the next pass of the server's loop.
+ */
+void request_latency_dump(int) {
+	latency_dump_requested.store(true);
+}
+
+/**
+ * @brief The phases of the engine's work in a turn, the time spent waiting for the player is not timed.
+ */
+enum class turn_phase {
+	get_all_moves,	//!< Finding the moves left.
+	move_peg,		//!< Making a jump.
+	render,			//!< Drawing the board and the moves.
+	history,		//!< Undoing, redoing or seeking through the moves, and showing them.
+	count			//!< The number of phases.
+};
+
+const char* TURN_PHASE_NAMES[] = { "get_all_moves", "move_peg", "render", "history" }; //!< The name of each phase.
+
+/**
+ * @brief A latency histogram for each phase of a turn.
+ */
+class turn_latencies {
+	public:
+		/**
+		 * @brief Counts a duration of a phase.
+		 *
+		 * @param phase The phase.
+		 * @param nanoseconds The duration.
+		 */
+		void record(turn_phase phase, std::uint64_t nanoseconds) noexcept {
+			_phases[(int)phase].record(nanoseconds);
+		}
+
+		/**
+		 * @brief Returns the histogram of a phase.
+		 *
+		 * @param phase The phase.
+		 * @return const TriangleGame::latency_histogram& The histogram.
+		 */
+		const TriangleGame::latency_histogram& get(turn_phase phase) const noexcept {
+			return _phases[(int)phase];
+		}
+
+		/**
+		 * @brief Creates a table of the percentiles of each phase, in microseconds.
+		 *
+		 * @return std::string The table.
+		 */
+		std::string to_string() const {
+			std::stringstream ss;
+			ss << "-------- Turn Latency (microseconds) --------" << std::endl;
+			ss << std::left << std::setw(16) << "Phase" << std::right << std::setw(10) << "Count"
+				<< std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+
+			ss << std::fixed << std::setprecision(1);
+			for (int p = 0; p < (int)turn_phase::count; p++) {
+				const auto& h = _phases[p];
+				ss << std::left << std::setw(16) << TURN_PHASE_NAMES[p] << std::right << std::setw(10) << h.get_count()
+					<< std::setw(10) << h.get_percentile(50) / 1e3 << std::setw(10) << h.get_percentile(90) / 1e3
+					<< std::setw(10) << h.get_percentile(99) / 1e3 << std::setw(10) << h.get_max() / 1e3 << std::endl;
+			}
+			return ss.str();
+		}
+
+	private:
+		std::array<TriangleGame::latency_histogram, (std::size_t)turn_phase::count> _phases; //!< The histogram of each phase.
+};
+
+/**
+ * @brief Times its own lifetime as a phase of a turn, when there are latencies to record to.
+ */
+class phase_timer {
+	public:
+		/**
+		 * @brief Starts timing a phase.
+		 *
+		 * @param latencies The latencies to record to, or nullptr to not time.
+		 * @param phase The phase.
+		 */
+		phase_timer(turn_latencies* latencies, turn_phase phase)
+			: _latencies(latencies), _phase(phase)
+		{
+			if (_latencies != nullptr) _start = std::chrono::steady_clock::now();
+		}
+
+		phase_timer(const phase_timer&) = delete;
+		phase_timer& operator=(const phase_timer&) = delete;
+
+		/**
+		 * @brief Records the phase's duration.
+		 */
+		~phase_timer() {
+			if (_latencies == nullptr) return;
+			auto elapsed = std::chrono::steady_clock::now() - _start;
+			_latencies->record(_phase, (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+		}
+
+	private:
+		turn_latencies* _latencies; //!< The latencies to record to, or nullptr.
+		turn_phase _phase; //!< The phase being timed.
+		std::chrono::steady_clock::time_point _start; //!< When the phase started.
+};
+
+#endif
@@ -0,0 +1,197 @@
+#pragma once
+#ifndef __H_TRI_GAME_LOAD_TEST__
+#define __H_TRI_GAME_LOAD_TEST__
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "server.h"
+
+/**
+ * @brief One connection of the load test, playing random games.
+ */
+struct load_session {
+	int fd; //!< The connection to the server.
+	std::string in; //!< The response received so far.
+	std::chrono::steady_clock::time_point sent; //!< When the last line was sent.
+	bool timed; //!< True when the response being waited for is timed.
+};
+
+/**
+ * @brief Picks the line a load test session sends in reply to a whole response.
+ *
+ * @param response The response, ending in a prompt.
+ * @param rng The random number generator.
+ * @param line The returned line.
+ * @return true If the response was understood.
+ * @return false Otherwise.
+ */
+bool load_test_reply(const std::string& response, std::mt19937_64& rng, std::string& line) {
+	if (response.find("Play Again") != std::string::npos) {
+		line = "Y\n";
+		return true;
+	}
+
+	auto first = response.find("First Peg to Remove (1-");
+	if (first != std::string::npos) {
+		int pegs = std::atoi(response.c_str() + first + 23);
+		if (pegs < 1) return false;
+		line = std::to_string(std::uniform_int_distribution<int>(1, pegs)(rng)) + "\n";
+		return true;
+	}
+
+	//the moves are in compact notation, "from-to,from-to"
+	auto moves = response.rfind("Moves: ");
+	if (moves == std::string::npos) return false;
+	auto end = response.find('\n', moves);
+	auto list = response.substr(moves + 7, end - moves - 7);
+
+	auto picks = std::vector<std::string>();
+	std::size_t start = 0;
+	while (start < list.size()) {
+		auto comma = list.find(',', start);
+		if (comma == std::string::npos) comma = list.size();
+		picks.push_back(list.substr(start, comma - start));
+		start = comma + 1;
+	}
+	if (picks.empty()) return false;
+
+	auto pick = picks[std::uniform_int_distribution<std::size_t>(0, picks.size() - 1)(rng)];
+	auto dash = pick.find('-');
+	if (dash == std::string::npos) return false;
+	line = "J " + pick.substr(0, dash) + " " + pick.substr(dash + 1) + "\n";
+	return true;
+}
+
+/**
+ * @brief Returns the percentile of sorted latencies.
+ */
+std::uint32_t latency_percentile(const std::vector<std::uint32_t>& sorted, double percentile) {
+	if (sorted.empty()) return 0;
+	return sorted[std::min(sorted.size() - 1, (std::size_t)(percentile / 100.0 * sorted.size()))];
+}
+
+/**
+ * @brief Opens many sessions to a running server, and plays random games on all of them at once,
+ * measuring how long each turn takes to be answered. Runs for the given time, or until Ctrl+C.
+ *
+ * @param address The server's port number, or the path of its Unix socket.
+ * @param sessions The number of sessions to open.
+ * @param seconds How long to play for.
+ * @param seed The random seed.
+ * @return int The program exit code.
+ */
+int run_load_test(const std::string& address, unsigned sessions, double seconds, unsigned long long seed) {
+	raise_file_limit();
+
+	sockaddr_storage addr;
+	socklen_t length;
+	if (!resolve_address(address, addr, length)) {
+		std::cerr << "Error: " << address << " is not a port number, or a Unix socket path" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	int epollFd = epoll_create1(EPOLL_CLOEXEC);
+	auto conns = std::vector<load_session>(sessions);
+	auto now = std::chrono::steady_clock::now();
+
+	//connecting blocks, so a full backlog waits for the server instead of failing
+	for (unsigned i = 0; i < sessions; i++) {
+		int fd = socket(addr.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd < 0 || connect(fd, (sockaddr*)&addr, length) != 0) {
+			std::cerr << "Error: unable to open session " << i + 1 << " to " << address << ": " << std::strerror(errno) << std::endl;
+			if (fd >= 0) close(fd);
+			for (unsigned k = 0; k < i; k++) close(conns[k].fd);
+			close(epollFd);
+			return EXIT_FAILURE;
+		}
+		fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+		conns[i] = { fd, std::string(), now, false };
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.u32 = i;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+	}
+
+	std::cout << "Opened " << sessions << " sessions to " << address << ", playing for " << seconds << " seconds" << std::endl;
+	std::signal(SIGINT, stop_server);
+	std::signal(SIGTERM, stop_server);
+
+	auto rng = std::mt19937_64(seed);
+	auto latencies = std::vector<std::uint32_t>();
+	std::uint64_t games = 0, errors = 0;
+	auto started = std::chrono::steady_clock::now();
+	auto until = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+	epoll_event events[SERVER_MAX_EVENTS];
+	char buffer[SERVER_READ_BYTES];
+	while (!server_stop_requested.load() && std::chrono::steady_clock::now() < until) {
+		int n = epoll_wait(epollFd, events, SERVER_MAX_EVENTS, 200);
+		for (int i = 0; i < n; i++) {
+			auto& s = conns[events[i].data.u32];
+
+			ssize_t got;
+			while ((got = recv(s.fd, buffer, sizeof(buffer), 0)) > 0)
+				s.in.append(buffer, (std::size_t)got);
+			if (got == 0) {
+				errors++;
+				close(s.fd);
+				s.fd = -1;
+				continue;
+			}
+
+			//wait for the rest of the response
+			if (s.in.size() < SERVER_PROMPT_END.size() || s.in.compare(s.in.size() - SERVER_PROMPT_END.size(), SERVER_PROMPT_END.size(), SERVER_PROMPT_END) != 0)
+				continue;
+
+			auto received = std::chrono::steady_clock::now();
+			if (s.timed)
+				latencies.push_back((std::uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(received - s.sent).count());
+			if (s.in.find("Play Again") != std::string::npos)
+				games++;
+
+			std::string line;
+			if (!load_test_reply(s.in, rng, line)) {
+				errors++;
+				line = "V\n";
+			}
+			s.in.clear();
+
+			s.sent = std::chrono::steady_clock::now();
+			s.timed = true;
+			if (send(s.fd, line.data(), line.size(), MSG_NOSIGNAL) != (ssize_t)line.size())
+				errors++;
+		}
+	}
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+	for (auto& s : conns) {
+		if (s.fd >= 0) close(s.fd);
+	}
+	close(epollFd);
+
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << "Turns: " << latencies.size() << ", Games Finished: " << games << ", Errors: " << errors
+		<< ", Seconds: " << elapsed << std::endl;
+	std::cout << "Turns per Second: " << (elapsed > 0 ? latencies.size() / elapsed : 0)
+		<< ", Turns per Second per Session: " << (elapsed > 0 && sessions > 0 ? latencies.size() / elapsed / sessions : 0) << std::endl;
+	std::cout << "Turn Latency (microseconds): p50 " << latency_percentile(latencies, 50)
+		<< ", p90 " << latency_percentile(latencies, 90)
+		<< ", p99 " << latency_percentile(latencies, 99)
+		<< ", max " << (latencies.empty() ? 0 : latencies.back()) << std::endl;
+	return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif
@@ -1,5 +1,10 @@
 #include "main.h"
 #include "program_config.h"
+#include "playouts.h"
+#include "solve.h"
+#include "records.h"
+#include "server.h"
+#include "load_test.h"
 
 using namespace std;
 
@@ -10,8 +15,74 @@ int main(int argc, char** argv) {
 	if (!program_config::parse_args(argc, argv))
 		return EXIT_FAILURE;
 
+	//Record Spans of Work, written out when the program exits
+#ifdef TRIANGLE_GAME_TRACE
+	if (!program_config::TracePath.empty())
+		TriangleGame::tracer::start(program_config::TracePath);
+#endif
+
+	//Find the Board to Play On
+	TriangleGame::topology geometry;
+	if (!load_topology(program_config::BoardName, program_config::BoardHeight, program_config::BoardFile, geometry))
+		return EXIT_FAILURE;
+
+	//The triangle keeps its own board, with history and saving
+	bool triangle = program_config::BoardFile.empty() && program_config::BoardName == "triangle";
+
+	//Convert an Archive of Games, instead of playing
+	if (!program_config::ConvertPath.empty())
+		return run_convert(program_config::ConvertPath, program_config::OutputPath);
+
+	//Host Games for Many Players, instead of playing
+	if (!program_config::ServeAddress.empty())
+		return run_server(program_config::BoardHeight, program_config::ServeAddress, program_config::Latency, program_config::MemoryLimitMB);
+
+	//Play Random Games Against a Running Server, instead of playing
+	if (program_config::LoadTestSessions > 0)
+		return run_load_test(program_config::ConnectAddress, program_config::LoadTestSessions, program_config::Duration, program_config::Seed);
+
+	//Run Random Playouts, instead of playing
+	if (program_config::Playouts > 0)
+		return run_playouts(geometry, program_config::StartPeg, program_config::Playouts,
+			program_config::Threads, program_config::Seed, program_config::PlayoutPolicy, program_config::BatchSize);
+
+	//Find a Single Peg Finish from Both Ends, instead of playing
+	if (program_config::Bidirectional)
+		return run_bidirectional_solve(geometry, program_config::StartPeg, triangle, program_config::MemoryLimitMB, program_config::Goal);
+
+	//Find Every Solvable Start and Finish, instead of playing
+	if (program_config::GoalGrid)
+		return run_goal_grid(geometry, program_config::Threads);
+
+	//Find the Finish with the Fewest Moves, instead of playing
+	if (program_config::FewestMoves)
+		return run_chain_solve(geometry, program_config::StartPeg, triangle, program_config::MemoryLimitMB);
+
+	//Stream Every Single Peg Finish, instead of playing
+	if (program_config::AllSolutions)
+		return run_all_solutions(geometry, program_config::StartPeg, triangle, program_config::OutputPath, program_config::MemoryLimitMB);
+
+	//Evaluate a File of Positions, instead of playing
+	if (!program_config::EvaluatePath.empty())
+		return run_evaluate(program_config::EvaluatePath, program_config::OutputPath, program_config::Threads, program_config::MemoryLimitMB);
+
+	//Split a Solve Across Worker Processes, instead of playing
+	if (program_config::DistributedWorkers > 0)
+		return run_distributed_solve(geometry, program_config::StartPeg, program_config::DistributedWorkers, program_config::Scaling);
+
+	//Solve the Starting Position, instead of playing
+	if (program_config::Solve)
+		return run_solve(geometry, program_config::StartPeg, program_config::CheckpointPath,
+			program_config::CheckpointInterval, program_config::ProgressInterval, program_config::ResumePath, program_config::Reduction, program_config::MemoryLimitMB);
+
+	//List Every Reachable Position, instead of playing
+	if (program_config::Census)
+		return run_census(geometry, program_config::StartPeg, program_config::MemoryMB,
+			program_config::WorkDir, program_config::CensusExport);
+
 	//Run Game Loop
-	game_loop(program_config::BoardHeight);
+	if (!game_loop(geometry, triangle, program_config::LoadPath, program_config::Tty, program_config::Analysis, program_config::RecordPath, program_config::Latency))
+		return EXIT_FAILURE;
 
 	return EXIT_SUCCESS;
 }
\ No newline at end of file
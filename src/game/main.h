@@ -2,22 +2,76 @@
 #ifndef __H_TRI_GAME_MAIN__
 #define __H_TRI_GAME_MAIN__
 
+#include <csignal>
 #include <iostream>
 #include <string>
 #include <vector>
 
 
+#include <memory>
+
 #include <util.h>
 #include <board.h>
+#include <topology.h>
+#include <snapshot.h>
+#include <jump_table.h>
+#include <hint_service.h>
+#include <game_analysis.h>
+#include <trace.h>
+
+#include "tty_renderer.h"
+#include "records.h"
+#include "latency.h"
 
-const std::string GAME_ACTIONS_QUESTION = "Select (J)ump, (U)ndo Previous Move, (V)iew History, (Q)uit";
+const std::string GAME_ACTIONS_QUESTION = "Select (J)ump, (U)ndo Previous Move, (R)edo, (G)o to Move, (V)iew History, (H)int, (S)ave, (Q)uit";
 const std::vector<char> GAME_ACTIONS = {
 	'J',	// Jump Peg
 	'U',	// Undo Previous Move
+	'R',	// Redo Undone Move
+	'G',	// Go to Move
+	'V',	// View History
+	'H',	// Hint
+	'S',	// Save Game
+	'Q' 	// Quit Game
+};
+
+const std::string TTY_GAME_ACTIONS_QUESTION = "Select (J)ump, (N)ext/(P)revious Moves, (U)ndo, (R)edo, (G)o to Move, (V)iew History, (H)int, (S)ave, (Q)uit";
+const std::vector<char> TTY_GAME_ACTIONS = {
+	'J',	// Jump Peg
+	'N',	// Next Page of Moves
+	'P',	// Previous Page of Moves
+	'U',	// Undo Previous Move
+	'R',	// Redo Undone Move
+	'G',	// Go to Move
 	'V',	// View History
+	'H',	// Hint
+	'S',	// Save Game
 	'Q' 	// Quit Game
 };
 
+/**
+ * @brief Finds the board to play on, a board file when one is given, otherwise a built-in board.
+ * Prints the reason to std::cerr when the board can not be found.
+ *
+ * @param name The name of the built-in board.
+ * @param size The height of the triangle, or the side of the hexagon.
+ * @param path The path of a board file, or empty.
+ * @param geometry The returned board.
+ * @return true If the board was found.
+ * @return false Otherwise.
+ */
+bool load_topology(const std::string& name, int size, const std::string& path, TriangleGame::topology& geometry) {
+	if (!path.empty()) {
+		if (TriangleGame::topology::load_file(path, geometry)) return true;
+		std::cerr << "Error: unable to read a board from " << path << std::endl;
+		return false;
+	}
+
+	if (TriangleGame::topology::preset(name, size, geometry)) return true;
+	std::cerr << "Error: there is no built-in board named " << name << std::endl;
+	return false;
+}
+
 std::string move_list_to_str(int pegNumber, const TriangleGame::t_moves & moves) {
 	std::stringstream ss;
 	ss << util::vector_to_str(moves) << " => " << pegNumber;
@@ -36,6 +90,34 @@ std::string move_list_to_str(const TriangleGame::t_open_moves& m) {
 	return ss.str();
 }
 
+/**
+ * @brief Formats the moves with the rating of each jump, as the hint service has found them so far.
+ * W can still be won, a number is the fewest pegs that can be left, and ? is still being solved.
+ *
+ * @param m The moves, by the hole jumped to.
+ * @param ratings The jumps of the position rated so far.
+ * @return std::string The moves, "[7 W, 1 3] => 2, [9 ?] => 4".
+ */
+std::string move_list_to_str(const TriangleGame::t_open_moves& m, const TriangleGame::t_move_ratings& ratings) {
+	std::stringstream ss;
+	int i = 0;
+	for (auto it = m.begin(); it != m.end(); ++it, i++) {
+		if (i > 0) ss << ", ";
+		ss << "[";
+		for (std::size_t k = 0; k < it->second.size(); k++) {
+			if (k > 0) ss << ", ";
+			ss << it->second[k];
+
+			auto r = std::find_if(ratings.begin(), ratings.end(), [&](const TriangleGame::move_rating& x) { return x.from == it->second[k] && x.to == it->first; });
+			if (r == ratings.end()) ss << " ?";
+			else if (r->pegs_left == 1) ss << " W";
+			else ss << " " << r->pegs_left;
+		}
+		ss << "] => " << it->first;
+	}
+	return ss.str();
+}
+
 
 TriangleGame::t_moves merge_lists(TriangleGame::t_open_moves& m) {
 	auto v = TriangleGame::t_moves();
@@ -73,62 +155,209 @@ std::string get_game_result(int total_pegs_left) {
 	}
 }
 
-void initalize_game(TriangleGame::board& board) {
+void initalize_game(TriangleGame::board& board, tty_renderer* tty = nullptr) {
 	//Show Game Board
-	std::cout << board << std::endl << std::endl;
+	if (tty != nullptr)
+		tty->draw(board);
+	else
+		std::cout << board << std::endl << std::endl;
 
 	//Ask for First Peg to Remove
 	int pegNumber = util::ask_for_number("Enter First Peg to Remove", 1, board.get_total_pegs());
 	board.remove_inital_peg(pegNumber);
 }
 
-void play_game(int height) {
-	//Init Game Board	 
-	auto board = TriangleGame::board(height);
+std::string hint_to_str(const TriangleGame::hint& h) {
+	std::stringstream ss;
+	ss << "Hint: Jump peg [" << h.from << "] to [" << h.to << "], "
+		<< "the best you can finish with is " << h.pegs_left << " peg" << (h.pegs_left == 1 ? "" : "s") << " left";
+	return ss.str();
+}
+
+void save_game(const TriangleGame::board& board) {
+	if (!board.is_triangle()) {
+		std::cout << "Only games on the triangle can be saved" << std::endl << std::endl;
+		return;
+	}
+
+	std::string path = util::ask_user<std::string>("Save Game To File", [](std::string input) -> bool {
+		return !input.empty();
+	});
+
+	if (TriangleGame::snapshot::save_file(board, path))
+		std::cout << "Game Saved to " << path << ", resume it with --load " << path << std::endl << std::endl;
+	else
+		std::cout << "Failed to Save Game to " << path << std::endl << std::endl;
+}
+
+/**
+ * @brief Shows how each move of a finished game compares with the best that could have been played.
+ *
+ * @param board The finished game.
+ * @param table The jumps of the board.
+ */
+void show_analysis(const TriangleGame::board& board, const TriangleGame::jump_table& table) {
+	auto history = board.get_move_history();
+	TriangleGame::move first;
+	if (!history.try_get_move(0, first))
+		return;
+
+	auto jumps = std::vector<TriangleGame::t_jump_id>();
+	for (t_history_index i = 1; i < history.size(); i++) {
+		TriangleGame::move m;
+		TriangleGame::t_jump_id id;
+		if (!history.try_get_move(i, m) || !table.find_jump(m.get_from().get_number(), m.get_to().get_number(), id))
+			return;
+		jumps.push_back(id);
+	}
 
-	initalize_game(board);
-		
+	auto analysis = TriangleGame::game_analysis(table);
+	if (!analysis.run(table.get_start_state(first.get_removed().get_number()), jumps))
+		return;
+
+	std::cout << "-------- Analysis --------" << std::endl << analysis
+		<< "Analysed in " << analysis.get_seconds() << " seconds" << std::endl << std::endl;
+}
+
+void play_game(TriangleGame::board& board, const TriangleGame::jump_table* table, TriangleGame::hint_service* hints, tty_renderer* tty, bool analyse, const std::string& recordPath, turn_latencies* latencies) {
 	//Priming Reed Pattern
 	//Get All Moves
-	auto moves = board.get_all_moves();
+	TriangleGame::t_open_moves moves;
+	{
+		phase_timer timer(latencies, turn_phase::get_all_moves);
+		moves = board.get_all_moves();
+	}
+
+	//Without a terminal the moves are printed with the jumps rated so far, and printed
+	//again before the next prompt of a turn, if more have been rated since
+	std::size_t shownRatings = 0;
+	auto print_moves = [&]() {
+		if (hints == nullptr) {
+			std::cout << "Avaliable Moves: " << move_list_to_str(moves) << std::endl << std::endl;
+			return;
+		}
+
+		auto ratings = hints->get_ratings(table->get_state(board));
+		shownRatings = ratings.size();
+		std::cout << "Avaliable Moves (W wins, N pegs left, ? solving): " << move_list_to_str(moves, ratings) << std::endl << std::endl;
+	};
+	auto reprint_moves = [&]() {
+		if (hints != nullptr && tty == nullptr && hints->get_ratings(table->get_state(board)).size() != shownRatings)
+			print_moves();
+	};
 
 	//************************
 	//* Game Loop            *
 	//************************
 	while (!moves.empty()) {
-		//Show Game Board
-		std::cout << board << std::endl << std::endl;
+		TRIANGLE_TRACE("play_game::turn", board.get_ply());
+
+		//Show the Latencies so far, when asked for by a signal
+		if (latencies != nullptr && latency_dump_requested.exchange(false))
+			std::cerr << latencies->to_string();
 
-		//Show Avaliable Moves
-		std::cout << "Avaliable Moves: " << move_list_to_str(moves) << std::endl << std::endl;
+		//Start Solving the Position, while the Player is Thinking
+		if (hints != nullptr)
+			hints->warm(table->get_state(board));
+
+		//Show Game Board, and Avaliable Moves
+		//in a terminal only the changed holes, and a page of moves, are drawn
+		{
+			TRIANGLE_TRACE("play_game::render");
+			phase_timer timer(latencies, turn_phase::render);
+			if (tty != nullptr) {
+				tty->draw(board);
+				tty->show_moves(moves, table != nullptr ? table->get_state(board) : 0,
+					hints != nullptr ? hints->get_ratings(table->get_state(board)) : TriangleGame::t_move_ratings());
+			} else {
+				std::cout << board << std::endl << std::endl;
+				print_moves();
+			}
+		}
 
 		//Ask for Action
-		char action = util::ask_for_option<char>(GAME_ACTIONS_QUESTION, GAME_ACTIONS, util::format_funcs::char_to_upper);
+		char action;
+		{
+			TRIANGLE_TRACE("play_game::input_wait");
+			action = tty != nullptr
+				? util::ask_for_option<char>(TTY_GAME_ACTIONS_QUESTION, TTY_GAME_ACTIONS, util::format_funcs::char_to_upper)
+				: util::ask_for_option<char>(GAME_ACTIONS_QUESTION, GAME_ACTIONS, util::format_funcs::char_to_upper);
+		}
 
 		//Perform Action
 		if (action == 'J') { //Jump Peg
-				int fromPeg = util::ask_for_number("Select a Peg to Move", merge_lists(moves));
-				int toPeg = util::ask_for_number("Move To", get_open_pegs_from(fromPeg, moves));
-				board.move_peg(fromPeg, toPeg);
+			//the list of pegs is as long as the move list, so it is only printed without a terminal
+			int fromPeg, toPeg;
+			reprint_moves();
+			{
+				TRIANGLE_TRACE("play_game::input_wait");
+				fromPeg = tty != nullptr
+					? util::ask_user<int>("Select a Peg to Move", [&moves](int p) -> bool { return !get_open_pegs_from(p, moves).empty(); })
+					: util::ask_for_number("Select a Peg to Move", merge_lists(moves));
+				toPeg = util::ask_for_number("Move To", get_open_pegs_from(fromPeg, moves));
+			}
+			phase_timer timer(latencies, turn_phase::move_peg);
+			board.move_peg(fromPeg, toPeg);
+
+		} else if (action == 'N') { // Next Page of Moves
+			tty->next_page();
+
+		} else if (action == 'P') { // Previous Page of Moves
+			tty->previous_page();
 
 		} else if (action == 'U') { // Undo Previous Move
 			std::cout << "Undo Previous Move" << std::endl;
-			board.go_back();
+			{
+				phase_timer timer(latencies, turn_phase::history);
+				board.go_back();
+			}
 
 			//If the user undos the inital move, re-initalize the game
 			//which is asking for the first peg to be removed.
 			if (board.get_move_history().size() == 0) 
-				initalize_game(board);
+				initalize_game(board, tty);
+
+		} else if (action == 'R') { // Redo Undone Move
+			bool redone;
+			{
+				phase_timer timer(latencies, turn_phase::history);
+				redone = board.go_forward();
+			}
+			if (redone)
+				std::cout << "Redo Move" << std::endl;
+			else
+				std::cout << "No Moves to Redo" << std::endl;
+
+		} else if (action == 'G') { // Go to Move
+			{
+				phase_timer timer(latencies, turn_phase::history);
+				std::cout << "-------- Move History --------" << std::endl << board.get_move_history() << std::endl;
+			}
+			int ply = util::ask_for_number("Go to Move", 0, board.get_last_ply());
+			phase_timer timer(latencies, turn_phase::history);
+			board.seek(ply);
 
 		} else if (action == 'V') { // View History
+			phase_timer timer(latencies, turn_phase::history);
 			std::cout << "-------- Move History --------" << std::endl << board.get_move_history() << std::endl;
 
+		} else if (action == 'H') { // Hint
+			if (hints == nullptr)
+				std::cout << "Hints are not avaliable for boards with more than " << TriangleGame::MAX_STATE_HOLES << " holes" << std::endl << std::endl;
+			else
+				std::cout << hint_to_str(hints->get_hint(table->get_state(board))) << std::endl << std::endl;
+
+		} else if (action == 'S') { // Save Game
+			save_game(board);
+
 		} else { // Quit Game
+			if (tty != nullptr) tty->leave();
 			std::cout << "Quitting Game" << std::endl;
 			return;
 		}
 
 		//Get All Moves
+		phase_timer timer(latencies, turn_phase::get_all_moves);
 		moves = board.get_all_moves();
 	}
 
@@ -137,11 +366,29 @@ void play_game(int height) {
 	//************************
 	 
 	//Show Final Board
+	if (tty != nullptr) tty->leave();
 	std::cout << board << std::endl;
 
 	//Show Move History
 	std::cout << "-------- Move History --------" << std::endl << board.get_move_history() << std::endl;
 
+	//Show the Game in Compact Notation, and Add it to the Archive
+	//records hold the height of the board, so only the triangle's games have one
+	if (board.is_triangle()) {
+		auto record = TriangleGame::game_record(board.get_height(), board.get_move_history());
+		std::cout << "Record: " << record << std::endl << std::endl;
+		if (!recordPath.empty()) {
+			if (append_record(recordPath, record))
+				std::cout << "Game Added to " << recordPath << std::endl << std::endl;
+			else
+				std::cout << "Failed to Add Game to " << recordPath << std::endl << std::endl;
+		}
+	}
+
+	//Show How Each Move Compared with the Best
+	if (analyse && table != nullptr)
+		show_analysis(board, *table);
+
 	//Calcualte Total Pegs Left, and Show Results
 	int left = board.get_total_pegs() - board.get_total_removed_pegs();
 	std::cout << "Total Pegs Left: " << left << std::endl;
@@ -151,9 +398,89 @@ void play_game(int height) {
 	std::cout << std::endl << results << std::endl << std::endl;
 }
 
-void game_loop(int height) {
+/**
+ * @brief Plays games until the player stops, on the triangle or on any other board.
+ *
+ * @param geometry The board, for the triangle only its height is used.
+ * @param triangle True when the board is the triangle, which can be saved, recorded and drawn in a terminal.
+ * @param loadPath A saved game of the triangle to resume, or empty.
+ * @param useTty True to draw only the changes, when playing the triangle in a terminal.
+ * @param analyse True to rate every move of each finished game.
+ * @param recordPath The archive each finished game of the triangle is added to, or empty.
+ * @param latency True to time the engine's work in each turn.
+ * @return true If the board could be played on.
+ * @return false If the saved game could not be loaded.
+ */
+bool game_loop(const TriangleGame::topology& geometry, bool triangle, const std::string& loadPath, bool useTty, bool analyse, const std::string& recordPath, bool latency) {
+	//Init Game Board, or Resume a Saved Game, on a triangle no taller than a save can hold
+	int height = geometry.get_rows();
+	if (triangle && height > TriangleGame::SNAPSHOT_MAX_HEIGHT) {
+		std::cerr << "Error: the tallest triangle that can be played is " << TriangleGame::SNAPSHOT_MAX_HEIGHT << ", so that every game can be saved" << std::endl;
+		return false;
+	}
+	auto new_board = [&]() { return triangle ? TriangleGame::board(height) : TriangleGame::board(geometry); };
+	auto board = new_board();
+	bool resume = !loadPath.empty();
+	if (resume) {
+		if (!triangle) {
+			std::cerr << "Error: only games on the triangle can be saved and loaded" << std::endl;
+			return false;
+		}
+		if (!TriangleGame::snapshot::load_file(loadPath, board)) {
+			std::cerr << "Error: unable to load a saved game from " << loadPath << std::endl;
+			return false;
+		}
+		height = board.get_height();
+	}
+
+	//Hints are solved in the background, and cached across turns and games
+	std::unique_ptr<TriangleGame::jump_table> table;
+	std::unique_ptr<TriangleGame::hint_service> hints;
+	auto shape = triangle ? TriangleGame::topology::triangle(height) : geometry;
+	if (TriangleGame::jump_table::supports(shape)) {
+		table = std::make_unique<TriangleGame::jump_table>(shape);
+		hints = std::make_unique<TriangleGame::hint_service>(*table);
+	}
+
+	//Incremental drawing, only when playing the triangle in a terminal,
+	//where each jump is rated on the moves line as soon as it is solved
+	std::unique_ptr<tty_renderer> tty;
+	if (triangle && useTty && tty_renderer::available()) {
+		tty = std::make_unique<tty_renderer>(height);
+		if (hints) {
+			auto* renderer = tty.get();
+			hints->set_listener([renderer](TriangleGame::t_state s, const TriangleGame::move_rating& r) {
+				renderer->rate(s, r);
+			});
+		}
+	}
+
+	//The engine's work in each turn, shown when the program exits, or on a SIGUSR1
+	std::unique_ptr<turn_latencies> latencies;
+	if (latency) {
+		latencies = std::make_unique<turn_latencies>();
+		std::signal(SIGUSR1, request_latency_dump);
+	}
+
 	do {
-		play_game(height);
+		if (tty) tty->invalidate();
+		if (!resume) {
+			board = new_board();
+			initalize_game(board, tty.get());
+		} else if (board.get_move_history().size() == 0) {
+			initalize_game(board, tty.get());
+		}
+		resume = false;
+
+		play_game(board, table.get(), hints.get(), tty.get(), analyse, recordPath, latencies.get());
 	} while (util::ask_yes_no("Do You want to Play Again?"));
+
+	if (hints) hints->set_listener(nullptr);
+	if (latencies) {
+		std::signal(SIGUSR1, SIG_DFL);
+		std::cout << latencies->to_string();
+	}
+
+	return true;
 }
 #endif
\ No newline at end of file
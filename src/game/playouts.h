@@ -0,0 +1,66 @@
+#pragma once
+#ifndef __H_TRI_GAME_PLAYOUTS__
+#define __H_TRI_GAME_PLAYOUTS__
+
+#include <iostream>
+#include <string>
+
+#include <jump_table.h>
+#include <playout.h>
+
+/**
+ * @brief Checks that the board and starting peg can be used by the solver library.
+ * Prints the reason to std::cerr when they can not.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole.
+ * @return true If the board and starting peg are usable.
+ * @return false Otherwise.
+ */
+bool validate_solver_args(const TriangleGame::topology& geometry, int startPeg) {
+	if (!TriangleGame::jump_table::supports(geometry)) {
+		std::cerr << "Error: boards with more than " << TriangleGame::MAX_STATE_HOLES << " holes are not supported by the solver" << std::endl;
+		return false;
+	}
+
+	if (startPeg > geometry.get_hole_count()) {
+		std::cerr << "Error: starting peg " << startPeg << " is not on the " << geometry.get_name() << " board, which has " << geometry.get_hole_count() << " holes" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Plays random games from the starting peg, and shows the distribution of final peg counts.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole.
+ * @param count The number of playouts.
+ * @param threads The number of threads, 0 uses every core.
+ * @param seed The random seed.
+ * @param policy The name of the playout policy, "uniform", "weighted" or "greedy".
+ * @param batch The number of games each thread plays side by side, 0 plays one at a time.
+ * @return int The program exit code.
+ */
+int run_playouts(const TriangleGame::topology& geometry, int startPeg, long long count, unsigned threads, unsigned long long seed, const std::string& policy, unsigned batch) {
+	if (!validate_solver_args(geometry, startPeg))
+		return EXIT_FAILURE;
+
+	auto table = TriangleGame::jump_table(geometry);
+	auto engine = TriangleGame::playout_engine(table);
+	if (policy == "weighted")
+		engine.set_policy(TriangleGame::playout_policy::weighted);
+	else if (policy == "greedy")
+		engine.set_policy(TriangleGame::playout_policy::greedy);
+	engine.set_batch_size(batch);
+
+	std::cout << "Playing " << count << " " << policy << " random games, " << geometry.get_name() << " board, starting peg " << startPeg << std::endl << std::endl;
+
+	auto result = engine.run(table.get_start_state(startPeg), count, threads, seed);
+	std::cout << result << std::endl;
+
+	return EXIT_SUCCESS;
+}
+
+#endif
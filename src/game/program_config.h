@@ -11,6 +11,45 @@
 namespace program_config {
 
 	static int BoardHeight = TRIANGLE_GAME_DEFAULT_HEIGHT;
+	static long long Playouts = 0;
+	static int StartPeg = 1;
+	static unsigned Threads = 0;
+	static unsigned long long Seed = 0;
+	static std::string PlayoutPolicy = "uniform";
+	static unsigned BatchSize = 0;
+	static bool Solve = false;
+	static bool Bidirectional = false;
+	static bool Reduction = false;
+	static unsigned MemoryLimitMB = 0;
+	static std::string CheckpointPath = "";
+	static double CheckpointInterval = 300;
+	static double ProgressInterval = 10;
+	static std::string ResumePath = "";
+	static bool Tty = false;
+	static bool Analysis = false;
+	static bool Latency = false;
+	static std::string Goal = "";
+	static bool GoalGrid = false;
+	static bool FewestMoves = false;
+	static bool AllSolutions = false;
+	static std::string EvaluatePath = "";
+	static unsigned DistributedWorkers = 0;
+	static bool Scaling = false;
+	static bool Census = false;
+	static std::string CensusExport = "";
+	static unsigned MemoryMB = 1024;
+	static std::string WorkDir = "";
+	static std::string LoadPath = "";
+	static std::string RecordPath = "";
+	static std::string ServeAddress = "";
+	static unsigned LoadTestSessions = 0;
+	static std::string ConnectAddress = "7777";
+	static double Duration = 10;
+	static std::string ConvertPath = "";
+	static std::string OutputPath = "";
+	static std::string BoardName = "triangle";
+	static std::string BoardFile = "";
+	static std::string TracePath = "";
 
 	class RangeContraint : public TCLAP::Constraint<int> {
 		public:
@@ -99,18 +138,151 @@ namespace program_config {
 			//cmd.add(heightArg);
 			//--------------------------------
 
+			//--- Shape of the Game Board
+			std::vector<std::string> boards = { "triangle", "english", "european", "hexagon" };
+			TCLAP::ValuesConstraint<std::string> boardArgValues(boards);
+			TCLAP::ValueArg<std::string> boardArg("b", "board", "The shape of the Game Board, --height sets the side of the hexagon", false, "triangle", &boardArgValues, cmd);
+			TCLAP::ValueArg<std::string> boardFileArg("", "board-file", "Play on a board read from a file of hole and jump lines, instead of --board", false, "", "file", cmd);
+			//--------------------------------
+
+			//--- Terminal Drawing
+			TCLAP::SwitchArg ttyArg("", "tty", "Draw the board once, then only redraw the holes that change, and page the move list. Needs an ANSI terminal", cmd);
+			//--------------------------------
+
+			//--- Post Game Analysis
+			TCLAP::SwitchArg analysisArg("", "analysis", "After each game, show whether each move kept the game winnable, and the best jump when it did not", cmd);
+			//--------------------------------
+
+			//--- Resume a Saved Game
+			TCLAP::ValueArg<std::string> loadArg("l", "load", "Resume a game saved with the (S)ave action, the height is taken from the saved game", false, "", "file", cmd);
+			//--------------------------------
+
+			//--- Game Records
+			TCLAP::ValueArg<std::string> recordArg("", "record", "Add each finished game to the given archive, in the binary format when it ends in .tgr, or as a line of text", false, "", "file", cmd);
+			TCLAP::ValueArg<std::string> convertArg("", "convert", "Convert the games of an archive into --output, instead of playing", false, "", "file", cmd);
+			TCLAP::ValueArg<std::string> outputArg("", "output", "The archive --convert or --all-solutions writes, in the binary format when it ends in .tgr, or the results --evaluate writes", false, "", "file", cmd);
+			//--------------------------------
+
+			//--- Game Server
+			TCLAP::ValueArg<std::string> serveArg("", "serve", "Host games for players connecting to a port on this machine, or to a Unix socket path, instead of playing", false, "", "port|path", cmd);
+			TCLAP::ValueArg<unsigned> loadTestArg("", "load-test", "Open the given number of sessions to the --connect server, play random games on them, and show the turn latencies", false, 0, "sessions", cmd);
+			TCLAP::ValueArg<std::string> connectArg("", "connect", "The port or Unix socket path of the server --load-test connects to", false, "7777", "port|path", cmd);
+			TCLAP::ValueArg<double> durationArg("", "duration", "The seconds --load-test plays for", false, 10, "seconds", cmd);
+			//--------------------------------
+
+			//--- Random Playouts
+			TCLAP::ValueArg<long long> playoutsArg("p", "playouts", "Play the given number of random games from the starting peg, and show the final peg counts, instead of playing", false, 0, "count", cmd);
+
+			RangeContraint startArgRange(1);
+			TCLAP::ValueArg<int> startArg("s", "start", "The starting peg hole, the first peg removed, used by --playouts", false, 1, &startArgRange, cmd);
+
+			TCLAP::ValueArg<unsigned> threadsArg("j", "threads", "The number of threads to use, 0 uses every core", false, 0, "threads", cmd);
+			TCLAP::ValueArg<unsigned long long> seedArg("", "seed", "The random seed, the same seed always gives the same results", false, 0, "seed", cmd);
+
+			std::vector<std::string> policies = { "uniform", "weighted", "greedy" };
+			TCLAP::ValuesConstraint<std::string> policyArgValues(policies);
+			TCLAP::ValueArg<std::string> policyArg("", "policy", "How random playouts pick their jumps", false, "uniform", &policyArgValues, cmd);
+			TCLAP::ValueArg<unsigned> batchArg("", "batch", "Play the given number of random games side by side on each thread, 0 plays one at a time", false, 0, "games", cmd);
+			//--------------------------------
+
+			//--- Solving
+			TCLAP::SwitchArg solveArg("", "solve", "Find the fewest pegs that can be left from the starting peg, instead of playing", cmd);
+			TCLAP::ValueArg<std::string> checkpointArg("", "checkpoint", "Write the solve to the given file every --checkpoint-interval seconds, and when it is stopped", false, "", "file", cmd);
+			TCLAP::ValueArg<double> checkpointIntervalArg("", "checkpoint-interval", "The seconds between checkpoints", false, 300, "seconds", cmd);
+			TCLAP::ValueArg<double> progressArg("", "progress", "The seconds between progress lines, 0 for none", false, 10, "seconds", cmd);
+			TCLAP::ValueArg<std::string> resumeArg("", "resume", "Continue a solve from its checkpoint", false, "", "file", cmd);
+			TCLAP::SwitchArg reductionArg("", "reduction", "Only search one order of jumps that commute, instead of leaving the other orders to the transposition table", cmd);
+			TCLAP::ValueArg<unsigned> memoryLimitArg("", "memory-limit", "The most megabytes --solve, --bidirectional, --fewest-moves, --all-solutions, --evaluate and the hints of --serve can use, searching with less stored past it, 0 for no limit, or 256 for --serve and --bidirectional without --goal", false, 0, "MB", cmd);
+			TCLAP::ValueArg<std::string> goalArg("", "goal", "The peg, or comma separated pegs, --bidirectional must finish with, instead of a single peg in any hole", false, "", "pegs", cmd);
+			TCLAP::SwitchArg goalGridArg("", "goal-grid", "Find every pair of starting hole and finishing hole that can be solved, instead of playing", cmd);
+			TCLAP::SwitchArg fewestMovesArg("", "fewest-moves", "Find a single peg finish in the fewest moves, where jumps in a row by the same peg are one move, instead of playing", cmd);
+			TCLAP::SwitchArg allSolutionsArg("", "all-solutions", "Write every sequence of jumps that leaves a single peg as it is found, to stdout or --output, instead of playing", cmd);
+			TCLAP::ValueArg<std::string> evaluateArg("", "evaluate", "Find the fewest pegs that can be left from every \"height position\" line of a file, or - for stdin, writing the results to stdout or --output, instead of playing", false, "", "file", cmd);
+			TCLAP::ValueArg<unsigned> distributedArg("", "distributed", "Find the fewest pegs that can be left by splitting a search of every position across the given number of worker processes, instead of playing", false, 0, "workers", cmd);
+			TCLAP::SwitchArg scalingArg("", "scaling", "Run --distributed with 1, 2, 4, ... workers up to the number given, and compare the times", cmd);
+			TCLAP::SwitchArg bidirectionalArg("", "bidirectional", "Find a sequence of jumps that leaves a single peg, searching from the start and the finish at once, instead of playing", cmd);
+			//--------------------------------
+
+			//--- State Space Census
+			TCLAP::SwitchArg censusArg("", "census", "List every position reachable from the starting peg, and count them by pegs left, instead of playing", cmd);
+			TCLAP::ValueArg<std::string> censusExportArg("", "census-export", "Write every position found by --census to the given file", false, "", "file", cmd);
+			TCLAP::ValueArg<unsigned> memoryArg("", "memory", "The most megabytes of positions --census holds in memory, before spilling to disk", false, 1024, "MB", cmd);
+			TCLAP::ValueArg<std::string> workDirArg("", "work-dir", "The directory --census spills to, defaults to the system's temporary directory", false, "", "dir", cmd);
+			//--------------------------------
+
+			//--- Diagnostics
+			TCLAP::ValueArg<std::string> traceArg("", "trace", "Write timed spans of the solvers and the game loop to the given file when the program exits, in the Chrome trace format. Needs a build configured with -DTRIANGLE_GAME_TRACE=ON", false, "", "file", cmd);
+			TCLAP::SwitchArg latencyArg("", "latency", "Time the engine's work in each turn, finding moves, jumping, drawing and moving through the history, and show the percentiles of each when the game or --serve exits, or on a SIGUSR1", cmd);
+			//--------------------------------
+
 
 			//Parse Program Arguments
 			cmd.parse(argc, argv);
 
 			//Preform Action on those values
 			BoardHeight = heightArg.getValue();
+			LoadPath = loadArg.getValue();
+			RecordPath = recordArg.getValue();
+			ServeAddress = serveArg.getValue();
+			LoadTestSessions = loadTestArg.getValue();
+			ConnectAddress = connectArg.getValue();
+			Duration = durationArg.getValue();
+			ConvertPath = convertArg.getValue();
+			OutputPath = outputArg.getValue();
+			Tty = ttyArg.getValue();
+			Analysis = analysisArg.getValue();
+			Latency = latencyArg.getValue();
+			BoardName = boardArg.getValue();
+			BoardFile = boardFileArg.getValue();
+			TracePath = traceArg.getValue();
+			Playouts = playoutsArg.getValue();
+			StartPeg = startArg.getValue();
+			Threads = threadsArg.getValue();
+			Seed = seedArg.getValue();
+			PlayoutPolicy = policyArg.getValue();
+			BatchSize = batchArg.getValue();
+			Solve = solveArg.getValue() || resumeArg.isSet();
+			CheckpointPath = checkpointArg.getValue();
+			CheckpointInterval = checkpointIntervalArg.getValue();
+			ProgressInterval = progressArg.getValue();
+			ResumePath = resumeArg.getValue();
+			Bidirectional = bidirectionalArg.getValue() || goalArg.isSet();
+			Goal = goalArg.getValue();
+			GoalGrid = goalGridArg.getValue();
+			FewestMoves = fewestMovesArg.getValue();
+			AllSolutions = allSolutionsArg.getValue();
+			EvaluatePath = evaluateArg.getValue();
+			DistributedWorkers = distributedArg.getValue();
+			Scaling = scalingArg.getValue();
+			Reduction = reductionArg.getValue();
+			MemoryLimitMB = memoryLimitArg.getValue();
+			Census = censusArg.getValue() || censusExportArg.isSet();
+			CensusExport = censusExportArg.getValue();
+			MemoryMB = memoryArg.getValue();
+			WorkDir = workDirArg.getValue();
 
 		} catch (TCLAP::ArgException &e) {
 			std::cerr << "Error: " << e.error() << ", Argument: " << e.argId() << std::endl;
 			return false;
 		}
 
+#ifndef TRIANGLE_GAME_TRACE
+		if (!TracePath.empty()) {
+			std::cerr << "Error: --trace needs a build configured with -DTRIANGLE_GAME_TRACE=ON" << std::endl;
+			return false;
+		}
+#endif
+
+		if (Scaling && DistributedWorkers == 0) {
+			std::cerr << "Error: --scaling needs the most --distributed workers to run with" << std::endl;
+			return false;
+		}
+
+		if (!ConvertPath.empty() && OutputPath.empty()) {
+			std::cerr << "Error: --convert needs an --output archive to write" << std::endl;
+			return false;
+		}
+
 		return true;
 	}
 
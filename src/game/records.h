@@ -0,0 +1,96 @@
+#pragma once
+#ifndef __H_TRI_GAME_RECORDS__
+#define __H_TRI_GAME_RECORDS__
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <game_record.h>
+
+const std::string BINARY_RECORD_EXTENSION = ".tgr"; //!< Archives with this extension are written in the binary format.
+
+/**
+ * @brief Returns the format an archive is written in, binary for files ending in BINARY_RECORD_EXTENSION.
+ *
+ * @param path The path of the archive.
+ * @return TriangleGame::record_format The format.
+ */
+TriangleGame::record_format record_format_for(const std::string& path) {
+	return std::filesystem::path(path).extension() == BINARY_RECORD_EXTENSION
+		? TriangleGame::record_format::binary
+		: TriangleGame::record_format::text;
+}
+
+/**
+ * @brief Adds a finished game to the end of an archive, creating it if needed.
+ *
+ * @param path The path of the archive.
+ * @param record The game.
+ * @return true If the game was added.
+ * @return false If the archive could not be written.
+ */
+bool append_record(const std::string& path, const TriangleGame::game_record& record) {
+	std::error_code error;
+	bool header = !std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) == 0;
+
+	std::ofstream out(path, std::ios::binary | std::ios::app);
+	if (!out) return false;
+
+	auto writer = TriangleGame::record_writer(out, record_format_for(path), header);
+	return writer.write(record) && writer.finish();
+}
+
+/**
+ * @brief Streams every game of an archive into another, converting between the text and binary formats.
+ *
+ * @param inPath The archive to read, in either format.
+ * @param outPath The archive to write, binary when it ends in BINARY_RECORD_EXTENSION.
+ * @return int The program exit code.
+ */
+int run_convert(const std::string& inPath, const std::string& outPath) {
+	std::ifstream in(inPath, std::ios::binary);
+	if (!in) {
+		std::cerr << "Error: unable to read " << inPath << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		std::cerr << "Error: unable to write " << outPath << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	auto started = std::chrono::steady_clock::now();
+	auto reader = TriangleGame::record_reader(in);
+	auto writer = TriangleGame::record_writer(out, record_format_for(outPath));
+
+	auto record = TriangleGame::game_record();
+	while (reader.next(record)) {
+		if (!writer.write(record)) break;
+	}
+
+	bool written = writer.finish();
+	out.close();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+	if (reader.failed()) {
+		std::cerr << "Error: game " << reader.get_count() + 1 << " of " << inPath << " is not a valid record" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (!written || !out) {
+		std::cerr << "Error: unable to write " << outPath << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::error_code error;
+	double megabytes = (std::filesystem::file_size(inPath, error) + std::filesystem::file_size(outPath, error)) / 1e6;
+	std::cout << "Converted " << writer.get_count() << " games from " << inPath << " to " << outPath << std::endl;
+	std::cout << "Read and Written: " << megabytes << " MB, Seconds: " << seconds
+		<< ", MB per Second: " << (seconds > 0 ? megabytes / seconds : 0) << std::endl;
+	return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,798 @@
+#pragma once
+#ifndef __H_TRI_GAME_SERVER__
+#define __H_TRI_GAME_SERVER__
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <board.h>
+#include <game_record.h>
+#include <hint_service.h>
+#include <jump_table.h>
+
+#include "main.h"
+
+const int SERVER_MAX_EVENTS = 256; //!< The most socket events handled per wait.
+const std::size_t SERVER_MAX_LINE = 256; //!< The longest line a player can send, longer ones close the session.
+const std::size_t SERVER_READ_BYTES = 4096; //!< The most bytes read from a socket at once.
+const std::string SERVER_PROMPT_END = "> "; //!< Ends every prompt, a response is complete once it is received.
+const std::size_t SERVER_HINT_MEMORY = (std::size_t)256 << 20; //!< The most memory the hint solver can use, when no limit is given.
+
+static std::atomic<bool> server_stop_requested(false);
+
+/**
+ * @brief Asks the running server, or load test, to stop.
+ */
+void stop_server(int) {
+	server_stop_requested.store(true);
+}
+
+/**
+ * @brief Raises the limit of open files to the most allowed, so thousands of sessions can be open.
+ */
+void raise_file_limit() {
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+}
+
+/**
+ * @brief Returns the memory the process is using.
+ *
+ * @return std::size_t The resident set size, in bytes, 0 when it is not known.
+ */
+std::size_t resident_bytes() {
+	std::ifstream statm("/proc/self/statm");
+	std::size_t pages = 0, resident = 0;
+	if (!(statm >> pages >> resident)) return 0;
+	return resident * (std::size_t)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Finds the socket address of a port on this machine, or of a Unix socket.
+ *
+ * @param address A port number, for TCP on 127.0.0.1, or the path of a Unix socket.
+ * @param addr The returned socket address.
+ * @param length The returned length of the address.
+ * @return true If the address is valid.
+ * @return false Otherwise.
+ */
+bool resolve_address(const std::string& address, sockaddr_storage& addr, socklen_t& length) {
+	std::memset(&addr, 0, sizeof(addr));
+
+	bool port = !address.empty() && address.find_first_not_of("0123456789") == std::string::npos;
+	if (port) {
+		unsigned long number = std::stoul(address);
+		if (number == 0 || number > 65535) return false;
+
+		auto* in = (sockaddr_in*)&addr;
+		in->sin_family = AF_INET;
+		in->sin_port = htons((std::uint16_t)number);
+		in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		length = sizeof(sockaddr_in);
+		return true;
+	}
+
+	auto* un = (sockaddr_un*)&addr;
+	if (address.empty() || address.size() >= sizeof(un->sun_path)) return false;
+	un->sun_family = AF_UNIX;
+	std::memcpy(un->sun_path, address.c_str(), address.size() + 1);
+	length = sizeof(sockaddr_un);
+	return true;
+}
+
+/**
+ * @brief The input a game session is waiting for.
+ */
+enum class session_state {
+	start_peg,	//!< The first peg to remove.
+	action,		//!< One of the GAME_ACTIONS.
+	from_peg,	//!< The peg to jump.
+	to_peg,		//!< The hole to jump it to.
+	go_to,		//!< The move to go to.
+	hint,		//!< Nothing, while a hint is solved, lines sent meanwhile are handled once it is shown.
+	play_again	//!< Whether to play another game.
+};
+
+/**
+ * @brief A single player's connection, and their game.
+ */
+struct game_session {
+	int fd; //!< The player's socket.
+	TriangleGame::board board; //!< The game being played.
+	session_state state; //!< The input being waited for.
+	int from; //!< The peg picked to jump, while waiting for where to.
+	bool closing; //!< True once the session should close, after its output is sent.
+	bool writing; //!< True while waiting for the socket to take more output.
+	std::string in; //!< The input not yet handled, at most one partial line.
+	std::string out; //!< The output not yet sent.
+
+	game_session(int socket, int height)
+		: fd(socket), board(height), state(session_state::start_peg), from(0), closing(false), writing(false)
+	{
+
+	}
+};
+
+/**
+ * @brief Hosts many games at once, each on its own connection, from a single thread.
+ *
+ * Every socket is non-blocking, and watched by a single epoll loop. Each session keeps
+ * its board, the input it is waiting for, and the bytes it has not yet handled or sent,
+ * so a session that is waiting costs nothing but its memory. Players send one line at
+ * a time, with the same actions as GAME_ACTIONS, and every response ends with a prompt
+ * ending in SERVER_PROMPT_END. A jump can be given on one line, "J 4 1", or over three.
+ *
+ * Hints are solved by a hint_service, on its own thread, one position at a time in the
+ * order they were asked for, so a slow hint never holds up the other sessions. The
+ * service wakes the loop through an eventfd when a position is solved, and the hint is
+ * then shown to every session waiting for it.
+ */
+class game_server {
+	public:
+		/**
+		 * @brief Construct a new server for games of the given height.
+		 *
+		 * @param height The height of every board.
+		 * @param latencies The latencies to record the phases of each turn to, or nullptr to not time them.
+		 * @param hintMemory The most memory the hint solver can use, in bytes, 0 for no limit.
+		 */
+		game_server(int height, turn_latencies* latencies = nullptr, std::size_t hintMemory = SERVER_HINT_MEMORY)
+			: _height(height), _latencies(latencies), _listen_fd(-1), _epoll_fd(-1), _wake_fd(-1), _sessions_served(0), _peak_sessions(0), _turns(0), _base_bytes(0), _peak_bytes(0)
+		{
+			if (TriangleGame::jump_table::supports(height)) {
+				_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+				_table = std::make_unique<TriangleGame::jump_table>(height);
+				_hints = std::make_unique<TriangleGame::hint_service>(*_table);
+				_hints->set_memory_limit(hintMemory);
+				_hints->set_hint_listener([this](TriangleGame::t_state state, const TriangleGame::hint& h) {
+					{
+						std::lock_guard<std::mutex> lock(_solved_mutex);
+						_solved.emplace_back(state, h);
+					}
+					std::uint64_t one = 1;
+					if (write(_wake_fd, &one, sizeof(one)) < 0) return;
+				});
+			}
+		}
+
+		/**
+		 * @brief Destroy the server, closing every session.
+		 */
+		~game_server() {
+			//the hint thread is stopped first, so it never wakes a closed loop
+			_hints.reset();
+			if (_wake_fd >= 0) close(_wake_fd);
+			for (auto& kv : _sessions)
+				close(kv.first);
+			if (_listen_fd >= 0) close(_listen_fd);
+			if (_epoll_fd >= 0) close(_epoll_fd);
+			if (!_unix_path.empty()) unlink(_unix_path.c_str());
+		}
+
+		/**
+		 * @brief Starts listening for players.
+		 *
+		 * @param address A port number, for TCP on 127.0.0.1, or the path of a Unix socket.
+		 * @return true If the server is listening.
+		 * @return false If the address is not valid, or could not be bound.
+		 */
+		bool listen_on(const std::string& address) {
+			sockaddr_storage addr;
+			socklen_t length;
+			if (!resolve_address(address, addr, length)) return false;
+
+			_listen_fd = socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+			if (_listen_fd < 0) return false;
+
+			int on = 1;
+			setsockopt(_listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+			if (addr.ss_family == AF_UNIX) {
+				unlink(address.c_str());
+				_unix_path = address;
+			}
+
+			if (bind(_listen_fd, (sockaddr*)&addr, length) != 0 || listen(_listen_fd, SOMAXCONN) != 0)
+				return false;
+
+			_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+			if (_epoll_fd < 0) return false;
+
+			epoll_event ev{};
+			ev.events = EPOLLIN;
+			ev.data.ptr = nullptr;
+			if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _listen_fd, &ev) != 0)
+				return false;
+
+			if (!_hints) return true;
+			if (_wake_fd < 0) return false;
+			ev.data.ptr = &_wake_fd;
+			return epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd, &ev) == 0;
+		}
+
+		/**
+		 * @brief Serves players until the stop flag is set.
+		 *
+		 * @param stop The flag to check, at least every 200 milliseconds.
+		 */
+		void run(const std::atomic<bool>& stop) {
+			_base_bytes = resident_bytes();
+			epoll_event events[SERVER_MAX_EVENTS];
+
+			while (!stop.load()) {
+				if (_latencies != nullptr && latency_dump_requested.exchange(false))
+					std::cerr << _latencies->to_string();
+
+				int n = epoll_wait(_epoll_fd, events, SERVER_MAX_EVENTS, 200);
+				bool woken = false;
+				for (int i = 0; i < n; i++) {
+					if (events[i].data.ptr == &_wake_fd) {
+						woken = true;
+						continue;
+					}
+
+					auto* session = (game_session*)events[i].data.ptr;
+					if (session == nullptr) {
+						_accept();
+						continue;
+					}
+
+					if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+						_read(*session);
+					if (events[i].events & EPOLLOUT)
+						_flush(*session);
+					if (session->closing && session->out.empty())
+						_close(*session);
+				}
+
+				//hints are shown after the batch, as showing one can close a session a later event still points to
+				if (woken)
+					_show_hints();
+			}
+		}
+
+		/**
+		 * @brief Creates a summary of the sessions served.
+		 *
+		 * @return std::string The summary.
+		 */
+		std::string get_stats() const {
+			std::stringstream ss;
+			ss << "Sessions Served: " << _sessions_served << ", Peak Open Sessions: " << _peak_sessions << ", Turns: " << _turns << std::endl;
+
+			//the loop is a single thread, so its CPU time is one core's worth of turns
+			rusage usage;
+			if (getrusage(RUSAGE_SELF, &usage) == 0) {
+				double cpu = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+				ss << "CPU Seconds: " << cpu << ", Turns per CPU Second: " << (cpu > 0 ? _turns / cpu : 0) << std::endl;
+			}
+			if (_peak_sessions > 0 && _peak_bytes > _base_bytes)
+				ss << "Memory at the Peak: " << ((_peak_bytes - _base_bytes) >> 10) << " KiB more than when idle, about "
+					<< (_peak_bytes - _base_bytes) / _peak_sessions << " bytes per session" << std::endl;
+			return ss.str();
+		}
+
+	private:
+		int _height; //!< The height of every board.
+		turn_latencies* _latencies; //!< The latencies of each phase of a turn, or nullptr.
+		int _listen_fd; //!< The socket players connect to.
+		int _epoll_fd; //!< Watches the listening socket, the hint thread, and every session.
+		int _wake_fd; //!< The eventfd the hint thread wakes the loop with, when hints are avaliable.
+		std::string _unix_path; //!< The Unix socket to remove when the server stops, if there is one.
+		std::unordered_map<int, std::unique_ptr<game_session> > _sessions; //!< The open sessions, by socket.
+		std::unique_ptr<TriangleGame::jump_table> _table; //!< The jumps of the board, when hints are avaliable.
+		std::unordered_map<TriangleGame::t_state, std::vector<game_session*> > _hint_waiting; //!< The sessions waiting for each position's hint.
+		std::deque<TriangleGame::t_state> _hint_queue; //!< The positions to solve, in the order they were asked for, the first is being solved.
+		std::mutex _solved_mutex; //!< Guards _solved.
+		std::vector<std::pair<TriangleGame::t_state, TriangleGame::hint> > _solved; //!< The hints solved by the hint thread, not yet shown.
+		std::unique_ptr<TriangleGame::hint_service> _hints; //!< Solves hints on its own thread, its table is shared by every session.
+		std::uint64_t _sessions_served; //!< The number of sessions opened.
+		std::size_t _peak_sessions; //!< The most sessions open at once.
+		std::uint64_t _turns; //!< The number of lines handled.
+		std::size_t _base_bytes; //!< The memory used before any session was opened.
+		std::size_t _peak_bytes; //!< The memory used when the most sessions were open.
+
+		/**
+		 * @brief Opens a session for every waiting connection.
+		 */
+		void _accept() {
+			while (true) {
+				int fd = accept4(_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+				if (fd < 0) return;
+
+				auto session = std::make_unique<game_session>(fd, _height);
+				epoll_event ev{};
+				ev.events = EPOLLIN;
+				ev.data.ptr = session.get();
+				if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+					close(fd);
+					continue;
+				}
+
+				auto& s = *session;
+				_sessions.emplace(fd, std::move(session));
+				_sessions_served++;
+
+				//memory is only sampled every so often, as reading it is slow
+				if (_sessions.size() > _peak_sessions) {
+					_peak_sessions = _sessions.size();
+					if ((_peak_sessions & 0xFF) == 0)
+						_peak_bytes = resident_bytes();
+				}
+
+				s.out += "Welcome to the Triangle Game, height " + std::to_string(_height) + "\n";
+				_show_board(s);
+				_prompt_start(s);
+				_flush(s);
+			}
+		}
+
+		/**
+		 * @brief Reads what the player sent, and handles each whole line.
+		 */
+		void _read(game_session& s) {
+			char buffer[SERVER_READ_BYTES];
+			while (!s.closing) {
+				ssize_t n = recv(s.fd, buffer, sizeof(buffer), 0);
+				if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+					s.closing = true;
+					s.out.clear();
+					return;
+				}
+				if (n < 0) break;
+
+				s.in.append(buffer, (std::size_t)n);
+				_handle_lines(s);
+
+				//lines sent while a hint is solved are held, up to the same limit as a partial line
+				if (s.in.size() > SERVER_MAX_LINE) {
+					s.closing = true;
+					s.out.clear();
+					return;
+				}
+			}
+
+			_flush(s);
+		}
+
+		/**
+		 * @brief Handles each whole line the player has sent, until the session waits for a hint.
+		 */
+		void _handle_lines(game_session& s) {
+			std::size_t start = 0, end;
+			while (!s.closing && s.state != session_state::hint && (end = s.in.find('\n', start)) != std::string::npos) {
+				std::string line = s.in.substr(start, end - start);
+				if (!line.empty() && line.back() == '\r') line.pop_back();
+				start = end + 1;
+
+				_turns++;
+				_handle(s, line);
+			}
+			s.in.erase(0, start);
+		}
+
+		/**
+		 * @brief Sends as much output as the socket takes, and waits for it to take the rest.
+		 */
+		void _flush(game_session& s) {
+			std::size_t sent = 0;
+			while (sent < s.out.size()) {
+				ssize_t n = send(s.fd, s.out.data() + sent, s.out.size() - sent, MSG_NOSIGNAL);
+				if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+				if (n <= 0) {
+					s.closing = true;
+					s.out.clear();
+					return;
+				}
+				sent += (std::size_t)n;
+			}
+			s.out.erase(0, sent);
+
+			bool writing = !s.out.empty();
+			if (writing != s.writing) {
+				epoll_event ev{};
+				ev.events = writing ? EPOLLIN | EPOLLOUT : EPOLLIN;
+				ev.data.ptr = &s;
+				epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, s.fd, &ev);
+				s.writing = writing;
+			}
+		}
+
+		/**
+		 * @brief Closes a session, and frees its game.
+		 */
+		void _close(game_session& s) {
+			if (s.state == session_state::hint) {
+				auto it = _hint_waiting.find(_table->get_state(s.board));
+				if (it != _hint_waiting.end()) {
+					std::erase(it->second, &s);
+					if (it->second.empty()) _hint_waiting.erase(it);
+				}
+			}
+
+			int fd = s.fd;
+			epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+			close(fd);
+			_sessions.erase(fd);
+		}
+
+		/**
+		 * @brief Handles a line the player sent, for the input the session is waiting for.
+		 */
+		void _handle(game_session& s, const std::string& line) {
+			std::stringstream ss(line);
+			int number = 0;
+
+			switch (s.state) {
+				case session_state::start_peg:
+					if (ss >> number && s.board.remove_inital_peg(number)) {
+						_show_turn(s);
+					} else {
+						s.out += "Invalid Peg\n";
+						_prompt_start(s);
+					}
+					return;
+
+				case session_state::from_peg:
+					if (ss >> number && !get_open_pegs_from(number, _all_moves(s)).empty()) {
+						s.from = number;
+						s.state = session_state::to_peg;
+						s.out += "Move To " + util::vector_to_str(get_open_pegs_from(number, _all_moves(s))) + " " + SERVER_PROMPT_END;
+					} else {
+						s.out += "Invalid Peg\n";
+						_prompt_action(s);
+					}
+					return;
+
+				case session_state::to_peg:
+					if (!(ss >> number) || !_move_peg(s, s.from, number))
+						s.out += "Invalid Move\n";
+					_show_turn(s);
+					return;
+
+				case session_state::go_to:
+					if (ss >> number && number >= 0 && number <= s.board.get_last_ply() && _seek(s, number)) {
+						_after_undo(s);
+					} else {
+						s.out += "Invalid Move Number\n";
+						_prompt_action(s);
+					}
+					return;
+
+				case session_state::play_again: {
+					char answer = 0;
+					ss >> answer;
+					if (std::toupper(answer) == 'Y') {
+						s.board = TriangleGame::board(_height);
+						_show_board(s);
+						_prompt_start(s);
+					} else {
+						s.out += "Goodbye\n";
+						s.closing = true;
+					}
+					return;
+				}
+
+				case session_state::action:
+				case session_state::hint:
+					break;
+			}
+
+			char action = 0;
+			ss >> action;
+			action = (char)std::toupper(action);
+
+			if (action == 'J') { //Jump Peg, the pegs can be given on the same line
+				int to;
+				if (ss >> number) {
+					if (!(ss >> to) || !_move_peg(s, number, to))
+						s.out += "Invalid Move\n";
+					_show_turn(s);
+				} else {
+					auto moves = _all_moves(s);
+					s.state = session_state::from_peg;
+					s.out += "Select a Peg to Move " + util::vector_to_str(merge_lists(moves)) + " " + SERVER_PROMPT_END;
+				}
+
+			} else if (action == 'U') { //Undo Previous Move
+				{
+					phase_timer timer(_latencies, turn_phase::history);
+					s.board.go_back();
+				}
+				_after_undo(s);
+
+			} else if (action == 'R') { //Redo Undone Move
+				bool redone;
+				{
+					phase_timer timer(_latencies, turn_phase::history);
+					redone = s.board.go_forward();
+				}
+				if (!redone)
+					s.out += "No Moves to Redo\n";
+				_show_turn(s);
+
+			} else if (action == 'G') { //Go to Move, the move can be given on the same line
+				if (ss >> number) {
+					s.state = session_state::go_to;
+					_handle(s, std::to_string(number));
+				} else {
+					phase_timer timer(_latencies, turn_phase::history);
+					s.state = session_state::go_to;
+					s.out += "-------- Move History --------\n" + s.board.get_move_history().to_string()
+						+ "Go to Move (0-" + std::to_string(s.board.get_last_ply()) + ") " + SERVER_PROMPT_END;
+				}
+
+			} else if (action == 'V') { //View History
+				{
+					phase_timer timer(_latencies, turn_phase::history);
+					s.out += "-------- Move History --------\n" + s.board.get_move_history().to_string();
+				}
+				_prompt_action(s);
+
+			} else if (action == 'H') { //Hint, shown once it is solved
+				_hint(s);
+
+			} else if (action == 'S') { //Save Game, as its record, as there is no file to save to
+				s.out += "Record: " + TriangleGame::game_record(_height, s.board.get_move_history()).to_string() + "\n";
+				_prompt_action(s);
+
+			} else if (action == 'Q') { //Quit Game
+				s.out += "Quitting Game\n";
+				s.closing = true;
+
+			} else {
+				s.out += "Invalid Action\n";
+				_prompt_action(s);
+			}
+		}
+
+		/**
+		 * @brief Shows the board after going back, asking for the first peg again if the inital move was undone.
+		 */
+		void _after_undo(game_session& s) {
+			if (s.board.get_move_history().size() == 0) {
+				_show_board(s);
+				_prompt_start(s);
+			} else {
+				_show_turn(s);
+			}
+		}
+
+		/**
+		 * @brief Shows the board and moves, and asks for an action, or shows the results when no moves are left.
+		 */
+		void _show_turn(game_session& s) {
+			_show_board(s);
+
+			auto moves = _all_moves(s);
+			if (moves.empty()) {
+				int left = s.board.get_total_pegs() - s.board.get_total_removed_pegs();
+				s.out += "Total Pegs Left: " + std::to_string(left) + "\n" + get_game_result(left) + "\n";
+				s.out += "Record: " + TriangleGame::game_record(_height, s.board.get_move_history()).to_string() + "\n";
+				s.state = session_state::play_again;
+				s.out += "Do You want to Play Again? (Y/N) " + SERVER_PROMPT_END;
+				return;
+			}
+
+			//the moves in compact notation, so a client can pick one without parsing the board
+			phase_timer timer(_latencies, turn_phase::render);
+			s.out += "Moves: ";
+			bool first = true;
+			for (const auto& kv : moves) {
+				for (int from : kv.second) {
+					if (!first) s.out += ',';
+					s.out += std::to_string(from) + "-" + std::to_string(kv.first);
+					first = false;
+				}
+			}
+			s.out += "\n";
+			_prompt_action(s);
+		}
+
+		/**
+		 * @brief Writes the board to the session's output.
+		 */
+		void _show_board(game_session& s) {
+			phase_timer timer(_latencies, turn_phase::render);
+			s.out += s.board.to_string() + "\n";
+		}
+
+		/**
+		 * @brief Returns the moves left in the session's game, timing the search.
+		 */
+		TriangleGame::t_open_moves _all_moves(game_session& s) {
+			phase_timer timer(_latencies, turn_phase::get_all_moves);
+			return s.board.get_all_moves();
+		}
+
+		/**
+		 * @brief Makes a jump in the session's game, timing it.
+		 */
+		bool _move_peg(game_session& s, int from, int to) {
+			phase_timer timer(_latencies, turn_phase::move_peg);
+			return s.board.move_peg(from, to);
+		}
+
+		/**
+		 * @brief Goes to a move of the session's game, timing it.
+		 */
+		bool _seek(game_session& s, int ply) {
+			phase_timer timer(_latencies, turn_phase::history);
+			return s.board.seek(ply);
+		}
+
+		/**
+		 * @brief Asks for the first peg to remove.
+		 */
+		void _prompt_start(game_session& s) {
+			s.state = session_state::start_peg;
+			s.out += "Enter First Peg to Remove (1-" + std::to_string(s.board.get_total_pegs()) + ") " + SERVER_PROMPT_END;
+		}
+
+		/**
+		 * @brief Asks for an action.
+		 */
+		void _prompt_action(game_session& s) {
+			s.state = session_state::action;
+			s.out += GAME_ACTIONS_QUESTION + " " + SERVER_PROMPT_END;
+		}
+
+		/**
+		 * @brief Asks for the jump that leads to the fewest pegs left, which is shown, with the
+		 * prompt, straight away when the position has been solved, or once it is.
+		 */
+		void _hint(game_session& s) {
+			if (!_hints) {
+				s.out += "Hints are not avaliable for boards taller than " + std::to_string(TriangleGame::MAX_STATE_HEIGHT) + "\n";
+				_prompt_action(s);
+				return;
+			}
+
+			auto state = _table->get_state(s.board);
+			if (_hints->is_ready(state)) {
+				_write_hint(s, _hints->get_hint(state));
+				_prompt_action(s);
+				return;
+			}
+
+			s.state = session_state::hint;
+			auto& waiting = _hint_waiting[state];
+			waiting.push_back(&s);
+			if (waiting.size() > 1) return;
+
+			_hint_queue.push_back(state);
+			if (_hint_queue.size() == 1) _next_hint();
+		}
+
+		/**
+		 * @brief Starts solving the next position in the queue that a session is still waiting for.
+		 */
+		void _next_hint() {
+			while (!_hint_queue.empty()) {
+				auto state = _hint_queue.front();
+				if (_hint_waiting.count(state) == 0) {
+					_hint_queue.pop_front();
+				} else if (_hints->is_ready(state)) {
+					_hint_queue.pop_front();
+					_answer_hint(state, _hints->get_hint(state));
+				} else {
+					_hints->warm(state);
+					return;
+				}
+			}
+		}
+
+		/**
+		 * @brief Shows the hints the hint thread has solved, and starts on the next position.
+		 */
+		void _show_hints() {
+			std::uint64_t count;
+			if (read(_wake_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) return;
+
+			std::vector<std::pair<TriangleGame::t_state, TriangleGame::hint> > solved;
+			{
+				std::lock_guard<std::mutex> lock(_solved_mutex);
+				solved.swap(_solved);
+			}
+
+			for (const auto& kv : solved) {
+				if (!_hint_queue.empty() && _hint_queue.front() == kv.first)
+					_hint_queue.pop_front();
+				_answer_hint(kv.first, kv.second);
+			}
+			_next_hint();
+		}
+
+		/**
+		 * @brief Shows a hint to every session waiting for it, then handles the lines they sent meanwhile.
+		 */
+		void _answer_hint(TriangleGame::t_state state, const TriangleGame::hint& h) {
+			auto it = _hint_waiting.find(state);
+			if (it == _hint_waiting.end()) return;
+			auto sessions = std::move(it->second);
+			_hint_waiting.erase(it);
+
+			for (auto* s : sessions) {
+				_write_hint(*s, h);
+				_prompt_action(*s);
+				_handle_lines(*s);
+				_flush(*s);
+				if (s->closing && s->out.empty())
+					_close(*s);
+			}
+		}
+
+		/**
+		 * @brief Writes a hint to the session's output.
+		 */
+		void _write_hint(game_session& s, const TriangleGame::hint& h) {
+			if (!h.has_jump) {
+				s.out += "No Moves Left\n";
+				return;
+			}
+
+			s.out += "Hint: Jump peg [" + std::to_string(h.from) + "] to [" + std::to_string(h.to) + "], "
+				+ "the best you can finish with is " + std::to_string(h.pegs_left) + " peg" + (h.pegs_left == 1 ? "" : "s") + " left\n";
+		}
+};
+
+/**
+ * @brief Hosts games for players connecting to the given address, until Ctrl+C or a SIGTERM.
+ *
+ * @param height The height of every board.
+ * @param address A port number, for TCP on 127.0.0.1, or the path of a Unix socket.
+ * @param latency True to time the phases of each turn, and show their percentiles when the server stops.
+ * @param memoryLimitMB The most megabytes the hint solver can use, 0 for SERVER_HINT_MEMORY.
+ * @return int The program exit code.
+ */
+int run_server(int height, const std::string& address, bool latency, unsigned memoryLimitMB) {
+	raise_file_limit();
+
+	//the engine's work in each turn, shown when the server stops, or on a SIGUSR1
+	auto latencies = turn_latencies();
+	auto server = game_server(height, latency ? &latencies : nullptr, memoryLimitMB > 0 ? (std::size_t)memoryLimitMB << 20 : SERVER_HINT_MEMORY);
+	if (!server.listen_on(address)) {
+		std::cerr << "Error: unable to listen on " << address << ": " << std::strerror(errno) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::signal(SIGINT, stop_server);
+	std::signal(SIGTERM, stop_server);
+	if (latency) std::signal(SIGUSR1, request_latency_dump);
+	std::cout << "Serving games of height " << height << " on " << address << ", stop with Ctrl+C" << std::endl;
+
+	server.run(server_stop_requested);
+
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+	std::signal(SIGUSR1, SIG_DFL);
+	std::cout << server.get_stats();
+	if (latency) std::cout << latencies.to_string();
+	return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,587 @@
+#pragma once
+#ifndef __H_TRI_GAME_SOLVE__
+#define __H_TRI_GAME_SOLVE__
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <topology.h>
+#include <jump_table.h>
+#include <solver.h>
+#include <census.h>
+#include <bidirectional_solver.h>
+#include <distributed_solver.h>
+#include <chain_solver.h>
+#include <goal_grid.h>
+#include <solution_stream.h>
+#include <position_evaluator.h>
+#include <board.h>
+
+#include "playouts.h"
+#include "records.h"
+
+static std::atomic<bool> solve_stop_requested(false);
+
+const std::size_t BIDIRECTIONAL_MEMORY = (std::size_t)256 << 20; //!< The most memory the bidirectional search for a single peg can use, when no limit is given.
+
+/**
+ * @brief Asks the running solve to stop, so it can write its checkpoint first.
+ */
+void stop_solve(int) {
+	solve_stop_requested.store(true);
+}
+
+/**
+ * @brief Prints the most memory a search used, and each step it was degraded by to stay in its limit.
+ *
+ * @param peak The peak memory, in bytes.
+ * @param events The steps the search was degraded by.
+ * @param out The stream to print to.
+ */
+void print_memory(std::size_t peak, const std::vector<std::string>& events, std::ostream& out = std::cout) {
+	out << "Peak Memory: " << (peak >> 10) << " KiB";
+	if (!events.empty())
+		out << ", Degraded " << events.size() << " times to stay in the limit";
+	out << std::endl;
+
+	for (const auto& e : events)
+		out << "  " << e << std::endl;
+}
+
+/**
+ * @brief Reads the target position of a solve, from a comma separated list of pegs.
+ *
+ * @param goal The pegs, such as "13" or "1,4,6", or empty for no target.
+ * @param geometry The board.
+ * @param target The returned position, 0 for no target.
+ * @return true If every peg is on the board.
+ * @return false Otherwise, after showing an error.
+ */
+bool parse_goal(const std::string& goal, const TriangleGame::topology& geometry, TriangleGame::t_state& target) {
+	target = 0;
+	std::stringstream ss(goal);
+	std::string item;
+	while (std::getline(ss, item, ',')) {
+		int peg = std::atoi(item.c_str());
+		if (peg < 1 || peg > geometry.get_hole_count()) {
+			std::cerr << "Error: goal peg " << item << " is not on the " << geometry.get_name() << " board, which has " << geometry.get_hole_count() << " holes" << std::endl;
+			return false;
+		}
+		target |= TriangleGame::t_state(1) << (peg - 1);
+	}
+	return true;
+}
+
+/**
+ * @brief Solves the starting position, finding the fewest pegs that can be left.
+ * Ctrl+C, or a SIGTERM, stops the solve after writing its checkpoint.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole, not used when resuming.
+ * @param checkpointPath The checkpoint file, or empty. Defaults to resumePath when resuming.
+ * @param checkpointSeconds The time between checkpoints.
+ * @param progressSeconds The time between progress lines on std::cerr, 0 for none.
+ * @param resumePath The checkpoint to continue from, or empty.
+ * @param reduction True to skip the orders of commuting jumps that are searched elsewhere.
+ * @param memoryLimitMB The most memory the solver's tables can use, in megabytes, 0 for no limit.
+ * @return int The program exit code.
+ */
+int run_solve(const TriangleGame::topology& geometry, int startPeg, std::string checkpointPath,
+	double checkpointSeconds, double progressSeconds, const std::string& resumePath, bool reduction, unsigned memoryLimitMB) {
+
+	if (!validate_solver_args(geometry, startPeg))
+		return EXIT_FAILURE;
+
+	auto table = TriangleGame::jump_table(geometry);
+	auto solver = TriangleGame::solver(table);
+	solver.set_reduction(reduction);
+	solver.set_memory_limit((std::size_t)memoryLimitMB << 20);
+	TriangleGame::t_state root = table.get_start_state(startPeg);
+
+	if (!resumePath.empty()) {
+		if (!solver.load_checkpoint(resumePath, root)) {
+			std::cerr << "Error: unable to resume from " << resumePath << ", it is not a checkpoint for this board" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::cout << "Resuming from " << resumePath << ": " << solver.get_nodes() << " nodes, "
+			<< solver.get_table_size() << " positions stored" << std::endl;
+
+		if (checkpointPath.empty())
+			checkpointPath = resumePath;
+	}
+
+	solver.set_checkpoint(checkpointPath, checkpointSeconds);
+	solver.set_progress(&std::cerr, progressSeconds);
+	solver.set_stop_flag(&solve_stop_requested);
+	std::signal(SIGINT, stop_solve);
+	std::signal(SIGTERM, stop_solve);
+
+	std::cout << "Solving the " << geometry.get_name() << " board, " << TriangleGame::jump_table::count_pegs(root) << " pegs" << std::endl;
+	int best = solver.solve(root);
+
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	if (best == TriangleGame::UNSOLVED) {
+		std::cout << "Stopped after " << solver.get_nodes() << " nodes";
+		if (!checkpointPath.empty())
+			std::cout << ", continue with --resume " << checkpointPath;
+		std::cout << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "The fewest pegs that can be left is " << best << std::endl;
+	std::cout << "Nodes: " << solver.get_nodes() << ", Positions Stored: " << solver.get_table_size()
+		<< ", Seconds: " << solver.get_seconds() << std::endl;
+	std::cout << "Table Lookups: " << solver.get_probes() << ", Commuting Jumps Skipped: " << solver.get_pruned() << std::endl;
+	print_memory(solver.get_peak_memory(), solver.get_memory_events());
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Finds a sequence of jumps from the starting peg that leaves a single peg, searching
+ * forwards from the start and backwards from the one peg positions until they meet.
+ * Ctrl+C, or a SIGTERM, stops the search. Without a goal, if the levels do not fit the
+ * memory limit, or BIDIRECTIONAL_MEMORY without one, the sequence is found by the depth
+ * first solver instead, under the limit given. A goal has nothing to fall back to, so
+ * it is only limited when a limit is given.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole.
+ * @param triangle True when the board is the triangle, whose moves are replayed on a board.
+ * @param memoryLimitMB The most memory the search can use, in megabytes, 0 for BIDIRECTIONAL_MEMORY without a goal, or no limit with one.
+ * @param goal The comma separated pegs to finish with, or empty for a single peg in any hole.
+ * @return int The program exit code.
+ */
+int run_bidirectional_solve(const TriangleGame::topology& geometry, int startPeg, bool triangle, unsigned memoryLimitMB, const std::string& goal) {
+	if (!validate_solver_args(geometry, startPeg))
+		return EXIT_FAILURE;
+
+	auto table = TriangleGame::jump_table(geometry);
+	TriangleGame::t_state target;
+	if (!parse_goal(goal, geometry, target))
+		return EXIT_FAILURE;
+
+	auto solver = TriangleGame::bidirectional_solver(table);
+	solver.set_target(target);
+	solver.set_stop_flag(&solve_stop_requested);
+	solver.set_memory_limit(memoryLimitMB > 0 ? (std::size_t)memoryLimitMB << 20 : target == 0 ? BIDIRECTIONAL_MEMORY : 0);
+	std::signal(SIGINT, stop_solve);
+	std::signal(SIGTERM, stop_solve);
+
+	std::cout << "Solving the " << geometry.get_name() << " board from both ends, starting peg " << startPeg;
+	if (target != 0) std::cout << ", finishing with pegs " << goal;
+	std::cout << std::endl;
+	auto root = table.get_start_state(startPeg);
+	auto jumps = std::vector<TriangleGame::t_jump_id>();
+	bool solved = solver.solve(root, jumps);
+
+	if (solver.get_rejection() != TriangleGame::goal_check::possible) {
+		std::cout << "The target can never be reached, the start has " << TriangleGame::goal_filter::describe(solver.get_rejection()) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Nodes: " << solver.get_nodes() << ", Positions Stored: " << solver.get_stored() << std::endl;
+	print_memory(solver.get_peak_memory(), {});
+
+	//the levels cannot be given up, so fall back to the search that can give up its table, which only finds a single peg in any hole
+	if (solver.was_out_of_memory() && target == 0) {
+		std::cout << "The searches ran out of memory before they met, searching depth first instead" << std::endl;
+
+		auto fallback = TriangleGame::solver(table);
+		fallback.set_stop_flag(&solve_stop_requested);
+		fallback.set_memory_limit((std::size_t)memoryLimitMB << 20);
+
+		//the first jump that still leaves a single peg is followed, its position is usually in the table already
+		solved = fallback.solve(root) == 1;
+		TriangleGame::t_jump_id legal[TriangleGame::MAX_JUMPS];
+		for (auto s = root; solved && TriangleGame::jump_table::count_pegs(s) > 1; ) {
+			int n = table.get_legal_jumps(s, legal);
+			int i = 0;
+			while (i < n && fallback.solve(s ^ table.get_jumps()[legal[i]].flip) != 1)
+				i++;
+			if (i == n) {
+				solved = false;
+				break;
+			}
+			jumps.push_back(legal[i]);
+			s ^= table.get_jumps()[legal[i]].flip;
+		}
+
+		std::cout << "Nodes: " << fallback.get_nodes() << ", Positions Stored: " << fallback.get_table_size() << std::endl;
+		print_memory(fallback.get_peak_memory(), fallback.get_memory_events());
+	}
+
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	if (!solved) {
+		if (solve_stop_requested.load())
+			std::cout << "Stopped before the searches met" << std::endl;
+		else
+			std::cout << (solver.was_out_of_memory() ? "The searches ran out of memory before they met" : target != 0 ? "No sequence of jumps reaches the target" : "No sequence of jumps leaves a single peg") << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//the triangle is replayed on a board, which checks every jump
+	if (triangle) {
+		auto board = TriangleGame::board(table.get_height());
+		board.remove_inital_peg(startPeg);
+		for (auto id : jumps) {
+			const auto& j = table.get_jumps()[id];
+			if (!board.move_peg(j.from + 1, j.to + 1)) {
+				std::cerr << "Error: the solution jumps peg [" << j.from + 1 << "] to [" << j.to + 1 << "], which is not a valid move" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		std::cout << "-------- Solution --------" << std::endl << board.get_move_history() << std::endl;
+		std::cout << board << std::endl;
+	} else {
+		std::cout << "-------- Solution --------" << std::endl;
+		for (std::size_t i = 0; i < jumps.size(); i++) {
+			const auto& j = table.get_jumps()[jumps[i]];
+			std::cout << (i + 1) << ": Jump peg [" << j.from + 1 << "] to [" << j.to + 1 << "]" << std::endl;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Shows, for every starting hole and every finishing hole, whether a game can start
+ * from the one and finish with its last peg in the other.
+ *
+ * @param geometry The board.
+ * @param threads The number of threads, 0 uses every core.
+ * @return int The program exit code.
+ */
+int run_goal_grid(const TriangleGame::topology& geometry, unsigned threads) {
+	if (!validate_solver_args(geometry, 1))
+		return EXIT_FAILURE;
+
+	auto table = TriangleGame::jump_table(geometry);
+	auto grid = TriangleGame::goal_grid(table);
+
+	std::cout << "Finding every solvable start and finish on the " << geometry.get_name() << " board" << std::endl << std::endl;
+	grid.run(threads);
+	std::cout << grid << std::endl;
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Finds a single peg finish in the fewest moves, where jumps in a row by the same
+ * peg are one move, and shows it a move at a time.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole.
+ * @param triangle True when the board is the triangle, which is replayed on a board to check every jump.
+ * @param memoryLimitMB The most megabytes the transposition table can use, 0 for no limit.
+ * @return int The program exit code.
+ */
+int run_chain_solve(const TriangleGame::topology& geometry, int startPeg, bool triangle, unsigned memoryLimitMB) {
+	if (!validate_solver_args(geometry, startPeg))
+		return EXIT_FAILURE;
+
+	auto table = TriangleGame::jump_table(geometry);
+	auto solver = TriangleGame::chain_solver(table);
+	solver.set_stop_flag(&solve_stop_requested);
+	solver.set_memory_limit((std::size_t)memoryLimitMB << 20);
+	std::signal(SIGINT, stop_solve);
+	std::signal(SIGTERM, stop_solve);
+
+	std::cout << "Finding the fewest moves on the " << geometry.get_name() << " board, starting peg " << startPeg << std::endl;
+	auto started = std::chrono::steady_clock::now();
+	auto chains = std::vector<TriangleGame::t_chain>();
+	bool solved = solver.solve(table.get_start_state(startPeg), chains);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	std::cout << "Bounds Searched:";
+	for (auto bound : solver.get_bounds()) std::cout << " " << bound;
+	std::cout << std::endl;
+	std::cout << "Nodes: " << solver.get_nodes() << ", Positions Stored: " << solver.get_table_size() << ", Seconds: " << seconds << std::endl;
+	print_memory(solver.get_peak_memory(), solver.get_memory_events());
+
+	if (!solved) {
+		if (solver.was_stopped())
+			std::cout << "Stopped before a finish was found" << std::endl;
+		else
+			std::cout << "No sequence of jumps leaves a single peg" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::size_t jumpCount = 0;
+	std::cout << "-------- Solution: " << chains.size() << " Moves --------" << std::endl;
+	for (std::size_t i = 0; i < chains.size(); i++) {
+		const auto& first = table.get_jumps()[chains[i].front()];
+		std::cout << (i + 1) << ": Peg [" << first.from + 1 << "]";
+		for (auto id : chains[i])
+			std::cout << " to [" << table.get_jumps()[id].to + 1 << "]";
+		std::cout << std::endl;
+		jumpCount += chains[i].size();
+	}
+	std::cout << "Jumps: " << jumpCount << std::endl;
+
+	//the triangle is replayed on a board, which checks every jump
+	if (triangle) {
+		auto board = TriangleGame::board(table.get_height());
+		board.remove_inital_peg(startPeg);
+		for (const auto& chain : chains) {
+			for (auto id : chain) {
+				const auto& j = table.get_jumps()[id];
+				if (!board.move_peg(j.from + 1, j.to + 1)) {
+					std::cerr << "Error: the solution jumps peg [" << j.from + 1 << "] to [" << j.to + 1 << "], which is not a valid move" << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+		std::cout << std::endl << board << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Writes every sequence of jumps that leaves a single peg, each as soon as it is found.
+ * The triangle's solutions are written as game records, in the format of the --output archive,
+ * other boards' as a line of text, "start:from-to,from-to,...". The next solution is only looked
+ * for once the last has been handed to the stream, so a slow reader holds the search back.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole.
+ * @param triangle True when the board is the triangle, whose solutions are written as game records.
+ * @param outputPath The file to write, or empty for stdout, where the totals then go to stderr.
+ * @param memoryLimitMB The most megabytes the table of solved positions can use, 0 for no limit.
+ * @return int The program exit code.
+ */
+int run_all_solutions(const TriangleGame::topology& geometry, int startPeg, bool triangle, const std::string& outputPath, unsigned memoryLimitMB) {
+	if (!validate_solver_args(geometry, startPeg))
+		return EXIT_FAILURE;
+
+	auto format = outputPath.empty() ? TriangleGame::record_format::text : record_format_for(outputPath);
+	if (!triangle && format == TriangleGame::record_format::binary) {
+		std::cerr << "Error: only the triangle's solutions can be written as a binary archive" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream file;
+	if (!outputPath.empty()) {
+		file.open(outputPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			std::cerr << "Error: unable to write " << outputPath << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::ostream& out = outputPath.empty() ? std::cout : file;
+	std::ostream& status = outputPath.empty() ? std::cerr : std::cout;
+
+	auto table = TriangleGame::jump_table(geometry);
+	auto stream = TriangleGame::solution_stream(table);
+	stream.set_stop_flag(&solve_stop_requested);
+	stream.set_memory_limit((std::size_t)memoryLimitMB << 20);
+	std::signal(SIGINT, stop_solve);
+	std::signal(SIGTERM, stop_solve);
+
+	status << "Writing every solution on the " << geometry.get_name() << " board, starting peg " << startPeg << std::endl;
+	auto started = std::chrono::steady_clock::now();
+	const auto& jumps = table.get_jumps();
+	bool written = true;
+
+	if (triangle) {
+		auto writer = TriangleGame::record_writer(out, format);
+		auto record = TriangleGame::game_record();
+		for (const auto& solution : stream.solutions(table.get_start_state(startPeg))) {
+			record.reset(table.get_height(), startPeg);
+			for (auto id : solution)
+				record.add_jump(jumps[id].from + 1, jumps[id].to + 1);
+			if (!writer.write(record)) {
+				written = false;
+				break;
+			}
+		}
+		written = writer.finish() && written;
+	} else {
+		for (const auto& solution : stream.solutions(table.get_start_state(startPeg))) {
+			out << startPeg << ":";
+			for (std::size_t i = 0; i < solution.size(); i++)
+				out << (i > 0 ? "," : "") << jumps[solution[i]].from + 1 << "-" << jumps[solution[i]].to + 1;
+			if (!(out << "\n")) {
+				written = false;
+				break;
+			}
+		}
+		written = (bool)out.flush() && written;
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	status << "Solutions: " << stream.get_count() << ", Positions Walked: " << stream.get_walked()
+		<< ", Dead Ends Skipped: " << stream.get_dead_ends() << ", Positions Solved: " << stream.get_table_size() << std::endl;
+	status << "Seconds: " << seconds << std::endl;
+	print_memory(stream.get_peak_memory(), stream.get_memory_events(), status);
+
+	if (!written) {
+		std::cerr << "Error: unable to write " << (outputPath.empty() ? "to stdout" : outputPath) << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (stream.was_stopped()) {
+		status << "Stopped before every solution was written" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Finds the fewest pegs that can be left from every position of a file, on a pool of
+ * threads sharing their results, and writes a line for each in the order of the file.
+ * Ctrl+C, or a SIGTERM, stops the evaluation, after writing the positions finished in order.
+ *
+ * @param inputPath The file of "height position" lines, with the position in hexadecimal, or - for stdin.
+ * @param outputPath The file to write, or empty for stdout, where the totals then go to stderr.
+ * @param threads The number of threads, 0 uses every core.
+ * @param memoryLimitMB The most memory the solvers can use, in megabytes, 0 for no limit.
+ * @return int The program exit code.
+ */
+int run_evaluate(const std::string& inputPath, const std::string& outputPath, unsigned threads, unsigned memoryLimitMB) {
+	std::ifstream inputFile;
+	if (inputPath != "-") {
+		inputFile.open(inputPath);
+		if (!inputFile) {
+			std::cerr << "Error: unable to read " << inputPath << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::istream& in = inputPath == "-" ? std::cin : inputFile;
+
+	std::ofstream file;
+	if (!outputPath.empty()) {
+		file.open(outputPath, std::ios::trunc);
+		if (!file) {
+			std::cerr << "Error: unable to write " << outputPath << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::ostream& out = outputPath.empty() ? std::cout : file;
+	std::ostream& status = outputPath.empty() ? std::cerr : std::cout;
+
+	auto evaluator = TriangleGame::position_evaluator(TriangleGame::DEFAULT_SHARED_TABLE_BYTES, (std::size_t)memoryLimitMB << 20);
+	evaluator.set_stop_flag(&solve_stop_requested);
+	std::signal(SIGINT, stop_solve);
+	std::signal(SIGTERM, stop_solve);
+
+	status << "Evaluating the positions of " << (inputPath == "-" ? "stdin" : inputPath) << std::endl;
+	bool finished = evaluator.run(in, out, threads);
+
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	status << evaluator;
+	if (evaluator.was_stopped()) {
+		status << "Stopped before every position was evaluated" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (!finished) {
+		std::cerr << "Error: unable to write " << (outputPath.empty() ? "to stdout" : outputPath) << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Finds the fewest pegs that can be left by splitting a search of every position across
+ * worker processes, and shows the counts of each level and the work of each worker.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole.
+ * @param workers The number of worker processes.
+ * @param scaling True to run with 1, 2, 4, ... workers up to the given number, and compare the times.
+ * @return int The program exit code.
+ */
+int run_distributed_solve(const TriangleGame::topology& geometry, int startPeg, unsigned workers, bool scaling) {
+	if (!validate_solver_args(geometry, startPeg))
+		return EXIT_FAILURE;
+	if (workers > TriangleGame::DISTRIBUTED_MAX_WORKERS) {
+		std::cerr << "Error: a solve can be split across at most " << TriangleGame::DISTRIBUTED_MAX_WORKERS << " workers" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	auto counts = std::vector<unsigned>();
+	for (unsigned n = 1; scaling && n < workers; n *= 2) counts.push_back(n);
+	counts.push_back(workers);
+
+	auto table = TriangleGame::jump_table(geometry);
+	auto root = table.get_start_state(startPeg);
+	auto times = std::vector<double>();
+
+	for (auto n : counts) {
+		auto solver = TriangleGame::distributed_solver(table);
+		solver.set_workers(n);
+
+		std::cout << "Solving the " << geometry.get_name() << " board with " << n << " worker processes, starting peg " << startPeg << std::endl << std::endl;
+		std::cout.flush();
+		if (!solver.run(root)) {
+			std::cerr << "Error: a worker process could not be started, or failed" << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::cout << solver << std::endl;
+		times.push_back(solver.get_seconds());
+	}
+
+	if (scaling) {
+		std::cout << "Workers\tSeconds\tSpeedup" << std::endl;
+		for (std::size_t i = 0; i < counts.size(); i++)
+			std::cout << counts[i] << "\t" << times[i] << "\t" << (times[i] > 0 ? times[0] / times[i] : 0) << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Lists every position reachable from the starting peg, and shows the counts of each level.
+ *
+ * @param geometry The board.
+ * @param startPeg The starting peg hole.
+ * @param memoryMB The most memory to hold positions in, in megabytes, past it levels are spilled to disk.
+ * @param workDir The directory to spill to, or empty for the system's temporary directory.
+ * @param exportPath The file to write every position to, or empty.
+ * @return int The program exit code.
+ */
+int run_census(const TriangleGame::topology& geometry, int startPeg, unsigned memoryMB, const std::string& workDir, const std::string& exportPath) {
+	if (!validate_solver_args(geometry, startPeg))
+		return EXIT_FAILURE;
+
+	auto table = TriangleGame::jump_table(geometry);
+	auto census = TriangleGame::census(table);
+	census.set_memory_limit((std::size_t)memoryMB << 20);
+	census.set_work_dir(workDir);
+
+	std::cout << "Listing every position of the " << geometry.get_name() << " board, starting peg " << startPeg << std::endl << std::endl;
+	if (!census.run(table.get_start_state(startPeg))) {
+		std::cerr << "Error: unable to write the census to " << (workDir.empty() ? "the temporary directory" : workDir) << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << census << std::endl;
+
+	if (!exportPath.empty()) {
+		if (!census.export_states(exportPath)) {
+			std::cerr << "Error: unable to export the positions to " << exportPath << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::cout << "Positions Exported to " << exportPath << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+#endif
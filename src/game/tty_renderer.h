@@ -0,0 +1,323 @@
+#pragma once
+#ifndef __H_TRI_GAME_TTY_RENDERER__
+#define __H_TRI_GAME_TTY_RENDERER__
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <util.h>
+#include <board.h>
+#include <bitboard.h>
+#include <hint_service.h>
+
+const int TTY_STATUS_LINES = 8; //!< The lines at the bottom of the terminal for the moves, messages and prompts.
+const int TTY_MOVES_PER_PAGE = 8; //!< The number of moves shown on each page of the move list.
+
+/**
+ * @brief Draws the board once, then only redraws the holes that changed, with ANSI escapes.
+ *
+ * The terminal is split into the board view at the top, and a scrolling region at the
+ * bottom that the messages and prompts are written to, so nothing written there can
+ * scroll the board. Each turn the shown pegs are compared with the board, and only
+ * the holes that differ are redrawn, usually three per jump. Boards larger than the
+ * terminal are shown through a view that moves to follow the last change.
+ *
+ * The moves are shown on a fixed line between the board and the scrolling region, so the
+ * rating of each jump can be filled in from the hint service's thread as it is solved,
+ * while the player is typing. Every write is a single write to the terminal, made while
+ * holding a mutex, and saves and restores the cursor, so it never lands inside the prompt.
+ */
+class tty_renderer {
+	public:
+		/**
+		 * @brief Construct a new renderer for a board of the given height.
+		 *
+		 * @param height The height of the board.
+		 */
+		tty_renderer(int height)
+			: _height(height), _shown(height), _drawn(false), _view_row(0), _view_col(0), _page(0), _active(false), _position(0)
+		{
+			_cell = (int)std::to_string(TriangleGame::peg::FindLastPegNumber(height)).size() + 1;
+			_cell += _cell % 2; //rows are shifted by half a cell
+
+			winsize size;
+			_rows = 24;
+			_cols = 80;
+			if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+				_rows = size.ws_row;
+				_cols = size.ws_col;
+			}
+			_view_rows = std::max(1, std::min(_height, _rows - TTY_STATUS_LINES - 1));
+		}
+
+		/**
+		 * @brief Determinds if the game is being played in a terminal.
+		 *
+		 * @return true If std::cin and std::cout are both terminals.
+		 * @return false Otherwise.
+		 */
+		static bool available() {
+			return isatty(STDIN_FILENO) && isatty(STDOUT_FILENO);
+		}
+
+		/**
+		 * @brief Redraws the whole view on the next draw.
+		 */
+		void invalidate() {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_drawn = false;
+		}
+
+		/**
+		 * @brief Draws the holes that changed since the last draw.
+		 *
+		 * @param board The board to draw.
+		 */
+		void draw(const TriangleGame::board& board) {
+			_flush_game_output();
+			std::lock_guard<std::mutex> lock(_mutex);
+			auto now = board.get_bitboard();
+			std::stringstream out;
+
+			if (!_drawn) {
+				_redraw(now, out);
+			} else {
+				//save the cursor, which is in the status region
+				out << "\x1b" "7";
+
+				const auto* a = _shown.data();
+				const auto* b = now.data();
+				for (std::size_t w = 0; w < now.word_count(); w++) {
+					for (auto diff = a[w] ^ b[w]; diff != 0; diff &= diff - 1) {
+						std::size_t bit = w * 64 + __builtin_ctzll(diff);
+						int row = (int)(bit / now.get_stride());
+						int index = (int)(bit % now.get_stride());
+
+						if (!_visible(row, index)) {
+							_follow(row, index);
+							out.str("");
+							_redraw(now, out);
+							_write(out.str());
+							_shown = now;
+							return;
+						}
+						_draw_cell(now, row, index, out);
+					}
+				}
+
+				out << "\x1b" "8";
+			}
+
+			_write(out.str());
+			_shown = now;
+		}
+
+		/**
+		 * @brief Shows the current page of the avaliable moves, with the ratings known so far.
+		 *
+		 * @param moves The avaliable moves.
+		 * @param position The position the moves are of, which rate is called with.
+		 * @param ratings The jumps rated so far.
+		 */
+		void show_moves(const TriangleGame::t_open_moves& moves, TriangleGame::t_state position, const TriangleGame::t_move_ratings& ratings) {
+			_flush_game_output();
+			std::lock_guard<std::mutex> lock(_mutex);
+			_moves = moves;
+			_position = position;
+			_active = true;
+			_ratings.clear();
+			for (const auto& r : ratings)
+				_ratings[{ r.from, r.to }] = r.pegs_left;
+
+			_write_moves();
+		}
+
+		/**
+		 * @brief Fills in the rating of a jump, if its position is still shown.
+		 * Safe to call from any thread.
+		 *
+		 * @param position The position the jump was rated in.
+		 * @param rating The rated jump.
+		 */
+		void rate(TriangleGame::t_state position, const TriangleGame::move_rating& rating) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_active || position != _position) return;
+
+			_ratings[{ rating.from, rating.to }] = rating.pegs_left;
+			_write_moves();
+		}
+
+		/**
+		 * @brief Shows the next page of moves.
+		 */
+		void next_page() {
+			_flush_game_output();
+			std::lock_guard<std::mutex> lock(_mutex);
+			_page++;
+			_write_moves();
+		}
+
+		/**
+		 * @brief Shows the previous page of moves.
+		 */
+		void previous_page() {
+			_flush_game_output();
+			std::lock_guard<std::mutex> lock(_mutex);
+			_page = std::max(0, _page - 1);
+			_write_moves();
+		}
+
+		/**
+		 * @brief Gives the whole terminal back, and moves the cursor below the board.
+		 */
+		void leave() {
+			_flush_game_output();
+			std::lock_guard<std::mutex> lock(_mutex);
+			std::stringstream out;
+			out << "\x1b[r\x1b[" << _rows << ";1H\n";
+			_write(out.str());
+			_drawn = false;
+			_active = false;
+		}
+
+	private:
+		int _height; //!< The height of the board.
+		int _cell; //!< The width of a hole, in characters.
+		int _rows; //!< The height of the terminal.
+		int _cols; //!< The width of the terminal.
+		TriangleGame::bitboard _shown; //!< The pegs on the screen.
+		bool _drawn; //!< True once the view has been drawn.
+		int _view_row; //!< The first board row in the view.
+		int _view_col; //!< The first character column in the view.
+		int _view_rows; //!< The number of board rows in the view.
+		int _page; //!< The page of moves shown.
+		bool _active; //!< True while the moves of a position are shown.
+		TriangleGame::t_state _position; //!< The position the moves are of.
+		TriangleGame::t_open_moves _moves; //!< The moves shown.
+		std::map<std::pair<int, int>, int> _ratings; //!< The fewest pegs left after each jump, by peg numbers.
+		std::mutex _mutex; //!< Held by every write, which can come from the hint service's thread.
+
+		/**
+		 * @brief Returns the character column of a hole.
+		 */
+		int _column_of(int row, int index) const {
+			return (_height - 1 - row) * _cell / 2 + index * _cell;
+		}
+
+		/**
+		 * @brief Determinds if a hole is inside the view.
+		 */
+		bool _visible(int row, int index) const {
+			int col = _column_of(row, index) - _view_col;
+			return row >= _view_row && row < _view_row + _view_rows && col >= 0 && col + _cell <= _cols;
+		}
+
+		/**
+		 * @brief Moves the view so the given hole is in its centre.
+		 */
+		void _follow(int row, int index) {
+			_view_row = std::clamp(row - _view_rows / 2, 0, std::max(0, _height - _view_rows));
+			_view_col = std::max(0, _column_of(row, index) - _cols / 2);
+		}
+
+		/**
+		 * @brief Clears the screen, draws every hole in the view, and sets up the status region.
+		 * The line of moves is rewritten by the next show_moves.
+		 */
+		void _redraw(const TriangleGame::bitboard& b, std::stringstream& out) {
+			out << "\x1b[r\x1b[2J";
+			for (int row = _view_row; row < _view_row + _view_rows; row++) {
+				for (int index = 0; index <= row; index++) {
+					if (_visible(row, index))
+						_draw_cell(b, row, index, out);
+				}
+			}
+
+			//everything after the board, and the line of moves, scrolls in the status region
+			int top = _view_rows + 3;
+			out << "\x1b[" << top << ";" << _rows << "r\x1b[" << _rows << ";1H";
+			_drawn = true;
+		}
+
+		/**
+		 * @brief Draws a single hole.
+		 */
+		void _draw_cell(const TriangleGame::bitboard& b, int row, int index, std::stringstream& out) {
+			std::string label = b.is_set(row, index)
+				? std::to_string(TriangleGame::peg::FindLastPegNumber(row) + index + 1)
+				: EMPTY_PEG_STR;
+
+			out << "\x1b[" << (row - _view_row + 1) << ";" << (_column_of(row, index) - _view_col + 1) << "H"
+				<< std::string(_cell - 1 - label.size(), ' ') << label;
+		}
+
+		/**
+		 * @brief Rewrites the line of moves, the mutex must be held.
+		 */
+		void _write_moves() {
+			if (!_drawn || !_active) return;
+
+			int pages = std::max(1, ((int)_moves.size() + TTY_MOVES_PER_PAGE - 1) / TTY_MOVES_PER_PAGE);
+			_page = std::min(_page, pages - 1);
+
+			//W can still be won, a number is the fewest pegs that can be left, ? is still being solved
+			std::stringstream ss;
+			ss << "Moves " << (_page + 1) << "/" << pages << " (W wins, N pegs left): ";
+
+			auto it = _moves.begin();
+			std::advance(it, std::min((int)_moves.size(), _page * TTY_MOVES_PER_PAGE));
+			for (int i = 0; i < TTY_MOVES_PER_PAGE && it != _moves.end(); i++, ++it) {
+				if (i > 0) ss << ", ";
+				ss << "[";
+				for (std::size_t k = 0; k < it->second.size(); k++) {
+					if (k > 0) ss << ", ";
+					ss << it->second[k];
+
+					auto r = _ratings.find({ it->second[k], it->first });
+					if (r == _ratings.end()) ss << " ?";
+					else if (r->second == 1) ss << " W";
+					else ss << " " << r->second;
+				}
+				ss << "] => " << it->first;
+			}
+
+			std::string line = ss.str();
+			if ((int)line.size() > _cols) line.resize(_cols);
+
+			std::stringstream out;
+			out << "\x1b" "7\x1b[" << (_view_rows + 2) << ";1H\x1b[2K" << line << "\x1b" "8";
+			_write(out.str());
+		}
+
+		/**
+		 * @brief Writes out anything the game has printed, before writing past it.
+		 * Only called from the game's thread, as std::cout is not shared with the hint service's.
+		 */
+		void _flush_game_output() {
+			std::cout << std::flush;
+		}
+
+		/**
+		 * @brief Writes to the terminal in a single write, the mutex must be held.
+		 */
+		void _write(const std::string& text) {
+			const char* p = text.data();
+			std::size_t left = text.size();
+			while (left > 0) {
+				ssize_t n = ::write(STDOUT_FILENO, p, left);
+				if (n <= 0) return;
+				p += n;
+				left -= (std::size_t)n;
+			}
+		}
+};
+
+#endif
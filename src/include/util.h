@@ -20,6 +20,8 @@
 #include <limits>
 #include <ios>
 #include <cctype>
+#include <climits>
+#include <algorithm>
 
 namespace util {
 
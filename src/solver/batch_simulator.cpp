@@ -0,0 +1,232 @@
+#include "batch_simulator.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TRIANGLE_GAME_X86_SIMD 1
+#endif
+
+namespace TriangleGame {
+
+	namespace {
+
+		//--------------------------------------------------
+		// Step Kernels
+		//--------------------------------------------------
+
+		/**
+		 * @brief Advances every game in a batch by one jump, see batch_simulator::step.
+		 * Always inlined, so each kernel below gets its own copy compiled for its instruction set.
+		 */
+		__attribute__((always_inline))
+		inline std::size_t step_lanes(const t_batch_lanes& b, fast_random& rng) {
+			const std::size_t n = b.games;
+			const t_state* states = b.states;
+
+			//Pass 1: the total weight of the legal jumps in each game
+			std::fill(b.totals, b.totals + n, 0);
+			std::fill(b.best, b.best + n, 0);
+			for (std::size_t k = 0; k < b.jumps; k++) {
+				const t_state need = b.need[k], target = b.target[k];
+				const std::uint32_t w = b.weights ? b.weights[k] : 1;
+
+				if (b.greedy) {
+					for (std::size_t i = 0; i < n; i++) {
+						std::uint32_t legal = ((states[i] & need) == need) & ((states[i] & target) == 0);
+						std::uint32_t higher = legal & (w > b.best[i]);
+						std::uint32_t same = legal & (w == b.best[i]);
+						b.totals[i] = higher ? 1 : b.totals[i] + same;
+						b.best[i] = higher ? w : b.best[i];
+					}
+				} else {
+					for (std::size_t i = 0; i < n; i++) {
+						std::uint32_t legal = ((states[i] & need) == need) & ((states[i] & target) == 0);
+						b.totals[i] += legal * w;
+					}
+				}
+			}
+
+			//Pick a point in each game's total weight
+			for (std::size_t i = 0; i < n; i++) {
+				b.picks[i] = b.totals[i] > 0 ? rng.bounded(b.totals[i]) : -1;
+				b.chosen[i] = NO_JUMP;
+			}
+
+			//Pass 2: find the jump each pick landed on
+			for (std::size_t k = 0; k < b.jumps; k++) {
+				const t_state need = b.need[k], target = b.target[k];
+				const std::int64_t w = b.weights ? b.weights[k] : 1;
+				const t_jump_id id = (t_jump_id)k;
+
+				for (std::size_t i = 0; i < n; i++) {
+					std::int64_t legal = ((states[i] & need) == need) & ((states[i] & target) == 0);
+					std::int64_t c = b.greedy ? legal & (w == b.best[i]) : legal * w;
+					bool hit = (b.picks[i] >= 0) & (b.picks[i] < c);
+					b.chosen[i] = hit ? id : b.chosen[i];
+					b.picks[i] -= c;
+				}
+			}
+
+			//A scripted jump replaces the pick, where it is legal
+			if (b.script != NO_JUMP) {
+				const t_state need = b.need[b.script], target = b.target[b.script];
+				for (std::size_t i = 0; i < n; i++) {
+					bool legal = ((states[i] & need) == need) & ((states[i] & target) == 0);
+					b.chosen[i] = legal ? b.script : b.chosen[i];
+				}
+			}
+
+			//Apply the jumps, and record them
+			std::size_t moved = 0;
+			for (std::size_t i = 0; i < n; i++) {
+				std::uint8_t made = b.chosen[i] != NO_JUMP;
+				b.states[i] ^= b.flips[made ? b.chosen[i] : b.jumps];
+				b.removed[i] += made;
+				b.history[i * b.history_stride] = b.chosen[i];
+				moved += made;
+			}
+			return moved;
+		}
+
+		std::size_t step_scalar(const t_batch_lanes& b, fast_random& rng) {
+			return step_lanes(b, rng);
+		}
+
+#ifdef TRIANGLE_GAME_X86_SIMD
+		__attribute__((target("avx2")))
+		std::size_t step_avx2(const t_batch_lanes& b, fast_random& rng) {
+			return step_lanes(b, rng);
+		}
+
+		__attribute__((target("avx512f,avx512bw,avx512vl")))
+		std::size_t step_avx512(const t_batch_lanes& b, fast_random& rng) {
+			return step_lanes(b, rng);
+		}
+#endif
+
+		t_step_kernel get_kernel(simd_level level) {
+#ifdef TRIANGLE_GAME_X86_SIMD
+			if (level == simd_level::avx512) return step_avx512;
+			if (level == simd_level::avx2) return step_avx2;
+#endif
+			return step_scalar;
+		}
+
+	}
+
+	batch_simulator::batch_simulator(const jump_table& table, std::size_t capacity)
+		: batch_simulator(table, capacity, move_generator::detect_level())
+	{
+
+	}
+
+	batch_simulator::batch_simulator(const jump_table& table, std::size_t capacity, simd_level level)
+		: _table(table), _capacity(capacity), _games(0), _active(0), _ply(0), _start_removed(0),
+		_policy(playout_policy::uniform),
+		_level(move_generator::is_supported(level) ? level : move_generator::detect_level()), _kernel(get_kernel(_level)),
+		_states(capacity, 0), _removed(capacity, 0), _history_offsets(capacity, 0),
+		_history(capacity * table.get_hole_count(), NO_JUMP),
+		_totals(capacity, 0), _best(capacity, 0), _picks(capacity, 0), _chosen(capacity, NO_JUMP)
+	{
+		for (const auto& j : _table.get_jumps()) {
+			_need.push_back(j.need);
+			_target.push_back(j.target);
+			_flips.push_back(j.flip);
+		}
+		_flips.push_back(0);
+
+		//each game gets room for a jump per hole, more than it can ever make
+		for (std::size_t i = 0; i < capacity; i++)
+			_history_offsets[i] = (std::uint32_t)(i * table.get_hole_count());
+	}
+
+	std::size_t batch_simulator::get_capacity() const noexcept {
+		return _capacity;
+	}
+
+	simd_level batch_simulator::get_level() const noexcept {
+		return _level;
+	}
+
+	std::size_t batch_simulator::size() const noexcept {
+		return _games;
+	}
+
+	std::size_t batch_simulator::get_active() const noexcept {
+		return _active;
+	}
+
+	void batch_simulator::set_policy(playout_policy policy) {
+		_policy = policy;
+		if (_policy != playout_policy::uniform && _weights.empty())
+			_weights = playout_engine::edge_weights(_table);
+	}
+
+	void batch_simulator::set_weights(const std::vector<std::uint32_t>& weights) {
+		_weights = weights;
+	}
+
+	void batch_simulator::set_script(const std::vector<t_jump_id>& script) {
+		_script = script;
+	}
+
+	void batch_simulator::reset(t_state start, std::size_t games) {
+		_games = std::min(games, _capacity);
+		_active = _games;
+		_ply = 0;
+		_start_removed = _table.get_hole_count() - jump_table::count_pegs(start);
+
+		std::fill(_states.begin(), _states.begin() + _games, start);
+		std::fill(_removed.begin(), _removed.begin() + _games, (std::uint8_t)_start_removed);
+	}
+
+	std::size_t batch_simulator::step(fast_random& rng) {
+		t_batch_lanes lanes = {
+			_need.data(), _target.data(), _policy == playout_policy::uniform ? nullptr : _weights.data(), _flips.data(),
+			_need.size(), _policy == playout_policy::greedy,
+			_ply < (int)_script.size() ? _script[_ply] : NO_JUMP,
+			_states.data(), _removed.data(), _history.data() + _ply, (std::size_t)_table.get_hole_count(),
+			_totals.data(), _best.data(), _picks.data(), _chosen.data(), _games
+		};
+
+		std::size_t moved = _kernel(lanes, rng);
+		if (moved > 0) _ply++;
+		_active = moved;
+		return moved;
+	}
+
+	void batch_simulator::finish(fast_random& rng) {
+		while (step(rng) > 0);
+	}
+
+	void batch_simulator::collect(playout_result& result) const {
+		for (std::size_t i = 0; i < _games; i++)
+			result.add(_table.get_hole_count() - _removed[i]);
+	}
+
+	t_state batch_simulator::get_state(std::size_t game) const {
+		return _states[game];
+	}
+
+	int batch_simulator::get_removed(std::size_t game) const {
+		return _removed[game];
+	}
+
+	std::vector<t_jump_id> batch_simulator::get_history(std::size_t game) const {
+		auto begin = _history.begin() + _history_offsets[game];
+		return std::vector<t_jump_id>(begin, begin + (_removed[game] - _start_removed));
+	}
+
+	playout_result batch_simulator::run(t_state start, std::uint64_t count, fast_random& rng) {
+		auto result = playout_result(_table.get_hole_count());
+		while (count > 0) {
+			std::size_t games = (std::size_t)std::min<std::uint64_t>(count, _capacity);
+			reset(start, games);
+			finish(rng);
+			collect(result);
+			count -= games;
+		}
+		return result;
+	}
+
+}
@@ -0,0 +1,237 @@
+/**
+ * @file batch_simulator.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the batch_simulator class, which plays many games side by side.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_BATCH_SIMULATOR__
+#define __H_TRIANGLE_SOLVER_BATCH_SIMULATOR__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../board/move_generator.h"
+
+#include "jump_table.h"
+#include "fast_random.h"
+#include "playout.h"
+
+namespace TriangleGame {
+
+	const t_jump_id NO_JUMP = 0xFFFF; //!< The jump id of a game that has ended.
+
+	/**
+	 * @brief The arrays a batch_simulator step works on, passed to its kernel.
+	 */
+	struct t_batch_lanes {
+		const t_state* need; //!< The need mask of each jump.
+		const t_state* target; //!< The target mask of each jump.
+		const std::uint32_t* weights; //!< The weight of each jump, nullptr for the uniform policy.
+		const t_state* flips; //!< The flip mask of each jump, followed by an empty mask.
+		std::size_t jumps; //!< The number of jumps.
+		bool greedy; //!< True when the greedy policy is used.
+		t_jump_id script; //!< The scripted jump of this ply, or NO_JUMP.
+		t_state* states; //!< The occupancy word of each game.
+		std::uint8_t* removed; //!< The removed peg count of each game.
+		t_jump_id* history; //!< Where the first game records this ply's jump.
+		std::size_t history_stride; //!< The distance between games in the history.
+		std::uint32_t* totals; //!< Scratch, the total weight of each game's candidate jumps.
+		std::uint32_t* best; //!< Scratch, the highest legal weight of each game.
+		std::int64_t* picks; //!< Scratch, the weight left before each game's picked jump.
+		t_jump_id* chosen; //!< Scratch, the jump picked in each game.
+		std::size_t games; //!< The number of games.
+	};
+
+	typedef std::size_t (*t_step_kernel)(const t_batch_lanes&, fast_random&); //!< A step of a batch, for one instruction set.
+
+	/**
+	 * @brief The Batch Simulator Class, plays a batch of independent games one ply at a time.
+	 *
+	 * The games are kept as a structure of arrays, an occupancy word, a removed peg count
+	 * and a history offset per game, instead of one board per game. Each ply walks the
+	 * jump table once, and for each jump tests it against every game in a tight loop over
+	 * the occupancy words, so the work per game is a few branchless instructions the
+	 * compiler vectorizes. The step is compiled for AVX2 and AVX-512 as well, and picked
+	 * at runtime the same way as the move_generator. Games that have ended stay in the
+	 * arrays and are masked out.
+	 *
+	 * Jumps are picked by the policy:
+	 * - uniform, every legal jump is equally likely,
+	 * - weighted, jumps are picked in proportion to their weight,
+	 * - greedy, the legal jump with the highest weight, ties are broken at random.
+	 * A script can be set to force the first jumps of every game, a scripted jump that
+	 * is not legal in a game falls back to the policy.
+	 */
+	class batch_simulator {
+		public:
+			/**
+			 * @brief Construct a new batch simulator.
+			 *
+			 * @param table The jumps of the board, must outlive the simulator.
+			 * @param capacity The most games in a batch.
+			 */
+			batch_simulator(const jump_table& table, std::size_t capacity);
+
+			/**
+			 * @brief Construct a new batch simulator, using the given instruction set.
+			 * Falls back to the best supported level when the CPU does not support it.
+			 *
+			 * @param table The jumps of the board, must outlive the simulator.
+			 * @param capacity The most games in a batch.
+			 * @param level The instruction set to step with.
+			 */
+			batch_simulator(const jump_table& table, std::size_t capacity, simd_level level);
+
+			/**
+			 * @brief Returns the instruction set the batch is stepped with.
+			 *
+			 * @return simd_level The instruction set.
+			 */
+			simd_level get_level() const noexcept;
+
+			/**
+			 * @brief Returns the most games in a batch.
+			 *
+			 * @return std::size_t The capacity.
+			 */
+			std::size_t get_capacity() const noexcept;
+
+			/**
+			 * @brief Returns the number of games in the current batch.
+			 *
+			 * @return std::size_t The number of games.
+			 */
+			std::size_t size() const noexcept;
+
+			/**
+			 * @brief Returns the number of games in the current batch that have not ended.
+			 *
+			 * @return std::size_t The number of games still being played.
+			 */
+			std::size_t get_active() const noexcept;
+
+			/**
+			 * @brief Sets how the next jump is picked.
+			 * The weighted and greedy policies default to playout_engine::edge_weights when no weights have been set.
+			 *
+			 * @param policy The policy to use.
+			 */
+			void set_policy(playout_policy policy);
+
+			/**
+			 * @brief Sets the weight of each jump for the weighted and greedy policies.
+			 *
+			 * @param weights One weight per jump in the jump table, a weighted game ends
+			 * when every legal jump has a weight of zero.
+			 */
+			void set_weights(const std::vector<std::uint32_t>& weights);
+
+			/**
+			 * @brief Sets the jumps every game starts with.
+			 *
+			 * @param script The jump ids to play, in order.
+			 */
+			void set_script(const std::vector<t_jump_id>& script);
+
+			/**
+			 * @brief Starts a new batch, every game from the same position.
+			 *
+			 * @param start The position to start from.
+			 * @param games The number of games, at most the capacity.
+			 */
+			void reset(t_state start, std::size_t games);
+
+			/**
+			 * @brief Advances every game that has not ended by one jump.
+			 *
+			 * @param rng The generator to pick jumps with.
+			 * @return std::size_t The number of games that made a jump.
+			 */
+			std::size_t step(fast_random& rng);
+
+			/**
+			 * @brief Plays every game in the batch to the end.
+			 *
+			 * @param rng The generator to pick jumps with.
+			 */
+			void finish(fast_random& rng);
+
+			/**
+			 * @brief Adds the final peg count of every game in the batch to a result.
+			 *
+			 * @param result The result to add to.
+			 */
+			void collect(playout_result& result) const;
+
+			/**
+			 * @brief Returns the position of a game.
+			 *
+			 * @param game The index of the game.
+			 * @return t_state The position.
+			 */
+			t_state get_state(std::size_t game) const;
+
+			/**
+			 * @brief Returns the number of pegs removed from a game, including the starting hole.
+			 *
+			 * @param game The index of the game.
+			 * @return int The number of removed pegs.
+			 */
+			int get_removed(std::size_t game) const;
+
+			/**
+			 * @brief Returns the jumps made in a game.
+			 *
+			 * @param game The index of the game.
+			 * @return std::vector<t_jump_id> The jump ids, in order.
+			 */
+			std::vector<t_jump_id> get_history(std::size_t game) const;
+
+			/**
+			 * @brief Plays many games from the given position, a batch at a time.
+			 *
+			 * @param start The position to start from.
+			 * @param count The number of games.
+			 * @param rng The generator to pick jumps with.
+			 * @return playout_result The distribution of final peg counts.
+			 */
+			playout_result run(t_state start, std::uint64_t count, fast_random& rng);
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			std::size_t _capacity; //!< The most games in a batch.
+			std::size_t _games; //!< The number of games in the current batch.
+			std::size_t _active; //!< The number of games that have not ended.
+			int _ply; //!< The number of steps taken in the current batch.
+			int _start_removed; //!< The removed peg count of the starting position.
+			playout_policy _policy; //!< How the next jump is picked.
+			simd_level _level; //!< The instruction set to step with.
+			t_step_kernel _kernel; //!< The step, compiled for _level.
+			std::vector<std::uint32_t> _weights; //!< The weight of each jump.
+			std::vector<t_jump_id> _script; //!< The jumps every game starts with.
+			std::vector<t_state> _need; //!< The need mask of each jump.
+			std::vector<t_state> _target; //!< The target mask of each jump.
+			std::vector<t_state> _flips; //!< The flip mask of each jump, followed by an empty mask for games that have ended.
+
+			//Per game arrays
+			std::vector<t_state> _states; //!< The occupancy word of each game.
+			std::vector<std::uint8_t> _removed; //!< The removed peg count of each game.
+			std::vector<std::uint32_t> _history_offsets; //!< Where each game's jumps start in _history.
+			std::vector<t_jump_id> _history; //!< The jumps of every game.
+
+			//Per game scratch space, reused every step
+			std::vector<std::uint32_t> _totals; //!< The total weight of each game's candidate jumps.
+			std::vector<std::uint32_t> _best; //!< The highest legal weight of each game, for the greedy policy.
+			std::vector<std::int64_t> _picks; //!< The weight left before each game's picked jump.
+			std::vector<t_jump_id> _chosen; //!< The jump picked in each game.
+	};
+
+}
+
+#endif
@@ -0,0 +1,308 @@
+#include "bidirectional_solver.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+
+namespace TriangleGame {
+
+	bidirectional_solver::bidirectional_solver(const jump_table& table)
+		: _table(table), _symmetries(table), _stop(nullptr), _target(0), _rejection(goal_check::possible),
+		_stopped(false), _nodes(0),
+		_memory_limit(0), _out_of_memory(false), _level_bytes(0), _peak_memory(0)
+	{
+
+	}
+
+	void bidirectional_solver::set_stop_flag(const std::atomic<bool>* stop) noexcept {
+		_stop = stop;
+	}
+
+	void bidirectional_solver::set_goal(int pegNumber) noexcept {
+		_target = pegNumber > 0 ? t_state(1) << (pegNumber - 1) : 0;
+	}
+
+	void bidirectional_solver::set_target(t_state target) noexcept {
+		_target = target;
+	}
+
+	void bidirectional_solver::set_memory_limit(std::size_t bytes) noexcept {
+		_memory_limit = bytes;
+	}
+
+	bool bidirectional_solver::solve(t_state s, std::vector<t_jump_id>& jumps) {
+		_forward.clear();
+		_backward.clear();
+		_stopped = false;
+		_out_of_memory = false;
+		_nodes = 0;
+		_rejection = goal_check::possible;
+
+		//a target the invariants rule out is never searched for
+		_forward_filters.clear();
+		_finishes.clear();
+		if (_target != 0) {
+			_forward_filters.emplace_back(_table, _target);
+			_rejection = _forward_filters.back().check(s);
+			if (_rejection != goal_check::possible) {
+				_forward_filters.clear();
+				return false;
+			}
+			_finishes.push_back(_target);
+		}
+
+		_kept.clear();
+		for (int g = 0; g < _symmetries.size(); g++) {
+			if (_target == 0 || _symmetries.apply(_target, g) == _target)
+				_kept.push_back(g);
+		}
+
+		//a stored position stands for all its images, so its complement is pruned when none of them can be reached
+		t_state full = _table.get_full_state();
+		auto starts = std::vector<t_state>();
+		for (int g : _kept) {
+			t_state image = _symmetries.apply(s, g);
+			if (std::find(starts.begin(), starts.end(), image) == starts.end()) {
+				starts.push_back(image);
+				_backward_filters.emplace_back(_table, full & ~image);
+			}
+		}
+
+		//without a target, the last peg can only finish in the holes some image of the start can reach
+		if (_target == 0) {
+			for (int h = 0; h < _table.get_hole_count(); h++) {
+				auto filter = goal_filter(_table, t_state(1) << h);
+				for (t_state image : starts) {
+					if (filter.check(image) == goal_check::possible) {
+						_forward_filters.push_back(std::move(filter));
+						_finishes.push_back(t_state(1) << h);
+						break;
+					}
+				}
+			}
+		}
+
+		bool solved = _search(s, jumps);
+		_forward_filters.clear();
+		_backward_filters.clear();
+		return solved;
+	}
+
+	bool bidirectional_solver::_search(t_state s, std::vector<t_jump_id>& jumps) {
+		_forward.push_back({ _key(s) });
+		_backward.emplace_back();
+		for (t_state finish : _finishes)
+			_backward.back().insert(_key(finish));
+		if (_backward.back().empty()) return false;
+
+		_level_bytes = _bytes_of(_forward.back()) + _bytes_of(_backward.back());
+		_peak_memory = _level_bytes;
+
+		int forwardPegs = jump_table::count_pegs(s);
+		int backwardPegs = _target != 0 ? jump_table::count_pegs(_target) : 1;
+
+		while (forwardPegs > backwardPegs) {
+			//grow whichever side is cheaper to grow
+			bool forward = _forward.back().size() <= _backward.back().size();
+			if (!(forward ? _expand_forward() : _expand_backward()))
+				return false;
+
+			if (forward) forwardPegs--;
+			else backwardPegs++;
+
+			if (_forward.back().empty() || _backward.back().empty())
+				return false;
+		}
+
+		if (forwardPegs != backwardPegs)
+			return false;
+
+		//walk the smaller frontier, looking each position up in the larger
+		const auto& small = _forward.back().size() <= _backward.back().size() ? _forward.back() : _backward.back();
+		const auto& large = &small == &_forward.back() ? _backward.back() : _forward.back();
+		for (t_state meet : small) {
+			if (large.count(meet)) {
+				_join(s, meet, jumps);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool bidirectional_solver::was_stopped() const noexcept {
+		return _stopped;
+	}
+
+	goal_check bidirectional_solver::get_rejection() const noexcept {
+		return _rejection;
+	}
+
+	bool bidirectional_solver::was_out_of_memory() const noexcept {
+		return _out_of_memory;
+	}
+
+	std::size_t bidirectional_solver::get_peak_memory() const noexcept {
+		return _peak_memory;
+	}
+
+	std::uint64_t bidirectional_solver::get_nodes() const noexcept {
+		return _nodes;
+	}
+
+	std::size_t bidirectional_solver::get_stored() const noexcept {
+		std::size_t stored = 0;
+		for (const auto& level : _forward) stored += level.size();
+		for (const auto& level : _backward) stored += level.size();
+		return stored;
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	bool bidirectional_solver::_expand_forward() {
+		TRIANGLE_TRACE("bidirectional_solver::expand_forward", (std::int64_t)_forward.size());
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+
+		t_frontier next;
+		if (_memory_limit == 0) next.reserve(_forward.back().size() * 2); //with a limit, every bucket is accounted for as it grows
+		for (t_state s : _forward.back()) {
+			if (_should_stop()) return false;
+
+			int n = _table.get_legal_jumps(s, legal);
+			for (int i = 0; i < n; i++) {
+				t_state child = s ^ jumps[legal[i]].flip;
+				if (!_may_finish(child)) continue;
+				if (!_add(next, _key(child))) return false;
+			}
+		}
+
+		_level_bytes += _bytes_of(next);
+		_forward.push_back(std::move(next));
+		return true;
+	}
+
+	bool bidirectional_solver::_expand_backward() {
+		TRIANGLE_TRACE("bidirectional_solver::expand_backward", (std::int64_t)_backward.size());
+		const auto& jumps = _table.get_jumps();
+		t_state full = _table.get_full_state();
+
+		t_frontier next;
+		if (_memory_limit == 0) next.reserve(_backward.back().size() * 2); //with a limit, every bucket is accounted for as it grows
+		for (t_state w : _backward.back()) {
+			if (_should_stop()) return false;
+
+			//an unjump needs a peg where the jump lands, and empty holes where it started
+			for (const auto& j : jumps) {
+				if ((w & j.need) == 0 && (w & j.target) == j.target) {
+					t_state parent = w ^ j.flip;
+					if (!_may_reach(full & ~parent)) continue;
+					if (!_add(next, _key(parent))) return false;
+				}
+			}
+		}
+
+		_level_bytes += _bytes_of(next);
+		_backward.push_back(std::move(next));
+		return true;
+	}
+
+	bool bidirectional_solver::_add(t_frontier& next, t_state s) {
+		if (next.count(s)) return true;
+
+		//growing past the load factor rehashes, with the old and new buckets both allocated
+		std::size_t buckets = next.bucket_count();
+		std::size_t rehash = next.size() + 1 > buckets * next.max_load_factor() ? buckets * 2 + 1 : 0;
+		std::size_t need = _level_bytes + _bytes_of(next) + TABLE_ENTRY_BYTES + rehash * sizeof(void*);
+
+		if (_memory_limit != 0 && need > _memory_limit) {
+			_out_of_memory = true;
+			return false;
+		}
+
+		_peak_memory = std::max(_peak_memory, need);
+		next.insert(s);
+		return true;
+	}
+
+	std::size_t bidirectional_solver::_bytes_of(const t_frontier& level) noexcept {
+		return level.size() * TABLE_ENTRY_BYTES + level.bucket_count() * sizeof(void*);
+	}
+
+	bool bidirectional_solver::_should_stop() {
+		if ((++_nodes & 0x3FFF) == 0 && _stop != nullptr && _stop->load(std::memory_order_relaxed))
+			_stopped = true;
+		return _stopped;
+	}
+
+	bool bidirectional_solver::_may_finish(t_state s) const noexcept {
+		for (const auto& filter : _forward_filters) {
+			if (filter.possible(s)) return true;
+		}
+		return false;
+	}
+
+	bool bidirectional_solver::_may_reach(t_state complement) const noexcept {
+		for (const auto& filter : _backward_filters) {
+			if (filter.possible(complement)) return true;
+		}
+		return false;
+	}
+
+	t_state bidirectional_solver::_key(t_state s) const noexcept {
+		if (_target == 0) return _symmetries.canonical(s);
+
+		t_state best = s;
+		for (std::size_t k = 1; k < _kept.size(); k++)
+			best = std::min(best, _symmetries.apply(s, _kept[k]));
+		return best;
+	}
+
+	void bidirectional_solver::_join(t_state start, t_state meet, std::vector<t_jump_id>& jumps) const {
+		TRIANGLE_TRACE("bidirectional_solver::join");
+		const auto& table = _table.get_jumps();
+		jumps.clear();
+
+		//back to the start, each step undoes a jump into the level before
+		t_state s = meet;
+		for (std::size_t k = _forward.size() - 1; k > 0; k--) {
+			for (std::size_t i = 0; i < table.size(); i++) {
+				const auto& j = table[i];
+				if ((s & j.need) == 0 && (s & j.target) == j.target && _forward[k - 1].count(_key(s ^ j.flip))) {
+					jumps.push_back((t_jump_id)i);
+					s ^= j.flip;
+					break;
+				}
+			}
+		}
+		std::reverse(jumps.begin(), jumps.end());
+		t_state first = s;
+
+		//on to a single peg, each step makes a jump into the level before
+		s = meet;
+		t_jump_id legal[MAX_JUMPS];
+		for (std::size_t k = _backward.size() - 1; k > 0; k--) {
+			int n = _table.get_legal_jumps(s, legal);
+			for (int i = 0; i < n; i++) {
+				if (_backward[k - 1].count(_key(s ^ table[legal[i]].flip))) {
+					jumps.push_back(legal[i]);
+					s ^= table[legal[i]].flip;
+					break;
+				}
+			}
+		}
+
+		//the jumps start from a symmetry of the start, map them back onto it
+		if (first == start) return;
+		for (int g : _kept) {
+			if (_symmetries.apply(first, g) != start) continue;
+
+			const auto& map = _symmetries.get_maps()[g];
+			for (auto& id : jumps)
+				_table.find_jump(map[table[id].from] + 1, map[table[id].to] + 1, id);
+			return;
+		}
+	}
+
+}
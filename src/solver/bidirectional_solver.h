@@ -0,0 +1,269 @@
+/**
+ * @file bidirectional_solver.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the bidirectional_solver class, which searches from the start and the goal at once.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_BIDIRECTIONAL_SOLVER__
+#define __H_TRIANGLE_SOLVER_BIDIRECTIONAL_SOLVER__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "jump_table.h"
+#include "symmetry_group.h"
+#include "goal_filter.h"
+
+namespace TriangleGame {
+
+	typedef std::unordered_set<t_state> t_frontier; //!< The positions of one level of a search.
+
+	/**
+	 * @brief The Bidirectional Solver Class, finds a sequence of jumps that leaves a single peg.
+	 *
+	 * Every jump has an exact reverse, an "unjump" that empties the hole landed in and puts
+	 * the two pegs back, so the game can be searched backwards from the one peg positions
+	 * as well as forwards from the start. Both searches are breadth first, one level of pegs
+	 * at a time, and the smaller frontier is always the one expanded. Every solution passes
+	 * through exactly one position of each peg count, so once the two frontiers have the
+	 * same number of pegs, a solution exists only if they share a position, and any shared
+	 * position joins the two halves. Each search only goes half way, so far fewer positions
+	 * are stored than by a search from one end.
+	 *
+	 * The search can instead finish at any target position, such as the last peg in a given
+	 * hole, and then starts from the target alone. A target that a goal_filter rules out is
+	 * rejected before anything is searched, and the filter prunes every position reached
+	 * from the start. Without a target, the search back only starts from the holes a
+	 * goal_filter lets the start finish in, and a position reached from the start is kept
+	 * while any of their filters allows it. Positions reached back are pruned by the same
+	 * filters with the board turned inside out: a jump from a position is an unjump into it
+	 * with every hole's peg swapped for a hole, so the complement of a position must be able
+	 * to reach the complement of the start.
+	 *
+	 * Positions are stored canonicalized under the symmetries that keep the target where it
+	 * is, every symmetry of the board when the last peg can finish in any hole. A stored
+	 * position stands for all its images, so its complement is only pruned when no image of
+	 * the start can reach it. No links are stored, the jumps are found again once the
+	 * searches meet, by looking for the neighbour of each position in the level before.
+	 *
+	 * With a memory limit, the search gives up as soon as the next level would not fit,
+	 * as the levels cannot be given up without losing the way back to the start.
+	 *
+	 * The middle levels hold every position of their peg count that both ends can reach,
+	 * which the depth first solver never needs to store, as it stops at the first single
+	 * peg it finds. So this search is worth it for a target the depth first solver would
+	 * search the whole game for, such as a last peg in a hole it rarely finishes in, but
+	 * for a single peg in any hole the depth first solver is usually far cheaper.
+	 */
+	class bidirectional_solver {
+		public:
+			/**
+			 * @brief Construct a new bidirectional solver for the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the solver.
+			 */
+			bidirectional_solver(const jump_table& table);
+
+			/**
+			 * @brief Sets a flag that stops the search when it becomes true.
+			 *
+			 * @param stop The flag to check, or nullptr to never stop.
+			 */
+			void set_stop_flag(const std::atomic<bool>* stop) noexcept;
+
+			/**
+			 * @brief Sets the hole the last peg must finish in.
+			 *
+			 * @param pegNumber The peg hole, or 0 to finish in any hole.
+			 */
+			void set_goal(int pegNumber) noexcept;
+
+			/**
+			 * @brief Sets the position the search must finish at.
+			 *
+			 * @param target The target position, or 0 to finish with a single peg in any hole.
+			 */
+			void set_target(t_state target) noexcept;
+
+			/**
+			 * @brief Sets the most memory the levels can use.
+			 *
+			 * @param bytes The memory limit, or 0 for no limit.
+			 */
+			void set_memory_limit(std::size_t bytes) noexcept;
+
+			/**
+			 * @brief Finds a sequence of jumps from the given position that leaves a single peg.
+			 *
+			 * @param s The position to start from.
+			 * @param jumps The returned jumps, in the order they are made.
+			 * @return true If a sequence was found.
+			 * @return false If no sequence leaves a single peg, or the search was stopped or ran out of memory.
+			 */
+			bool solve(t_state s, std::vector<t_jump_id>& jumps);
+
+			/**
+			 * @brief Determinds if the last search was stopped before it finished.
+			 *
+			 * @return true If the search was stopped.
+			 * @return false Otherwise.
+			 */
+			bool was_stopped() const noexcept;
+
+			/**
+			 * @brief Returns why the last search's target was ruled out before searching.
+			 *
+			 * @return goal_check The invariant that rules the target out, or possible when the target was searched for.
+			 */
+			goal_check get_rejection() const noexcept;
+
+			/**
+			 * @brief Determinds if the last search gave up because the next level would not fit the memory limit.
+			 *
+			 * @return true If the search ran out of memory.
+			 * @return false Otherwise.
+			 */
+			bool was_out_of_memory() const noexcept;
+
+			/**
+			 * @brief Returns the most memory the levels of the last search used.
+			 *
+			 * @return std::size_t The peak memory, in bytes.
+			 */
+			std::size_t get_peak_memory() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions expanded by the last search.
+			 *
+			 * @return std::uint64_t The number of positions expanded.
+			 */
+			std::uint64_t get_nodes() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions stored by the last search, from both ends.
+			 *
+			 * @return std::size_t The number of positions stored.
+			 */
+			std::size_t get_stored() const noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			symmetry_group _symmetries; //!< The board's symmetries.
+			const std::atomic<bool>* _stop; //!< Stops the search when true.
+			t_state _target; //!< The position to finish at, or 0 for a single peg in any hole.
+			goal_check _rejection; //!< Why the last search's target was ruled out.
+			std::vector<goal_filter> _forward_filters; //!< Prune positions reached from the start, one for each position the search may finish at.
+			std::vector<goal_filter> _backward_filters; //!< Prune the complements of positions reached from the target, one for each image of the start.
+			std::vector<t_state> _finishes; //!< The positions the search from the goal starts from, the target, or each single peg the start may finish with.
+			std::vector<int> _kept; //!< The symmetries that keep the target where it is, positions are stored canonical under them.
+			bool _stopped; //!< True when the last search was stopped.
+			std::uint64_t _nodes; //!< The number of positions expanded.
+			std::size_t _memory_limit; //!< The most memory the levels can use, 0 for no limit.
+			bool _out_of_memory; //!< True when the last search ran out of memory.
+			std::size_t _level_bytes; //!< The memory of every level but the one being built.
+			std::size_t _peak_memory; //!< The most memory the levels have used.
+			std::vector<t_frontier> _forward; //!< The levels of the search from the start.
+			std::vector<t_frontier> _backward; //!< The levels of the search from the goal.
+
+			/**
+			 * @brief Searches from both ends, once the target has passed the filter.
+			 *
+			 * @param s The position to start from.
+			 * @param jumps The returned jumps, in the order they are made.
+			 * @return true If a sequence was found.
+			 * @return false Otherwise.
+			 */
+			bool _search(t_state s, std::vector<t_jump_id>& jumps);
+
+			/**
+			 * @brief Determinds if a position reached from the start may still finish at one of the positions searched for.
+			 *
+			 * @param s The position.
+			 * @return true If no filter rules it out.
+			 * @return false Otherwise.
+			 */
+			bool _may_finish(t_state s) const noexcept;
+
+			/**
+			 * @brief Expands the last level of the search from the start by every jump.
+			 *
+			 * @return true If the level was expanded.
+			 * @return false If the search was stopped.
+			 */
+			bool _expand_forward();
+
+			/**
+			 * @brief Expands the last level of the search from the goal by every unjump.
+			 *
+			 * @return true If the level was expanded.
+			 * @return false If the search was stopped.
+			 */
+			bool _expand_backward();
+
+			/**
+			 * @brief Adds a position to the level being built, if it fits the memory limit.
+			 *
+			 * @param next The level being built.
+			 * @param s The position.
+			 * @return true If the position was added.
+			 * @return false If the search ran out of memory.
+			 */
+			bool _add(t_frontier& next, t_state s);
+
+			/**
+			 * @brief Returns the estimated memory of a level.
+			 *
+			 * @param level The level.
+			 * @return std::size_t The memory used, in bytes.
+			 */
+			static std::size_t _bytes_of(const t_frontier& level) noexcept;
+
+			/**
+			 * @brief Determinds if the search should stop, checked every few thousand nodes.
+			 *
+			 * @return true If the stop flag is set.
+			 * @return false Otherwise.
+			 */
+			bool _should_stop();
+
+			/**
+			 * @brief Returns the position stored for the given one, its canonical form under
+			 * the symmetries that keep the target.
+			 *
+			 * @param s The position.
+			 * @return t_state The stored position.
+			 */
+			t_state _key(t_state s) const noexcept;
+
+			/**
+			 * @brief Determinds if the complement of a position reached back from the target
+			 * may reach the complement of some image of the start.
+			 *
+			 * @param complement The complement of the position.
+			 * @return true If the position may be reachable from the start.
+			 * @return false If it is not.
+			 */
+			bool _may_reach(t_state complement) const noexcept;
+
+			/**
+			 * @brief Finds the jumps out from the position where the searches met, to the
+			 * start and to a single peg.
+			 *
+			 * @param start The position the search started from.
+			 * @param meet The position in both last levels.
+			 * @param jumps The returned jumps, in the order they are made.
+			 */
+			void _join(t_state start, t_state meet, std::vector<t_jump_id>& jumps) const;
+	};
+
+}
+
+#endif
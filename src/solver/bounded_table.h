@@ -0,0 +1,342 @@
+/**
+ * @file bounded_table.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the bounded_table class, a hash table of searched positions that can be kept under a memory limit.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_BOUNDED_TABLE__
+#define __H_TRIANGLE_SOLVER_BOUNDED_TABLE__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "jump_table.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief Hashes a position, mixed, since positions of a game share most of their bits.
+	 */
+	struct state_hash {
+		std::size_t operator()(t_state s) const noexcept {
+			s ^= s >> 30;
+			s *= 0xbf58476d1ce4e5b9ULL;
+			s ^= s >> 27;
+			s *= 0x94d049bb133111ebULL;
+			s ^= s >> 31;
+			return (std::size_t)s;
+		}
+	};
+
+	/**
+	 * @brief Returns the position of a table key, for a table keyed by positions, the key itself.
+	 */
+	inline t_state key_state(t_state s) noexcept {
+		return s;
+	}
+
+	/**
+	 * @brief The Bounded Table Class, a hash table of searched positions, that stays under a
+	 * memory limit by replacing the positions that are the cheapest to search again.
+	 *
+	 * Keys are kept by linear probing from the slot their hash picks, and the table doubles
+	 * when it is three quarters full. With a limit, it only grows while the doubled slots
+	 * and the old ones they are copied from both fit, and from then on a new key replaces
+	 * the key with the fewest pegs of the first PROBES slots from its own. So the table
+	 * stays full, of the positions searched most recently, and the ones with the most pegs
+	 * among them, which are the most expensive to search again. A replaced key is removed
+	 * by moving the keys after it back, so a lookup can still stop at the first empty slot.
+	 * Lowering the limit copies the table into a smaller one, keeping the keys with the
+	 * most pegs, and a limit too small for MIN_SLOTS slots leaves no table at all.
+	 *
+	 * A key's position is found with key_state, and the key whose position is 0 marks an
+	 * empty slot, as no searched position has no pegs.
+	 *
+	 * @tparam Key The key, a position, or a position with more to it.
+	 * @tparam Value The value kept for each key.
+	 * @tparam Hash Hashes a key, its low bits pick the key's first slot.
+	 */
+	template<typename Key, typename Value, typename Hash>
+	class bounded_table {
+		public:
+			static const int PROBES = 8; //!< The slots from a new key's own that it can replace a key in, once the table is full.
+			static const std::size_t MIN_SLOTS = 16; //!< The fewest slots of a table.
+			static const std::size_t NO_LIMIT = SIZE_MAX; //!< The most slots of a table without a limit.
+
+			/**
+			 * @brief Construct a new, empty, table, with no limit.
+			 */
+			bounded_table() : _capacity(0), _mask(0), _size(0), _max_slots(NO_LIMIT), _peak_bytes(0), _replaced(0), _full(false) {
+
+			}
+
+			/**
+			 * @brief Sets the most memory the table can use, copying it into a smaller table when it is over.
+			 *
+			 * @param bytes The memory, in bytes, 0 for no limit.
+			 */
+			void set_limit(std::size_t bytes) {
+				_max_slots = NO_LIMIT;
+				if (bytes != 0) {
+					//growing copies the slots into twice as many, so both have to fit
+					std::size_t fit = bytes / sizeof(slot) / 3 * 2;
+					_max_slots = MIN_SLOTS;
+					while (_max_slots * 2 <= fit) _max_slots *= 2;
+					if (_max_slots > fit) _max_slots = 0;
+				}
+
+				if (_capacity > _max_slots)
+					_resize(_max_slots);
+			}
+
+			/**
+			 * @brief Returns the most slots the table can grow to.
+			 *
+			 * @return std::size_t The slots, 0 when there is no room for a table, NO_LIMIT without a limit.
+			 */
+			std::size_t get_max_slots() const noexcept {
+				return _max_slots;
+			}
+
+			/**
+			 * @brief Looks up a key.
+			 *
+			 * @param k The key.
+			 * @return const Value* The key's value, or nullptr when it is not in the table.
+			 */
+			const Value* find(const Key& k) const noexcept {
+				if (_capacity == 0) return nullptr;
+
+				//the table is never more than three quarters full, so there is always an empty slot to stop at
+				for (std::size_t i = Hash()(k) & _mask; ; i = (i + 1) & _mask) {
+					const slot& e = _slots[i];
+					if (e.key == k) return &e.value;
+					if (key_state(e.key) == 0) return nullptr;
+				}
+			}
+
+			/**
+			 * @brief Looks up a key.
+			 *
+			 * @param k The key.
+			 * @return Value* The key's value, which can be changed, or nullptr when it is not in the table.
+			 */
+			Value* find(const Key& k) noexcept {
+				return const_cast<Value*>(static_cast<const bounded_table*>(this)->find(k));
+			}
+
+			/**
+			 * @brief Stores a key, growing the table when it is three quarters full, or replacing a key with fewer pegs when it can not grow.
+			 *
+			 * @param k The key, its position must not be 0.
+			 * @param v The value.
+			 * @return true If the key was stored.
+			 * @return false If there is no table, or the table is full and the slots near the key's own are empty.
+			 */
+			bool store(const Key& k, const Value& v) {
+				if (_size >= _capacity / 4 * 3 && _can_grow())
+					_resize(_capacity == 0 ? MIN_SLOTS : _capacity * 2);
+				return _capacity != 0 && _insert(k, v, false);
+			}
+
+			/**
+			 * @brief Empties the table, and frees its slots.
+			 */
+			void clear() noexcept {
+				_slots.reset();
+				_capacity = 0;
+				_mask = 0;
+				_size = 0;
+				_full = false;
+			}
+
+			/**
+			 * @brief Calls a function with each key in the table and its value.
+			 *
+			 * @param f The function, called as f(key, value).
+			 */
+			template<typename F>
+			void for_each(F f) const {
+				for (std::size_t i = 0; i < _capacity; i++) {
+					if (key_state(_slots[i].key) != 0)
+						f(_slots[i].key, _slots[i].value);
+				}
+			}
+
+			/**
+			 * @brief Returns the number of keys in the table.
+			 *
+			 * @return std::size_t The number of keys.
+			 */
+			std::size_t size() const noexcept {
+				return _size;
+			}
+
+			/**
+			 * @brief Determinds if the table is empty.
+			 *
+			 * @return true If there are no keys in the table.
+			 * @return false Otherwise.
+			 */
+			bool empty() const noexcept {
+				return _size == 0;
+			}
+
+			/**
+			 * @brief Returns the memory used by the table's slots.
+			 *
+			 * @return std::size_t The memory, in bytes.
+			 */
+			std::size_t get_bytes() const noexcept {
+				return _capacity * sizeof(slot);
+			}
+
+			/**
+			 * @brief Returns the most memory the table has used, including both tables while it was copied into another.
+			 *
+			 * @return std::size_t The memory, in bytes.
+			 */
+			std::size_t get_peak_bytes() const noexcept {
+				return std::max(_peak_bytes, get_bytes());
+			}
+
+			/**
+			 * @brief Returns the number of keys replaced by another, since the table was made.
+			 *
+			 * @return std::uint64_t The number of keys replaced.
+			 */
+			std::uint64_t get_replaced() const noexcept {
+				return _replaced;
+			}
+
+			/**
+			 * @brief Determinds if the table has filled up to its limit, and a key has had to replace another.
+			 *
+			 * @return true If the table is full.
+			 * @return false Otherwise.
+			 */
+			bool is_full() const noexcept {
+				return _full;
+			}
+
+		private:
+			/**
+			 * @brief A slot, a key and its value.
+			 */
+			struct slot {
+				Key key; //!< The key, its position is 0 when the slot is empty.
+				Value value; //!< The value.
+			};
+
+			std::unique_ptr<slot[]> _slots; //!< The slots.
+			std::size_t _capacity; //!< The number of slots, a power of two, or 0.
+			std::size_t _mask; //!< The number of slots, less one.
+			std::size_t _size; //!< The number of keys.
+			std::size_t _max_slots; //!< The most slots the limit lets the table grow to.
+			std::size_t _peak_bytes; //!< The most memory used, while the table was copied.
+			std::uint64_t _replaced; //!< The number of keys replaced.
+			bool _full; //!< True once a key has been stored with the table at its limit.
+
+			/**
+			 * @brief Returns the number of pegs of a key's position.
+			 */
+			static int _pegs(const Key& k) noexcept {
+				return jump_table::count_pegs(key_state(k));
+			}
+
+			/**
+			 * @brief Determinds if the table can double without going over its limit.
+			 */
+			bool _can_grow() const noexcept {
+				return _capacity == 0 ? _max_slots >= MIN_SLOTS : _capacity <= _max_slots / 2;
+			}
+
+			/**
+			 * @brief Stores a key, first removing the key with the fewest pegs of the first PROBES slots from its own when the table is full.
+			 *
+			 * @param k The key.
+			 * @param v The value.
+			 * @param keep_most True to keep the key with the fewest pegs instead, when it has as many pegs as the new key.
+			 * @return true If the key was stored.
+			 * @return false Otherwise.
+			 */
+			bool _insert(const Key& k, const Value& v, bool keep_most) noexcept {
+				std::size_t own = Hash()(k) & _mask;
+				std::size_t i = own;
+				for (; key_state(_slots[i].key) != 0; i = (i + 1) & _mask) {
+					if (_slots[i].key == k) {
+						_slots[i].value = v;
+						return true;
+					}
+				}
+
+				if (_size >= _capacity / 4 * 3) {
+					_full = true;
+					std::size_t fewest = _capacity;
+					for (int p = 0; p < PROBES; p++) {
+						std::size_t j = (own + p) & _mask;
+						if (key_state(_slots[j].key) != 0 && (fewest == _capacity || _pegs(_slots[j].key) < _pegs(_slots[fewest].key)))
+							fewest = j;
+					}
+					if (fewest == _capacity || (keep_most && _pegs(_slots[fewest].key) >= _pegs(k))) return false;
+
+					_replaced++;
+					_remove(fewest);
+					for (i = own; key_state(_slots[i].key) != 0; i = (i + 1) & _mask);
+				}
+
+				_slots[i] = slot{ k, v };
+				_size++;
+				return true;
+			}
+
+			/**
+			 * @brief Removes the key in a slot, moving the keys after it back, so each can still be found from its own slot.
+			 *
+			 * @param hole The slot.
+			 */
+			void _remove(std::size_t hole) noexcept {
+				_slots[hole] = slot();
+				_size--;
+				for (std::size_t i = (hole + 1) & _mask; key_state(_slots[i].key) != 0; i = (i + 1) & _mask) {
+					//a key can fill the hole unless its own slot is between the hole and it
+					std::size_t own = Hash()(_slots[i].key) & _mask;
+					if (((i - own) & _mask) >= ((i - hole) & _mask)) {
+						_slots[hole] = _slots[i];
+						_slots[i] = slot();
+						hole = i;
+					}
+				}
+			}
+
+			/**
+			 * @brief Copies the table into the given number of slots, keeping the keys with the most pegs when they do not all fit.
+			 */
+			void _resize(std::size_t slots) {
+				auto old = std::move(_slots);
+				std::size_t count = _capacity;
+
+				_peak_bytes = std::max(_peak_bytes, (count + slots) * sizeof(slot));
+				_slots = slots == 0 ? nullptr : std::make_unique<slot[]>(slots);
+				_capacity = slots;
+				_mask = slots == 0 ? 0 : slots - 1;
+				_size = 0;
+				if (slots == 0) return;
+
+				for (std::size_t i = 0; i < count; i++) {
+					if (key_state(old[i].key) != 0)
+						_insert(old[i].key, old[i].value, true);
+				}
+			}
+	};
+
+}
+
+#endif
@@ -0,0 +1,230 @@
+#include "census.h"
+#include "../board/trace.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace TriangleGame {
+
+	census::census(const jump_table& table)
+		: _table(table), _symmetries(table), _memory_limit(CENSUS_DEFAULT_MEMORY), _created_dir(false)
+	{
+
+	}
+
+	census::~census() {
+		_clear();
+	}
+
+	void census::set_memory_limit(std::size_t bytes) noexcept {
+		_memory_limit = bytes;
+	}
+
+	void census::set_work_dir(const std::string& dir) {
+		_work_dir = dir;
+	}
+
+	bool census::run(t_state start) {
+		_clear();
+
+		//a fresh directory per census, so two can run side by side
+		std::error_code error;
+		if (_work_dir.empty()) {
+			auto dir = std::filesystem::temp_directory_path(error) / ("triangle-census-" + std::to_string(getpid()));
+			if (error) return false;
+			_work_dir = dir.string();
+		}
+		if (!std::filesystem::exists(_work_dir, error)) {
+			if (!std::filesystem::create_directories(_work_dir, error)) return false;
+			_created_dir = true;
+		}
+
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+
+		//Forward: every level from the one before
+		_levels.push_back(state_set({ _symmetries.canonical(start) }));
+		for (int k = 0; ; k++) {
+			TRIANGLE_TRACE("census::forward_level", k);
+			auto writer = state_set_writer(_file("level-" + std::to_string(k + 1)), _memory_limit / 2);
+			std::uint64_t dead = 0;
+
+			auto reader = _levels[k].read();
+			t_state s;
+			while (reader.next(s)) {
+				int n = _table.get_legal_jumps(s, legal);
+				dead += n == 0;
+				for (int i = 0; i < n; i++) {
+					if (!writer.add(_symmetries.canonical(s ^ jumps[legal[i]].flip))) return false;
+				}
+			}
+
+			_counts.push_back({ jump_table::count_pegs(start) - k, _levels[k].size(), dead, 0, _levels[k].get_file_bytes() });
+
+			auto next = state_set();
+			if (!writer.finish(next)) return false;
+			if (next.size() == 0) break;
+
+			_levels.push_back(std::move(next));
+			if (!_fit_memory()) return false;
+		}
+
+		//Backward: undo every jump of the next level's winnable positions, and keep the ones in this level
+		_winnable.resize(_levels.size());
+		for (int k = (int)_levels.size() - 1; k >= 0; k--) {
+			TRIANGLE_TRACE("census::backward_level", k);
+			if (_counts[k].pegs == 1) {
+				auto copy = std::vector<t_state>();
+				auto reader = _levels[k].read();
+				t_state s;
+				while (reader.next(s)) copy.push_back(s);
+				_winnable[k] = state_set(std::move(copy));
+			} else if (k + 1 < (int)_levels.size()) {
+				auto parents = state_set_writer(_file("parents-" + std::to_string(k)), _memory_limit / 4);
+				auto reader = _winnable[k + 1].read();
+				t_state w;
+				while (reader.next(w)) {
+					for (const auto& j : jumps) {
+						if ((w & j.need) == 0 && (w & j.target) == j.target) {
+							if (!parents.add(_symmetries.canonical(w ^ j.flip))) return false;
+						}
+					}
+				}
+
+				auto candidates = state_set();
+				if (!parents.finish(candidates)) return false;
+
+				//both sets are sorted, so the intersection is a single merge
+				auto winnable = state_set_writer(_file("winnable-" + std::to_string(k)), _memory_limit / 4);
+				auto a = _levels[k].read();
+				auto b = candidates.read();
+				t_state x, y;
+				bool hasX = a.next(x), hasY = b.next(y);
+				while (hasX && hasY) {
+					if (x < y) hasX = a.next(x);
+					else if (y < x) hasY = b.next(y);
+					else {
+						if (!winnable.add(x)) return false;
+						hasX = a.next(x);
+						hasY = b.next(y);
+					}
+				}
+
+				if (!winnable.finish(_winnable[k])) return false;
+			}
+
+			_counts[k].winnable = _winnable[k].size();
+			if (!_fit_memory()) return false;
+		}
+
+		return true;
+	}
+
+	const std::vector<census_level>& census::get_levels() const noexcept {
+		return _counts;
+	}
+
+	const symmetry_group& census::get_symmetries() const noexcept {
+		return _symmetries;
+	}
+
+	bool census::export_states(const std::string& path) const {
+		std::ofstream out(path);
+		if (!out) return false;
+
+		out << "# position pegs W=winnable D=dead-end" << std::endl;
+		for (std::size_t k = 0; k < _levels.size(); k++) {
+			auto level = _levels[k].read();
+			auto winnable = _winnable[k].read();
+			t_state s, w;
+			bool hasW = winnable.next(w);
+
+			while (level.next(s)) {
+				while (hasW && w < s) hasW = winnable.next(w);
+
+				char flag = '-';
+				if (hasW && w == s) flag = 'W';
+				else if (!_table.has_jump(s)) flag = 'D';
+
+				out << std::hex << s << std::dec << ' ' << _counts[k].pegs << ' ' << flag << '\n';
+			}
+		}
+
+		return out.good();
+	}
+
+	std::string census::to_string() const noexcept {
+		std::stringstream ss;
+		ss << "Pegs\tPositions\tDead Ends\tWinnable\tOn Disk" << std::endl;
+
+		std::uint64_t states = 0, dead = 0, winnable = 0, bytes = 0;
+		for (const auto& level : _counts) {
+			ss << level.pegs << "\t" << level.states << "\t\t" << level.dead_ends << "\t\t" << level.winnable << "\t\t";
+			if (level.file_bytes > 0) ss << level.file_bytes << " bytes";
+			ss << std::endl;
+
+			states += level.states;
+			dead += level.dead_ends;
+			winnable += level.winnable;
+			bytes += level.file_bytes;
+		}
+
+		ss << std::endl;
+		ss << "Total Positions: " << states << ", Dead Ends: " << dead << ", Winnable: " << winnable << std::endl;
+		ss << "Positions that are the same under one of the board's " << _symmetries.size() << " symmetries are counted once" << std::endl;
+		if (bytes > 0)
+			ss << "Spilled to Disk: " << bytes << " bytes" << std::endl;
+		return ss.str();
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	std::string census::_file(const std::string& name) const {
+		return (std::filesystem::path(_work_dir) / name).string();
+	}
+
+	bool census::_fit_memory() {
+		while (true) {
+			std::uint64_t used = 0;
+			state_set* largest = nullptr;
+			std::string name;
+
+			for (std::size_t k = 0; k < _levels.size(); k++) {
+				for (auto* set : { &_levels[k], k < _winnable.size() ? &_winnable[k] : nullptr }) {
+					if (set == nullptr || set->on_disk()) continue;
+					used += set->size() * sizeof(t_state);
+					if (largest == nullptr || set->size() > largest->size()) {
+						largest = set;
+						name = (set == &_levels[k] ? "kept-level-" : "kept-winnable-") + std::to_string(k);
+					}
+				}
+			}
+
+			if (used <= _memory_limit / 2 || largest == nullptr) return true;
+			if (!largest->move_to_disk(_file(name))) return false;
+
+			for (std::size_t k = 0; k < _levels.size() && k < _counts.size(); k++) {
+				if (largest == &_levels[k])
+					_counts[k].file_bytes = largest->get_file_bytes();
+			}
+		}
+	}
+
+	void census::_clear() {
+		_levels.clear();
+		_winnable.clear();
+		_counts.clear();
+
+		if (_created_dir) {
+			std::error_code error;
+			std::filesystem::remove_all(_work_dir, error);
+			_created_dir = false;
+		}
+	}
+
+}
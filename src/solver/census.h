@@ -0,0 +1,158 @@
+/**
+ * @file census.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the census class, which lists every position reachable from a start.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_CENSUS__
+#define __H_TRIANGLE_SOLVER_CENSUS__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../include/abstract/printable.h"
+
+#include "jump_table.h"
+#include "symmetry_group.h"
+#include "state_set.h"
+
+namespace TriangleGame {
+
+	const std::size_t CENSUS_DEFAULT_MEMORY = (std::size_t)1 << 30; //!< The default memory limit of a census, 1 GiB.
+
+	/**
+	 * @brief The counts of one level of a census.
+	 */
+	struct census_level {
+		int pegs; //!< The number of pegs on the board.
+		std::uint64_t states; //!< The number of positions.
+		std::uint64_t dead_ends; //!< The number of positions with no jumps left.
+		std::uint64_t winnable; //!< The number of positions that can still finish with one peg.
+		std::uint64_t file_bytes; //!< The size of the level's file, 0 when it was kept in memory.
+	};
+
+	/**
+	 * @brief The Census Class, lists every position reachable from a start, level by level.
+	 *
+	 * Level k holds the positions with k jumps made. Each level is built from the one
+	 * before by making every jump, canonicalizing the result under the board's symmetries,
+	 * and sorting and merging the results with a state_set_writer, which spills to delta
+	 * encoded files once the memory limit is reached. The levels are then walked backwards:
+	 * a position is winnable when it has one peg, or one of its jumps leads to a winnable
+	 * position, which is found by undoing every jump of the next level's winnable positions
+	 * and merging them with the level. Nothing is ever looked up at random, so the state
+	 * space only has to fit on disk.
+	 *
+	 * Counts are of canonical positions, each symmetry class of positions is counted once.
+	 */
+	class census : public abstract::printable {
+		public:
+			/**
+			 * @brief Construct a new census of the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the census.
+			 */
+			census(const jump_table& table);
+
+			/**
+			 * @brief Destroy the census, and delete its files.
+			 */
+			~census();
+
+			/**
+			 * @brief Sets the most memory used to hold positions, past it levels are spilled to disk.
+			 *
+			 * @param bytes The memory limit.
+			 */
+			void set_memory_limit(std::size_t bytes) noexcept;
+
+			/**
+			 * @brief Sets the directory the levels are spilled to.
+			 *
+			 * @param dir The directory, the system's temporary directory is used when empty.
+			 */
+			void set_work_dir(const std::string& dir);
+
+			/**
+			 * @brief Lists every position reachable from the given start.
+			 *
+			 * @param start The starting position.
+			 * @return true If the census finished.
+			 * @return false If the work directory could not be written.
+			 */
+			bool run(t_state start);
+
+			/**
+			 * @brief Returns the counts of each level.
+			 *
+			 * @return const std::vector<census_level>& The levels, in the order they were reached.
+			 */
+			const std::vector<census_level>& get_levels() const noexcept;
+
+			/**
+			 * @brief Returns the board's symmetries.
+			 *
+			 * @return const symmetry_group& The symmetries positions are canonicalized by.
+			 */
+			const symmetry_group& get_symmetries() const noexcept;
+
+			/**
+			 * @brief Writes every position of the last run to a text file, one per line:
+			 * the position in hex (bit n is hole n + 1), its peg count, and "W" when it is
+			 * winnable, "D" when it is a dead end, or "-".
+			 *
+			 * @param path The file to write.
+			 * @return true If the file was written.
+			 * @return false Otherwise.
+			 */
+			bool export_states(const std::string& path) const;
+
+			/**
+			 * @brief Creates a table of the counts of each level.
+			 *
+			 * @return std::string The string representation of the census.
+			 */
+			std::string to_string() const noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			symmetry_group _symmetries; //!< The board's symmetries.
+			std::size_t _memory_limit; //!< The most memory used to hold positions.
+			std::string _work_dir; //!< The directory levels are spilled to.
+			bool _created_dir; //!< True when the census created its work directory.
+			std::vector<census_level> _counts; //!< The counts of each level.
+			std::vector<state_set> _levels; //!< The positions of each level.
+			std::vector<state_set> _winnable; //!< The winnable positions of each level.
+
+			/**
+			 * @brief Returns the path of a file in the work directory.
+			 *
+			 * @param name The name of the file.
+			 * @return std::string The path.
+			 */
+			std::string _file(const std::string& name) const;
+
+			/**
+			 * @brief Moves kept sets to disk until the ones in memory fit the memory limit.
+			 *
+			 * @return true If the sets fit.
+			 * @return false If a set could not be written.
+			 */
+			bool _fit_memory();
+
+			/**
+			 * @brief Deletes every level, and the work directory.
+			 */
+			void _clear();
+	};
+
+}
+
+#endif
@@ -0,0 +1,180 @@
+#include "chain_solver.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+#include <climits>
+#include <sstream>
+
+namespace TriangleGame {
+
+	chain_solver::chain_solver(const jump_table& table)
+		: _table(table), _symmetries(table), _stop(nullptr), _stopped(false), _nodes(0), _lone_holes(table.get_full_state()),
+		_jumps_from(table.get_hole_count()), _memory_limit(0)
+	{
+		const auto& jumps = _table.get_jumps();
+		for (t_jump_id id = 0; id < (t_jump_id)jumps.size(); id++) {
+			_lone_holes &= ~((t_state)1 << jumps[id].over);
+			_jumps_from[jumps[id].from].push_back(id);
+		}
+	}
+
+	void chain_solver::set_stop_flag(const std::atomic<bool>* stop) noexcept {
+		_stop = stop;
+	}
+
+	void chain_solver::set_memory_limit(std::size_t bytes) noexcept {
+		_memory_limit = bytes;
+	}
+
+	bool chain_solver::solve(t_state s, std::vector<t_chain>& chains) {
+		_stopped = false;
+		_nodes = 0;
+		_needed = decltype(_needed)();
+		_needed.set_limit(_memory_limit);
+		_memory_events.clear();
+		if (_memory_limit != 0 && _needed.get_max_slots() == 0)
+			_memory_events.push_back("The memory limit leaves no room for any position, searching without a table");
+		_bounds.clear();
+		_path.clear();
+		chains.clear();
+
+		int bound = _estimate(s, CHAIN_NONE);
+		while (true) {
+			TRIANGLE_TRACE("chain_solver::iteration", bound);
+			_bounds.push_back(bound);
+			int result = _search(s, CHAIN_NONE, 0, bound);
+			if (_stopped || result == INT_MAX) return false;
+			if (result <= bound) break;
+			bound = result;
+		}
+
+		//a jump starts a new move unless the same peg made the last one
+		const auto& jumps = _table.get_jumps();
+		for (std::size_t i = 0; i < _path.size(); i++) {
+			if (i == 0 || jumps[_path[i]].from != jumps[_path[i - 1]].to)
+				chains.push_back(t_chain());
+			chains.back().push_back(_path[i]);
+		}
+		return true;
+	}
+
+	bool chain_solver::was_stopped() const noexcept {
+		return _stopped;
+	}
+
+	const std::vector<int>& chain_solver::get_bounds() const noexcept {
+		return _bounds;
+	}
+
+	std::uint64_t chain_solver::get_nodes() const noexcept {
+		return _nodes;
+	}
+
+	std::size_t chain_solver::get_table_size() const noexcept {
+		return _needed.size();
+	}
+
+	std::size_t chain_solver::get_memory_used() const noexcept {
+		return _needed.get_bytes();
+	}
+
+	std::size_t chain_solver::get_peak_memory() const noexcept {
+		return _needed.get_peak_bytes();
+	}
+
+	const std::vector<std::string>& chain_solver::get_memory_events() const noexcept {
+		return _memory_events;
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	int chain_solver::_search(t_state s, int chain, int moves, int bound) {
+		if (_should_stop()) return INT_MAX;
+		if (jump_table::count_pegs(s) == 1) return moves;
+
+		chain = _live_chain(s, chain);
+		auto key = _key(s, chain);
+		const int* found = _needed.find(key);
+		int needed = std::max(_estimate(s, chain), found == nullptr ? 0 : *found);
+		if (needed == INT_MAX) return INT_MAX;
+		if (moves + needed > bound) return moves + needed;
+
+		//the chain's jumps are free, so they are tried first
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+		int n = _table.get_legal_jumps(s, legal);
+		if (chain != CHAIN_NONE)
+			std::stable_partition(legal, legal + n, [&](t_jump_id id) { return jumps[id].from == chain; });
+
+		int over = INT_MAX;
+		for (int i = 0; i < n; i++) {
+			const auto& j = jumps[legal[i]];
+			_path.push_back(legal[i]);
+			int result = _search(s ^ j.flip, j.to, moves + (j.from == chain ? 0 : 1), bound);
+			if (result <= bound) return result;
+			_path.pop_back();
+
+			if (_stopped) return INT_MAX;
+			over = std::min(over, result);
+		}
+
+		//every finish under the bound was searched, so the position needs at least the smallest cost over it,
+		//and it is looked up again as the search below may have replaced it
+		int shown = over == INT_MAX ? INT_MAX : over - moves;
+		int* stored = _needed.find(key);
+		if (stored != nullptr)
+			*stored = std::max(*stored, shown);
+		else
+			_store(key, shown);
+		return over;
+	}
+
+	void chain_solver::_store(const chain_key& key, int needed) {
+		bool full = _needed.is_full();
+		_needed.store(key, needed);
+		if (full || !_needed.is_full()) return;
+
+		std::stringstream ss;
+		ss << "At " << _nodes << " nodes, the table filled up with " << _needed.size()
+			<< " positions, and new positions now replace ones with fewer pegs";
+		_memory_events.push_back(ss.str());
+	}
+
+	int chain_solver::_live_chain(t_state s, int chain) const noexcept {
+		if (chain == CHAIN_NONE) return CHAIN_NONE;
+		for (auto id : _jumps_from[chain]) {
+			const auto& j = _table.get_jumps()[id];
+			if ((s & j.need) == j.need && (s & j.target) == 0) return chain;
+		}
+		return CHAIN_NONE;
+	}
+
+	int chain_solver::_estimate(t_state s, int chain) const noexcept {
+		t_state lone = s & _lone_holes;
+		if (chain != CHAIN_NONE) lone &= ~((t_state)1 << chain);
+
+		int starts = jump_table::count_pegs(lone) - 1;
+		int pegs = jump_table::count_pegs(s);
+		return std::max({ 0, starts, pegs > 1 && chain == CHAIN_NONE ? 1 : 0 });
+	}
+
+	chain_key chain_solver::_key(t_state s, int chain) const noexcept {
+		auto best = chain_key{ s, chain };
+		const auto& maps = _symmetries.get_maps();
+		for (int k = 1; k < _symmetries.size(); k++) {
+			auto mapped = chain_key{ _symmetries.apply(s, k), chain == CHAIN_NONE ? CHAIN_NONE : maps[k][chain] };
+			if (mapped.state < best.state || (mapped.state == best.state && mapped.chain < best.chain))
+				best = mapped;
+		}
+		return best;
+	}
+
+	bool chain_solver::_should_stop() {
+		if ((++_nodes & 0x3FFF) == 0 && _stop != nullptr && _stop->load(std::memory_order_relaxed))
+			_stopped = true;
+		return _stopped;
+	}
+
+}
@@ -0,0 +1,227 @@
+/**
+ * @file chain_solver.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the chain_solver class, which finds a single peg finish in the fewest moves, counting a chain of jumps by one peg as one move.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_CHAIN_SOLVER__
+#define __H_TRIANGLE_SOLVER_CHAIN_SOLVER__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bounded_table.h"
+#include "jump_table.h"
+#include "symmetry_group.h"
+
+namespace TriangleGame {
+
+	typedef std::vector<t_jump_id> t_chain; //!< A move, one or more jumps in a row by the same peg.
+
+	const int CHAIN_NONE = -1; //!< The chain hole of a position where the last peg to jump can not jump again.
+
+	/**
+	 * @brief A position of a chain search, and the hole of the peg that can carry on its chain.
+	 */
+	struct chain_key {
+		t_state state; //!< The position.
+		int chain; //!< The hole of the last peg to jump, or CHAIN_NONE.
+
+		bool operator==(const chain_key& other) const noexcept {
+			return state == other.state && chain == other.chain;
+		}
+	};
+
+	/**
+	 * @brief Returns the position of a chain_key, for the table.
+	 */
+	inline t_state key_state(const chain_key& k) noexcept {
+		return k.state;
+	}
+
+	/**
+	 * @brief Hashes a chain_key.
+	 */
+	struct chain_key_hash {
+		std::size_t operator()(const chain_key& k) const noexcept {
+			return state_hash()(k.state ^ ((t_state)(k.chain + 1) << 58));
+		}
+	};
+
+	/**
+	 * @brief The Chain Solver Class, finds a sequence of moves that leaves a single peg,
+	 * with the fewest moves, where a move is any number of jumps in a row by the same peg.
+	 *
+	 * A jump by the peg that made the last jump carries on its move for free, any other
+	 * jump starts a new one, so a position's cost to finish depends on which peg jumped
+	 * last. Positions are searched with that hole, the chain, and the chain is dropped
+	 * when its peg has no jump left, so positions that only differ by a spent chain are
+	 * the same. The search is iterative deepening A*: depth first, under a bound on the
+	 * moves, that is raised to the smallest cost that went over it until a finish is found.
+	 *
+	 * The lower bound on the moves left counts the pegs in holes that no jump goes over,
+	 * such as the corners of the triangle. Such a peg can only leave by jumping itself,
+	 * and each one is a different peg, so each starts its own move, other than the peg
+	 * carrying on the chain, and the last peg, which may never move. A position with more
+	 * than one peg and no chain to carry on needs at least one more move.
+	 *
+	 * The transposition table keeps, for each position and chain, canonicalized under the
+	 * board's symmetries, the most moves it has been shown to need: once every move under
+	 * the bound has been searched from it, it needs at least the smallest cost over the
+	 * bound. The bound of a position that is visited again is then raised straight away,
+	 * in this and every later iteration. Under a memory limit, once the table is full a new
+	 * position replaces one with fewer pegs, like the solver's, which only costs the search
+	 * the bounds it had raised.
+	 */
+	class chain_solver {
+		public:
+			/**
+			 * @brief Construct a new chain solver for the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the solver.
+			 */
+			chain_solver(const jump_table& table);
+
+			/**
+			 * @brief Sets a flag that stops the search when it becomes true.
+			 *
+			 * @param stop The flag to check, or nullptr to never stop.
+			 */
+			void set_stop_flag(const std::atomic<bool>* stop) noexcept;
+
+			/**
+			 * @brief Sets the most memory the transposition table can use.
+			 *
+			 * @param bytes The memory limit, or 0 for no limit.
+			 */
+			void set_memory_limit(std::size_t bytes) noexcept;
+
+			/**
+			 * @brief Finds the sequence of moves with the fewest moves from the given position that leaves a single peg.
+			 *
+			 * @param s The position to start from.
+			 * @param chains The returned moves, each the jumps of one peg, in the order they are made.
+			 * @return true If a sequence was found.
+			 * @return false If no sequence leaves a single peg, or the search was stopped.
+			 */
+			bool solve(t_state s, std::vector<t_chain>& chains);
+
+			/**
+			 * @brief Determinds if the last search was stopped before it finished.
+			 *
+			 * @return true If the search was stopped.
+			 * @return false Otherwise.
+			 */
+			bool was_stopped() const noexcept;
+
+			/**
+			 * @brief Returns the bound of each iteration of the last search.
+			 *
+			 * @return const std::vector<int>& The bounds, in moves.
+			 */
+			const std::vector<int>& get_bounds() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions expanded by the last search.
+			 *
+			 * @return std::uint64_t The number of positions expanded.
+			 */
+			std::uint64_t get_nodes() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions in the transposition table.
+			 *
+			 * @return std::size_t The number of positions stored.
+			 */
+			std::size_t get_table_size() const noexcept;
+
+			/**
+			 * @brief Returns the memory the transposition table is using.
+			 *
+			 * @return std::size_t The memory, in bytes.
+			 */
+			std::size_t get_memory_used() const noexcept;
+
+			/**
+			 * @brief Returns the most memory the transposition table used in the last search.
+			 *
+			 * @return std::size_t The peak memory, in bytes.
+			 */
+			std::size_t get_peak_memory() const noexcept;
+
+			/**
+			 * @brief Returns a line for each step the last search was degraded by, to stay in the memory limit.
+			 *
+			 * @return const std::vector<std::string>& The steps, in the order they happened.
+			 */
+			const std::vector<std::string>& get_memory_events() const noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			symmetry_group _symmetries; //!< The board's symmetries.
+			const std::atomic<bool>* _stop; //!< Stops the search when true.
+			bool _stopped; //!< True when the last search was stopped.
+			std::uint64_t _nodes; //!< The number of positions expanded.
+			t_state _lone_holes; //!< The holes no jump goes over.
+			std::vector<std::vector<t_jump_id>> _jumps_from; //!< The jumps of the peg in each hole.
+			bounded_table<chain_key, int, chain_key_hash> _needed; //!< The most moves each position has been shown to need.
+			std::vector<int> _bounds; //!< The bound of each iteration.
+			std::vector<t_jump_id> _path; //!< The jumps made to reach the position being searched.
+			std::size_t _memory_limit; //!< The most memory the table can use, 0 for no limit.
+			std::vector<std::string> _memory_events; //!< The steps the search was degraded by.
+
+			/**
+			 * @brief Searches a position under a bound.
+			 *
+			 * @param s The position.
+			 * @param chain The hole of the peg that can carry on its move, or CHAIN_NONE.
+			 * @param moves The moves made to reach it.
+			 * @param bound The most moves a finish can take.
+			 * @return int The moves of a finish, when it is within the bound, and the
+			 * smallest cost over the bound otherwise, INT_MAX when there is no finish.
+			 */
+			int _search(t_state s, int chain, int moves, int bound);
+
+			/**
+			 * @brief Returns the chain hole, or CHAIN_NONE when the peg in it has no jump left.
+			 */
+			int _live_chain(t_state s, int chain) const noexcept;
+
+			/**
+			 * @brief Returns the fewest moves a position can finish in, from its pegs alone.
+			 */
+			int _estimate(t_state s, int chain) const noexcept;
+
+			/**
+			 * @brief Returns the key of a position and its chain, under the symmetry that makes the position canonical.
+			 */
+			chain_key _key(t_state s, int chain) const noexcept;
+
+			/**
+			 * @brief Stores a position in the table, noting when the table has filled up to the memory limit.
+			 *
+			 * @param key The position and its chain.
+			 * @param needed The most moves it has been shown to need.
+			 */
+			void _store(const chain_key& key, int needed);
+
+			/**
+			 * @brief Counts the node, and checks the stop flag every so often.
+			 *
+			 * @return true If the search should stop.
+			 * @return false Otherwise.
+			 */
+			bool _should_stop();
+	};
+
+}
+
+#endif
@@ -0,0 +1,407 @@
+#include "distributed_solver.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace TriangleGame {
+
+	namespace {
+
+		const std::uint32_t END_OF_LEVEL = 0xffffffff; //!< The batch header that marks the end of a worker's level.
+		const std::size_t PEER_MAX_PENDING = 1 << 20; //!< The most unsent bytes queued for a worker, before waiting for it.
+		const std::size_t PEER_READ_BYTES = 1 << 16; //!< The most bytes read from a worker at once.
+		const std::size_t REPORT_WORDS = 7; //!< The numbers a worker reports at the end of each level.
+		const std::uint64_t COMMAND_STOP = 0; //!< Tells the workers the search is finished.
+		const std::uint64_t COMMAND_CONTINUE = 1; //!< Tells the workers to search the next level.
+
+		/**
+		 * @brief A socket to another worker, with the bytes waiting to be sent to it and received from it.
+		 */
+		struct peer_channel {
+			int fd; //!< The socket, -1 for the worker itself.
+			std::vector<char> out; //!< The batches not yet sent.
+			std::size_t written; //!< The bytes of out already sent.
+			std::vector<char> in; //!< The bytes received, that are not yet a whole batch.
+			bool ended; //!< True once the worker's end of level mark is received.
+		};
+
+		bool write_all(int fd, const void* data, std::size_t bytes) {
+			const char* p = (const char*)data;
+			while (bytes > 0) {
+				ssize_t n = send(fd, p, bytes, MSG_NOSIGNAL);
+				if (n < 0 && errno == EINTR) continue;
+				if (n <= 0) return false;
+				p += n;
+				bytes -= (std::size_t)n;
+			}
+			return true;
+		}
+
+		bool read_all(int fd, void* data, std::size_t bytes) {
+			char* p = (char*)data;
+			while (bytes > 0) {
+				ssize_t n = recv(fd, p, bytes, 0);
+				if (n < 0 && errno == EINTR) continue;
+				if (n <= 0) return false;
+				p += n;
+				bytes -= (std::size_t)n;
+			}
+			return true;
+		}
+
+		void queue_batch(peer_channel& peer, std::uint32_t count, const t_state* states) {
+			std::size_t bytes = count == END_OF_LEVEL ? 0 : count * sizeof(t_state);
+			std::size_t at = peer.out.size();
+			peer.out.resize(at + sizeof(count) + bytes);
+			std::memcpy(peer.out.data() + at, &count, sizeof(count));
+			if (bytes > 0)
+				std::memcpy(peer.out.data() + at + sizeof(count), states, bytes);
+		}
+
+	}
+
+	distributed_solver::distributed_solver(const jump_table& table)
+		: _table(table), _symmetries(table), _worker_count(1), _batch_size(DISTRIBUTED_DEFAULT_BATCH), _best(0), _seconds(0)
+	{
+
+	}
+
+	void distributed_solver::set_workers(unsigned workers) noexcept {
+		_worker_count = std::clamp(workers, 1u, DISTRIBUTED_MAX_WORKERS);
+	}
+
+	void distributed_solver::set_batch_size(std::size_t states) noexcept {
+		_batch_size = std::max<std::size_t>(states, 1);
+	}
+
+	bool distributed_solver::run(t_state start) {
+		_levels.clear();
+		_workers.assign(_worker_count, distributed_worker{});
+		_best = jump_table::count_pegs(start);
+		auto started = std::chrono::steady_clock::now();
+
+		//a socket to each worker, and one between every pair of workers
+		unsigned n = _worker_count;
+		auto coordinator = std::vector<int>(2 * n, -1);
+		auto mesh = std::vector<std::vector<int>>(n, std::vector<int>(n, -1));
+		auto close_all = [&]() {
+			for (auto& fd : coordinator) {
+				if (fd >= 0) close(fd);
+				fd = -1;
+			}
+			for (auto& row : mesh) {
+				for (auto& fd : row) {
+					if (fd >= 0) close(fd);
+					fd = -1;
+				}
+			}
+		};
+
+		bool opened = true;
+		for (unsigned r = 0; r < n && opened; r++) {
+			opened = socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, &coordinator[2 * r]) == 0;
+			for (unsigned p = r + 1; p < n && opened; p++) {
+				int pair[2];
+				opened = socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) == 0;
+				if (opened) {
+					mesh[r][p] = pair[0];
+					mesh[p][r] = pair[1];
+				}
+			}
+		}
+		if (!opened) {
+			close_all();
+			return false;
+		}
+
+		auto pids = std::vector<pid_t>();
+		for (unsigned r = 0; r < n; r++) {
+			pid_t pid = fork();
+			if (pid < 0) break;
+			if (pid == 0) {
+				//the worker keeps its own sockets, and closes the rest
+				for (unsigned k = 0; k < n; k++) {
+					close(coordinator[2 * k]);
+					if (k != r) close(coordinator[2 * k + 1]);
+					for (unsigned p = 0; p < n; p++) {
+						if (k != r && mesh[k][p] >= 0) close(mesh[k][p]);
+					}
+				}
+				_exit(_work(r, start, coordinator[2 * r + 1], mesh[r]) ? 0 : 1);
+			}
+			pids.push_back(pid);
+		}
+
+		//the coordinator keeps its end of each worker's socket
+		for (unsigned r = 0; r < n; r++) {
+			close(coordinator[2 * r + 1]);
+			coordinator[2 * r + 1] = -1;
+		}
+		for (auto& row : mesh) {
+			for (auto& fd : row) {
+				if (fd >= 0) close(fd);
+				fd = -1;
+			}
+		}
+
+		bool finished = pids.size() == n;
+		for (int pegs = jump_table::count_pegs(start); finished; pegs--) {
+			TRIANGLE_TRACE("distributed_solver::level", pegs);
+			auto level = distributed_level{ pegs, 0, 0 };
+			std::uint64_t next = 0;
+
+			for (unsigned r = 0; r < n && finished; r++) {
+				std::uint64_t report[REPORT_WORDS];
+				finished = read_all(coordinator[2 * r], report, sizeof(report));
+				if (!finished) break;
+
+				level.states += report[0];
+				level.dead_ends += report[1];
+				next += report[2];
+
+				auto& w = _workers[r];
+				w.owned += report[0];
+				w.peak_states = report[3];
+				w.sent = report[4];
+				w.received = report[5];
+				w.batches = report[6];
+			}
+			if (!finished) break;
+
+			_levels.push_back(level);
+			if (level.dead_ends > 0) _best = pegs;
+
+			std::uint64_t command = next == 0 ? COMMAND_STOP : COMMAND_CONTINUE;
+			for (unsigned r = 0; r < n && finished; r++)
+				finished = write_all(coordinator[2 * r], &command, sizeof(command));
+			if (command == COMMAND_STOP) break;
+		}
+
+		if (!finished) {
+			for (auto pid : pids) kill(pid, SIGKILL);
+		}
+		close_all();
+
+		for (auto pid : pids) {
+			int status;
+			while (waitpid(pid, &status, 0) < 0 && errno == EINTR);
+			finished = finished && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+		}
+
+		_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+		return finished;
+	}
+
+	int distributed_solver::get_best() const noexcept {
+		return _best;
+	}
+
+	const std::vector<distributed_level>& distributed_solver::get_levels() const noexcept {
+		return _levels;
+	}
+
+	const std::vector<distributed_worker>& distributed_solver::get_workers() const noexcept {
+		return _workers;
+	}
+
+	double distributed_solver::get_seconds() const noexcept {
+		return _seconds;
+	}
+
+	std::string distributed_solver::to_string() const noexcept {
+		std::stringstream ss;
+		ss << "Pegs\tPositions\tDead Ends" << std::endl;
+
+		std::uint64_t states = 0, dead = 0;
+		for (const auto& level : _levels) {
+			ss << level.pegs << "\t" << level.states << "\t\t" << level.dead_ends << std::endl;
+			states += level.states;
+			dead += level.dead_ends;
+		}
+
+		ss << std::endl;
+		ss << "Total Positions: " << states << ", Dead Ends: " << dead << std::endl;
+		ss << "Fewest Pegs Left: " << _best << std::endl << std::endl;
+
+		ss << "Worker\tOwned\t\tPeak Held\tSent\t\tReceived\tBatches" << std::endl;
+		for (std::size_t r = 0; r < _workers.size(); r++) {
+			const auto& w = _workers[r];
+			ss << r + 1 << "\t" << w.owned << "\t\t" << w.peak_states << "\t\t" << w.sent << "\t\t" << w.received << "\t\t" << w.batches << std::endl;
+		}
+
+		ss << std::endl;
+		ss << "Workers: " << _workers.size() << ", Seconds: " << _seconds << std::endl;
+		return ss.str();
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	bool distributed_solver::_work(unsigned rank, t_state start, int coordinator, const std::vector<int>& peers) const {
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+
+		auto channels = std::vector<peer_channel>(peers.size());
+		for (std::size_t p = 0; p < peers.size(); p++) {
+			channels[p] = { peers[p], {}, 0, {}, false };
+			if (peers[p] >= 0) fcntl(peers[p], F_SETFL, fcntl(peers[p], F_GETFL) | O_NONBLOCK);
+		}
+
+		auto frontier = std::vector<t_state>();
+		auto next = std::vector<t_state>();
+		std::uint64_t peak = 0, sent = 0, received = 0, batches = 0;
+		std::size_t unique = 0;
+
+		//duplicates are merged whenever the level doubles, so they never pile up
+		auto keep = [&](t_state s) {
+			next.push_back(s);
+			if (next.size() >= std::max<std::size_t>(2 * unique, 1 << 16)) {
+				std::sort(next.begin(), next.end());
+				next.erase(std::unique(next.begin(), next.end()), next.end());
+				unique = next.size();
+			}
+			peak = std::max<std::uint64_t>(peak, frontier.size() + next.size());
+		};
+
+		//sends what each worker will take, and keeps whatever has arrived
+		auto pump = [&](bool wait) {
+			auto fds = std::vector<pollfd>();
+			auto index = std::vector<std::size_t>();
+			for (std::size_t p = 0; p < channels.size(); p++) {
+				if (channels[p].fd < 0) continue;
+				short events = POLLIN;
+				if (channels[p].written < channels[p].out.size()) events |= POLLOUT;
+				fds.push_back({ channels[p].fd, events, 0 });
+				index.push_back(p);
+			}
+			if (fds.empty()) return true;
+
+			int ready = poll(fds.data(), fds.size(), wait ? -1 : 0);
+			if (ready < 0) return errno == EINTR;
+
+			char buffer[PEER_READ_BYTES];
+			for (std::size_t i = 0; i < fds.size(); i++) {
+				auto& c = channels[index[i]];
+
+				if (fds[i].revents & POLLOUT) {
+					ssize_t n = send(c.fd, c.out.data() + c.written, c.out.size() - c.written, MSG_NOSIGNAL);
+					if (n < 0 && errno != EAGAIN && errno != EINTR) return false;
+					if (n > 0) c.written += (std::size_t)n;
+					if (c.written == c.out.size()) {
+						c.out.clear();
+						c.written = 0;
+					}
+				}
+
+				if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+					ssize_t n = recv(c.fd, buffer, sizeof(buffer), 0);
+					if (n == 0) return false;
+					if (n < 0 && errno != EAGAIN && errno != EINTR) return false;
+					if (n > 0) c.in.insert(c.in.end(), buffer, buffer + n);
+
+					//keep every whole batch
+					std::size_t at = 0;
+					while (c.in.size() - at >= sizeof(std::uint32_t)) {
+						std::uint32_t count;
+						std::memcpy(&count, c.in.data() + at, sizeof(count));
+						if (count == END_OF_LEVEL) {
+							c.ended = true;
+							at += sizeof(count);
+							continue;
+						}
+						if (c.in.size() - at < sizeof(count) + count * sizeof(t_state)) break;
+
+						at += sizeof(count);
+						for (std::uint32_t k = 0; k < count; k++, at += sizeof(t_state)) {
+							t_state s;
+							std::memcpy(&s, c.in.data() + at, sizeof(s));
+							keep(s);
+						}
+						received += count;
+					}
+					c.in.erase(c.in.begin(), c.in.begin() + at);
+				}
+			}
+			return true;
+		};
+
+		auto batch = std::vector<std::vector<t_state>>(peers.size());
+		auto flush = [&](unsigned p) {
+			if (batch[p].empty()) return true;
+			queue_batch(channels[p], (std::uint32_t)batch[p].size(), batch[p].data());
+			sent += batch[p].size();
+			batches++;
+			batch[p].clear();
+
+			//a worker that has fallen behind is waited for, so nothing queues without bound
+			if (!pump(false)) return false;
+			while (channels[p].out.size() - channels[p].written > PEER_MAX_PENDING) {
+				if (!pump(true)) return false;
+			}
+			return true;
+		};
+
+		t_state first = _symmetries.canonical(start);
+		if (_owner(first) == rank) frontier.push_back(first);
+
+		while (true) {
+			next.clear();
+			unique = 0;
+			std::uint64_t dead = 0;
+
+			for (t_state s : frontier) {
+				int count = _table.get_legal_jumps(s, legal);
+				dead += count == 0;
+				for (int i = 0; i < count; i++) {
+					t_state c = _symmetries.canonical(s ^ jumps[legal[i]].flip);
+					unsigned owner = _owner(c);
+					if (owner == rank) {
+						keep(c);
+					} else {
+						batch[owner].push_back(c);
+						if (batch[owner].size() >= _batch_size && !flush(owner)) return false;
+					}
+				}
+			}
+
+			//the end marks follow every batch, so once each worker's is in, the level is whole
+			for (unsigned p = 0; p < channels.size(); p++) {
+				if (channels[p].fd < 0) continue;
+				if (!flush(p)) return false;
+				queue_batch(channels[p], END_OF_LEVEL, nullptr);
+			}
+			while (true) {
+				bool done = true;
+				for (const auto& c : channels) {
+					if (c.fd >= 0 && (!c.ended || c.written < c.out.size())) done = false;
+				}
+				if (done) break;
+				if (!pump(true)) return false;
+			}
+			for (auto& c : channels) c.ended = false;
+
+			std::sort(next.begin(), next.end());
+			next.erase(std::unique(next.begin(), next.end()), next.end());
+
+			std::uint64_t report[REPORT_WORDS] = { frontier.size(), dead, next.size(), peak, sent, received, batches };
+			std::uint64_t command;
+			if (!write_all(coordinator, report, sizeof(report)) || !read_all(coordinator, &command, sizeof(command))) return false;
+			if (command == COMMAND_STOP) return true;
+
+			frontier.swap(next);
+		}
+	}
+
+}
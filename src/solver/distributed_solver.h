@@ -0,0 +1,173 @@
+/**
+ * @file distributed_solver.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the distributed_solver class, which splits a breadth first solve across worker processes.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_DISTRIBUTED_SOLVER__
+#define __H_TRIANGLE_SOLVER_DISTRIBUTED_SOLVER__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../include/abstract/printable.h"
+
+#include "jump_table.h"
+#include "symmetry_group.h"
+
+namespace TriangleGame {
+
+	const std::size_t DISTRIBUTED_DEFAULT_BATCH = 4096; //!< The default number of positions sent to another worker at once.
+	const unsigned DISTRIBUTED_MAX_WORKERS = 64; //!< The most worker processes a solve can be split across.
+
+	/**
+	 * @brief The counts of one level of a distributed solve.
+	 */
+	struct distributed_level {
+		int pegs; //!< The number of pegs on the board.
+		std::uint64_t states; //!< The number of positions.
+		std::uint64_t dead_ends; //!< The number of positions with no jumps left.
+	};
+
+	/**
+	 * @brief The work done by one worker of a distributed solve.
+	 */
+	struct distributed_worker {
+		std::uint64_t owned; //!< The number of positions the worker owned, over every level.
+		std::uint64_t peak_states; //!< The most positions the worker held at once.
+		std::uint64_t sent; //!< The number of positions sent to other workers.
+		std::uint64_t received; //!< The number of positions received from other workers.
+		std::uint64_t batches; //!< The number of batches sent to other workers.
+	};
+
+	/**
+	 * @brief The Distributed Solver Class, finds the fewest pegs that can be left by splitting
+	 * a breadth first search of every position across worker processes.
+	 *
+	 * Each canonical position is owned by one worker, picked by a hash of the position, and
+	 * only its owner stores and expands it. The search goes a level at a time: each worker
+	 * makes every jump of the positions it owns, keeps the results it owns, and sends the
+	 * rest to their owners in batches, over a socket between every pair of workers. When a
+	 * worker has expanded its positions it sends an end of level mark to every other worker,
+	 * and the level is done once it has the marks of all of them, since each socket keeps
+	 * its order. The coordinator, the calling process, then gathers the counts of every
+	 * worker, and stops the search at the first level no worker has any positions in.
+	 *
+	 * Since every game ends in a dead end, the fewest pegs that can be left is the fewest
+	 * pegs of any dead end reached, so one pass forward is enough.
+	 * Workers are forked from the calling process, so the solve must be started before any
+	 * other threads are.
+	 */
+	class distributed_solver : public abstract::printable {
+		public:
+			/**
+			 * @brief Construct a new distributed solver of the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the solver.
+			 */
+			distributed_solver(const jump_table& table);
+
+			/**
+			 * @brief Sets the number of worker processes.
+			 *
+			 * @param workers The number of workers, from 1 to DISTRIBUTED_MAX_WORKERS.
+			 */
+			void set_workers(unsigned workers) noexcept;
+
+			/**
+			 * @brief Sets the number of positions sent to another worker at once.
+			 *
+			 * @param states The batch size.
+			 */
+			void set_batch_size(std::size_t states) noexcept;
+
+			/**
+			 * @brief Searches every position reachable from the given start.
+			 *
+			 * @param start The starting position.
+			 * @return true If the search finished.
+			 * @return false If the workers could not be started, or one of them failed.
+			 */
+			bool run(t_state start);
+
+			/**
+			 * @brief Returns the fewest pegs that can be left from the start.
+			 *
+			 * @return int The number of pegs.
+			 */
+			int get_best() const noexcept;
+
+			/**
+			 * @brief Returns the counts of each level.
+			 *
+			 * @return const std::vector<distributed_level>& The levels, in the order they were reached.
+			 */
+			const std::vector<distributed_level>& get_levels() const noexcept;
+
+			/**
+			 * @brief Returns the work done by each worker.
+			 *
+			 * @return const std::vector<distributed_worker>& The workers.
+			 */
+			const std::vector<distributed_worker>& get_workers() const noexcept;
+
+			/**
+			 * @brief Returns how long the last run took.
+			 *
+			 * @return double The seconds.
+			 */
+			double get_seconds() const noexcept;
+
+			/**
+			 * @brief Creates a table of the counts of each level, and of the work of each worker.
+			 *
+			 * @return std::string The string representation of the solve.
+			 */
+			std::string to_string() const noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			symmetry_group _symmetries; //!< The board's symmetries.
+			unsigned _worker_count; //!< The number of worker processes.
+			std::size_t _batch_size; //!< The number of positions sent at once.
+			int _best; //!< The fewest pegs that can be left.
+			double _seconds; //!< How long the last run took.
+			std::vector<distributed_level> _levels; //!< The counts of each level.
+			std::vector<distributed_worker> _workers; //!< The work done by each worker.
+
+			/**
+			 * @brief Runs one worker, until the coordinator stops it.
+			 *
+			 * @param rank The worker's index, it owns the positions that hash to it.
+			 * @param start The starting position.
+			 * @param coordinator The socket to the coordinator.
+			 * @param peers The sockets to every other worker, by index, -1 for itself.
+			 * @return true If the worker was stopped.
+			 * @return false If a socket failed.
+			 */
+			bool _work(unsigned rank, t_state start, int coordinator, const std::vector<int>& peers) const;
+
+			/**
+			 * @brief Returns the index of the worker that owns a canonical position.
+			 */
+			unsigned _owner(t_state s) const noexcept {
+				//mixed, since positions of a level share most of their bits
+				s ^= s >> 30;
+				s *= 0xbf58476d1ce4e5b9ULL;
+				s ^= s >> 27;
+				s *= 0x94d049bb133111ebULL;
+				s ^= s >> 31;
+				return (unsigned)(s % _worker_count);
+			}
+	};
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file fast_random.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the fast_random class, a small and fast pseudo random number generator.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_FAST_RANDOM__
+#define __H_TRIANGLE_SOLVER_FAST_RANDOM__
+
+#include <cstdint>
+
+namespace TriangleGame {
+
+	/**
+	 * @brief The Fast Random Class, a xoshiro256** generator seeded with splitmix64.
+	 * It is not cryptographically secure, but it is a handful of instructions per number,
+	 * which is what random playouts need.
+	 */
+	class fast_random {
+		public:
+			/**
+			 * @brief Construct a new generator from the given seed.
+			 * The same seed always produces the same sequence.
+			 *
+			 * @param seed The seed.
+			 */
+			fast_random(std::uint64_t seed) {
+				for (auto& s : _s)
+					s = split_mix(seed);
+			}
+
+			/**
+			 * @brief Returns the next random 64 bit number.
+			 *
+			 * @return std::uint64_t The random number.
+			 */
+			std::uint64_t next() noexcept {
+				std::uint64_t result = rotl(_s[1] * 5, 7) * 9;
+				std::uint64_t t = _s[1] << 17;
+
+				_s[2] ^= _s[0];
+				_s[3] ^= _s[1];
+				_s[1] ^= _s[2];
+				_s[0] ^= _s[3];
+				_s[2] ^= t;
+				_s[3] = rotl(_s[3], 45);
+
+				return result;
+			}
+
+			/**
+			 * @brief Returns a random number in the range [0, bound).
+			 * Uses a multiply and shift instead of a modulo.
+			 *
+			 * @param bound The upper bound, must be greater than zero.
+			 * @return std::uint32_t The random number.
+			 */
+			std::uint32_t bounded(std::uint32_t bound) noexcept {
+				return (std::uint32_t)(((next() >> 32) * bound) >> 32);
+			}
+
+			/**
+			 * @brief Advances the given state and returns the next splitmix64 number.
+			 * Used for seeding, and for deriving independent seeds from a single seed.
+			 *
+			 * @param state The splitmix64 state.
+			 * @return std::uint64_t The next number.
+			 */
+			static std::uint64_t split_mix(std::uint64_t& state) noexcept {
+				std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+				return z ^ (z >> 31);
+			}
+
+		private:
+			std::uint64_t _s[4]; //!< The generator state.
+
+			static std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+				return (x << k) | (x >> (64 - k));
+			}
+	};
+
+}
+
+#endif
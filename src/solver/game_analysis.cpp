@@ -0,0 +1,113 @@
+#include "game_analysis.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "solver.h"
+
+namespace TriangleGame {
+
+	game_analysis::game_analysis(const jump_table& table)
+		: _table(table), _seconds(0)
+	{
+
+	}
+
+	bool game_analysis::run(t_state start, const std::vector<t_jump_id>& jumps, unsigned threads) {
+		auto begin = std::chrono::steady_clock::now();
+		const auto& table = _table.get_jumps();
+
+		//the position before each move
+		auto positions = std::vector<t_state>();
+		t_state s = start;
+		for (auto id : jumps) {
+			if (id >= table.size() || (s & table[id].need) != table[id].need || (s & table[id].target) != 0)
+				return false;
+			positions.push_back(s);
+			s ^= table[id].flip;
+		}
+
+		_plies.assign(jumps.size(), ply_analysis());
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		threads = (unsigned)std::min<std::size_t>(threads, std::max<std::size_t>(jumps.size(), 1));
+
+		std::atomic<std::size_t> next(0);
+		auto work = [&]() {
+			auto solver = TriangleGame::solver(_table);
+			std::size_t taken;
+			while ((taken = next.fetch_add(1)) < jumps.size()) {
+				std::size_t i = jumps.size() - 1 - taken;
+				TRIANGLE_TRACE("game_analysis::ply", (std::int64_t)i);
+				const auto& played = table[jumps[i]];
+				auto& ply = _plies[i];
+
+				ply.from = played.from + 1;
+				ply.to = played.to + 1;
+				ply.best_after = solver.solve(positions[i] ^ played.flip);
+
+				t_jump_id best;
+				solver.get_best_jump(positions[i], best, ply.best_before);
+				ply.best_from = table[best].from + 1;
+				ply.best_to = table[best].to + 1;
+
+				//prefer the jump that was made, when it was as good as any
+				if (ply.best_after == ply.best_before) {
+					ply.best_from = ply.from;
+					ply.best_to = ply.to;
+				}
+			}
+		};
+
+		auto workers = std::vector<std::thread>();
+		for (unsigned t = 1; t < threads; t++)
+			workers.emplace_back(work);
+		work();
+		for (auto& w : workers)
+			w.join();
+
+		_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		return true;
+	}
+
+	const std::vector<ply_analysis>& game_analysis::get_plies() const noexcept {
+		return _plies;
+	}
+
+	double game_analysis::get_seconds() const noexcept {
+		return _seconds;
+	}
+
+	std::string game_analysis::to_string() const noexcept {
+		std::stringstream ss;
+		int blunders = 0, mistakes = 0;
+
+		for (std::size_t i = 0; i < _plies.size(); i++) {
+			const auto& p = _plies[i];
+			ss << (i + 1) << ".\tJumped peg [" << p.from << "] to [" << p.to << "]\t"
+				<< (p.winnable() ? "Winnable" : "Lost") << ", ";
+
+			if (p.blunder()) {
+				ss << "BLUNDER, the game can no longer be won";
+				blunders++;
+			} else if (p.mistake()) {
+				ss << "Mistake, leaves at best " << p.best_after << " pegs";
+				mistakes++;
+			} else {
+				ss << "Best, leaves at best " << p.best_after << " peg" << (p.best_after == 1 ? "" : "s");
+			}
+
+			if (p.mistake())
+				ss << ", jumping [" << p.best_from << "] to [" << p.best_to << "] leaves " << p.best_before;
+			ss << std::endl;
+		}
+
+		ss << std::endl << "Blunders: " << blunders << ", Mistakes: " << mistakes << std::endl;
+		return ss.str();
+	}
+
+}
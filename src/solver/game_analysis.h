@@ -0,0 +1,110 @@
+/**
+ * @file game_analysis.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the game_analysis class, which rates every move of a finished game.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_GAME_ANALYSIS__
+#define __H_TRIANGLE_SOLVER_GAME_ANALYSIS__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../include/abstract/printable.h"
+
+#include "jump_table.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief The analysis of one move of a game.
+	 */
+	struct ply_analysis {
+		int from; //!< The peg number that was jumped.
+		int to; //!< The peg number it landed in.
+		int best_before; //!< The fewest pegs that could be left before the move.
+		int best_after; //!< The fewest pegs that could be left after the move.
+		int best_from; //!< The peg number of the best jump, which may be the one made.
+		int best_to; //!< The peg number the best jump lands in.
+
+		/**
+		 * @brief Determinds if the game could still be won before the move.
+		 */
+		bool winnable() const noexcept { return best_before == 1; }
+
+		/**
+		 * @brief Determinds if the move threw away a game that could still be won.
+		 */
+		bool blunder() const noexcept { return best_before == 1 && best_after > 1; }
+
+		/**
+		 * @brief Determinds if a different jump would have left fewer pegs.
+		 */
+		bool mistake() const noexcept { return best_after > best_before; }
+	};
+
+	/**
+	 * @brief The Game Analysis Class, rates every move of a game against the best that could have been played.
+	 *
+	 * Each move is an independent solve of the position before it, so the moves are
+	 * shared out to a pool of threads, each with its own solver. Threads take the moves
+	 * from the end of the game first, as a later position is always part of an earlier
+	 * one's search, so each thread's transposition table has most of the next position
+	 * it takes already solved.
+	 */
+	class game_analysis : public abstract::printable {
+		public:
+			/**
+			 * @brief Construct a new analysis for the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the analysis.
+			 */
+			game_analysis(const jump_table& table);
+
+			/**
+			 * @brief Rates every move of a game.
+			 *
+			 * @param start The position before the first move.
+			 * @param jumps The jumps made, in order.
+			 * @param threads The number of threads to use, 0 uses every core.
+			 * @return true If every jump was legal.
+			 * @return false If a jump could not be made from its position.
+			 */
+			bool run(t_state start, const std::vector<t_jump_id>& jumps, unsigned threads = 0);
+
+			/**
+			 * @brief Returns the analysis of each move.
+			 *
+			 * @return const std::vector<ply_analysis>& The moves, in the order they were made.
+			 */
+			const std::vector<ply_analysis>& get_plies() const noexcept;
+
+			/**
+			 * @brief Returns the time the last run took.
+			 *
+			 * @return double The time, in seconds.
+			 */
+			double get_seconds() const noexcept;
+
+			/**
+			 * @brief Creates a report with a line for each move.
+			 *
+			 * @return std::string The string representation of the analysis.
+			 */
+			std::string to_string() const noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			std::vector<ply_analysis> _plies; //!< The analysis of each move.
+			double _seconds; //!< The time the last run took.
+	};
+
+}
+
+#endif
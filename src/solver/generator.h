@@ -0,0 +1,174 @@
+/**
+ * @file generator.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the generator class, a coroutine that yields a sequence of values one at a time.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_GENERATOR__
+#define __H_TRIANGLE_SOLVER_GENERATOR__
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace TriangleGame {
+
+	/**
+	 * @brief The Generator Class, a coroutine that yields values one at a time, for a range based for loop.
+	 *
+	 * The coroutine only runs when the next value is asked for, and stops at each co_yield,
+	 * so nothing is worked out ahead of the caller. A yielded value is not copied: the
+	 * caller sees the coroutine's own object, which is only valid until the next value is
+	 * asked for. This is the part of C++23's std::generator the solvers need, as the
+	 * project is built as C++20.
+	 *
+	 * @tparam T The type of the values yielded.
+	 */
+	template <typename T>
+	class generator {
+		public:
+			/**
+			 * @brief The state of the coroutine, holding the last value yielded.
+			 */
+			class promise_type {
+				public:
+					generator get_return_object() noexcept {
+						return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+					}
+
+					std::suspend_always initial_suspend() const noexcept { return {}; }
+					std::suspend_always final_suspend() const noexcept { return {}; }
+
+					std::suspend_always yield_value(const T& value) noexcept {
+						_value = std::addressof(value);
+						return {};
+					}
+
+					void return_void() const noexcept {}
+
+					void unhandled_exception() noexcept {
+						_error = std::current_exception();
+					}
+
+					/**
+					 * @brief Returns the last value yielded.
+					 */
+					const T& get_value() const noexcept {
+						return *_value;
+					}
+
+					/**
+					 * @brief Throws the exception the coroutine ended with, if any.
+					 */
+					void rethrow() const {
+						if (_error) std::rethrow_exception(_error);
+					}
+
+				private:
+					const T* _value = nullptr; //!< The last value yielded, owned by the coroutine.
+					std::exception_ptr _error; //!< The exception the coroutine ended with.
+			};
+
+			/**
+			 * @brief Walks the values of a generator, resuming the coroutine on each step.
+			 */
+			class iterator {
+				public:
+					typedef std::input_iterator_tag iterator_category; //!< Each value can only be read once.
+					typedef std::ptrdiff_t difference_type; //!< The distance between iterators.
+					typedef T value_type; //!< The type of the values.
+
+					iterator() noexcept : _coroutine(nullptr) {}
+					explicit iterator(std::coroutine_handle<promise_type> coroutine) noexcept : _coroutine(coroutine) {}
+
+					const T& operator*() const noexcept {
+						return _coroutine.promise().get_value();
+					}
+
+					iterator& operator++() {
+						_coroutine.resume();
+						if (_coroutine.done()) _coroutine.promise().rethrow();
+						return *this;
+					}
+
+					void operator++(int) {
+						++*this;
+					}
+
+					bool operator==(std::default_sentinel_t) const noexcept {
+						return _coroutine == nullptr || _coroutine.done();
+					}
+
+				private:
+					std::coroutine_handle<promise_type> _coroutine; //!< The coroutine being walked.
+			};
+
+			/**
+			 * @brief Construct a new generator that owns the given coroutine.
+			 *
+			 * @param coroutine The coroutine, suspended before its first value.
+			 */
+			explicit generator(std::coroutine_handle<promise_type> coroutine) noexcept
+				: _coroutine(coroutine)
+			{
+
+			}
+
+			generator(const generator&) = delete;
+			generator& operator=(const generator&) = delete;
+
+			generator(generator&& other) noexcept
+				: _coroutine(std::exchange(other._coroutine, nullptr))
+			{
+
+			}
+
+			generator& operator=(generator&& other) noexcept {
+				if (this != &other) {
+					if (_coroutine) _coroutine.destroy();
+					_coroutine = std::exchange(other._coroutine, nullptr);
+				}
+				return *this;
+			}
+
+			/**
+			 * @brief Destroy the generator, and the coroutine with it, wherever it was stopped.
+			 */
+			~generator() {
+				if (_coroutine) _coroutine.destroy();
+			}
+
+			/**
+			 * @brief Runs the coroutine to its first value, can only be called once.
+			 *
+			 * @return iterator The first value, or the end when there are none.
+			 */
+			iterator begin() {
+				auto it = iterator(_coroutine);
+				++it;
+				return it;
+			}
+
+			/**
+			 * @brief Returns the end of the values.
+			 *
+			 * @return std::default_sentinel_t The sentinel every finished iterator is equal to.
+			 */
+			std::default_sentinel_t end() const noexcept {
+				return std::default_sentinel;
+			}
+
+		private:
+			std::coroutine_handle<promise_type> _coroutine; //!< The coroutine, nullptr once moved from.
+	};
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+#include "goal_filter.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace TriangleGame {
+
+	goal_filter::goal_filter(const jump_table& table, t_state target)
+		: _target(target), _target_pegs(jump_table::count_pegs(target)), _target_pagoda(0)
+	{
+		const auto& jumps = table.get_jumps();
+		int holes = table.get_hole_count();
+
+		//Position Classes: reduce the jumps to echelon form over GF(2), each free hole gives a kept set
+		auto rows = std::vector<t_state>();
+		auto pivots = std::vector<int>();
+		for (const auto& j : jumps) {
+			t_state row = j.flip;
+			for (std::size_t r = 0; r < rows.size(); r++) {
+				if (row >> pivots[r] & 1) row ^= rows[r];
+			}
+			if (row == 0) continue;
+
+			int pivot = std::countr_zero(row);
+			for (auto& other : rows) {
+				if (other >> pivot & 1) other ^= row;
+			}
+			rows.push_back(row);
+			pivots.push_back(pivot);
+		}
+
+		for (int free = 0; free < holes; free++) {
+			if (std::find(pivots.begin(), pivots.end(), free) != pivots.end()) continue;
+
+			t_state set = t_state(1) << free;
+			for (std::size_t r = 0; r < rows.size(); r++) {
+				if (rows[r] >> free & 1) set |= t_state(1) << pivots[r];
+			}
+			_classes.push_back(set);
+		}
+
+		//Pagoda: the steps from each hole to the nearest of the target's, between holes next to each other in a jump
+		auto neighbours = std::vector<std::vector<int>>(holes);
+		for (const auto& j : jumps) {
+			neighbours[j.from].push_back(j.over);
+			neighbours[j.over].push_back(j.from);
+			neighbours[j.over].push_back(j.to);
+			neighbours[j.to].push_back(j.over);
+		}
+
+		auto steps = std::vector<int>(holes, -1);
+		auto queue = std::vector<int>();
+		for (int h = 0; h < holes; h++) {
+			if (target >> h & 1) {
+				steps[h] = 0;
+				queue.push_back(h);
+			}
+		}
+		for (std::size_t i = 0; i < queue.size(); i++) {
+			for (int n : neighbours[queue[i]]) {
+				if (steps[n] >= 0) continue;
+				steps[n] = steps[queue[i]] + 1;
+				queue.push_back(n);
+			}
+		}
+
+		//w(d) = w(d + 1) + w(d + 2), ending in 1, 1; holes no target hole can be reached from weigh nothing
+		int farthest = queue.empty() ? 0 : steps[queue.back()];
+		auto weight = std::vector<std::uint64_t>(farthest + 3, 0);
+		weight[farthest + 1] = 1;
+		for (int d = farthest; d >= 0; d--)
+			weight[d] = weight[d + 1] + weight[d + 2];
+
+		_pagoda.resize((holes + 7) / 8);
+		for (std::size_t b = 0; b < _pagoda.size(); b++) {
+			for (int v = 0; v < 256; v++) {
+				std::uint64_t total = 0;
+				for (int bit = 0; bit < 8; bit++) {
+					int h = (int)b * 8 + bit;
+					if ((v >> bit & 1) && h < holes && steps[h] >= 0) total += weight[steps[h]];
+				}
+				_pagoda[b][v] = total;
+			}
+		}
+		_target_pagoda = pagoda_of(target);
+	}
+
+	goal_check goal_filter::check(t_state s) const noexcept {
+		if (jump_table::count_pegs(s) < _target_pegs) return goal_check::too_few_pegs;
+
+		for (t_state set : _classes) {
+			if ((jump_table::count_pegs(s & set) & 1) != (jump_table::count_pegs(_target & set) & 1))
+				return goal_check::wrong_class;
+		}
+
+		if (pagoda_of(s) < _target_pagoda) return goal_check::pagoda;
+		return goal_check::possible;
+	}
+
+	t_state goal_filter::get_target() const noexcept {
+		return _target;
+	}
+
+	const std::vector<t_state>& goal_filter::get_classes() const noexcept {
+		return _classes;
+	}
+
+	const char* goal_filter::describe(goal_check result) noexcept {
+		switch (result) {
+			case goal_check::too_few_pegs: return "fewer pegs than the target";
+			case goal_check::wrong_class: return "a different position class to the target";
+			case goal_check::pagoda: return "a pagoda value below the target's";
+			default: return "possible";
+		}
+	}
+
+}
@@ -0,0 +1,126 @@
+/**
+ * @file goal_filter.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the goal_filter class, which rules out positions that can never reach a target position.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_GOAL_FILTER__
+#define __H_TRIANGLE_SOLVER_GOAL_FILTER__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "jump_table.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief The reasons a position can be found to never reach a target.
+	 */
+	enum class goal_check {
+		possible,		//!< No invariant rules the target out, it may still be unreachable.
+		too_few_pegs,	//!< The position has fewer pegs than the target.
+		wrong_class,	//!< The position is in a different position class to the target.
+		pagoda			//!< The position's pagoda value is below the target's.
+	};
+
+	/**
+	 * @brief The Goal Filter Class, rules out positions that can never reach a target position,
+	 * by invariants that every jump keeps.
+	 *
+	 * Position classes: a set of holes where every jump touches an even number of them
+	 * keeps the parity of the pegs in the set, so a position and the target must agree on
+	 * every such set. The sets are the null space of the jumps over GF(2), found by
+	 * elimination from the jump table, so they are the triangle's and the English board's
+	 * classic position classes, and work for any board.
+	 *
+	 * Pagoda: a weight on each hole where the hole a jump lands in weighs no more than the
+	 * two it empties never grows in total, so a position weighing less than the target can
+	 * not reach it. The weights are Fibonacci numbers falling away from the target's holes,
+	 * by the fewest steps between neighbouring holes, which keeps every jump's landing
+	 * weight at most the sum of the other two, and weighs the target's own holes the most.
+	 *
+	 * Jumps never change a position's classes, so a search only has to check them once,
+	 * at the start, and the pagoda at every position.
+	 */
+	class goal_filter {
+		public:
+			/**
+			 * @brief Construct a new filter for reaching the given target.
+			 *
+			 * @param table The jumps of the board.
+			 * @param target The target position.
+			 */
+			goal_filter(const jump_table& table, t_state target);
+
+			/**
+			 * @brief Checks every invariant of a position against the target.
+			 *
+			 * @param s The position.
+			 * @return goal_check The first invariant that rules the target out, or possible.
+			 */
+			goal_check check(t_state s) const noexcept;
+
+			/**
+			 * @brief Checks the invariants a jump can change, for positions reached from one that passed check.
+			 *
+			 * @param s The position.
+			 * @return true If the target may be reachable.
+			 * @return false If it is not.
+			 */
+			bool possible(t_state s) const noexcept {
+				return jump_table::count_pegs(s) >= _target_pegs && pagoda_of(s) >= _target_pagoda;
+			}
+
+			/**
+			 * @brief Returns the pagoda value of a position.
+			 *
+			 * @param s The position.
+			 * @return std::uint64_t The total weight of its pegs.
+			 */
+			std::uint64_t pagoda_of(t_state s) const noexcept {
+				std::uint64_t v = 0;
+				for (std::size_t b = 0; b < _pagoda.size(); b++, s >>= 8)
+					v += _pagoda[b][s & 0xff];
+				return v;
+			}
+
+			/**
+			 * @brief Returns the target position.
+			 *
+			 * @return t_state The target.
+			 */
+			t_state get_target() const noexcept;
+
+			/**
+			 * @brief Returns the sets of holes whose peg parity no jump changes.
+			 *
+			 * @return const std::vector<t_state>& The independent sets, as hole masks.
+			 */
+			const std::vector<t_state>& get_classes() const noexcept;
+
+			/**
+			 * @brief Returns a description of a check's result.
+			 *
+			 * @param result The result.
+			 * @return const char* The description.
+			 */
+			static const char* describe(goal_check result) noexcept;
+
+		private:
+			t_state _target; //!< The target position.
+			int _target_pegs; //!< The pegs of the target.
+			std::vector<t_state> _classes; //!< The hole sets whose peg parity is kept.
+			std::vector<std::array<std::uint64_t, 256>> _pagoda; //!< The pagoda weight of each byte of a position.
+			std::uint64_t _target_pagoda; //!< The pagoda value of the target.
+	};
+
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "goal_grid.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "bidirectional_solver.h"
+
+namespace TriangleGame {
+
+	goal_grid::goal_grid(const jump_table& table)
+		: _table(table), _seconds(0)
+	{
+
+	}
+
+	void goal_grid::run(unsigned threads) {
+		auto begin = std::chrono::steady_clock::now();
+		int holes = _table.get_hole_count();
+
+		_cells.clear();
+		for (int start = 1; start <= holes; start++) {
+			for (int target = 1; target <= holes; target++)
+				_cells.push_back({ start, target, goal_check::possible, false, 0 });
+		}
+
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		threads = (unsigned)std::min<std::size_t>(threads, _cells.size());
+
+		std::atomic<std::size_t> next(0);
+		auto work = [&]() {
+			auto solver = bidirectional_solver(_table);
+			auto jumps = std::vector<t_jump_id>();
+			std::size_t i;
+			while ((i = next.fetch_add(1)) < _cells.size()) {
+				TRIANGLE_TRACE("goal_grid::cell", (std::int64_t)i);
+				auto& cell = _cells[i];
+				solver.set_goal(cell.target);
+				cell.solvable = solver.solve(_table.get_start_state(cell.start), jumps);
+				cell.rejection = solver.get_rejection();
+				cell.nodes = solver.get_nodes();
+			}
+		};
+
+		auto workers = std::vector<std::thread>();
+		for (unsigned t = 1; t < threads; t++)
+			workers.emplace_back(work);
+		work();
+		for (auto& w : workers)
+			w.join();
+
+		_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+	const std::vector<goal_cell>& goal_grid::get_cells() const noexcept {
+		return _cells;
+	}
+
+	double goal_grid::get_seconds() const noexcept {
+		return _seconds;
+	}
+
+	std::string goal_grid::to_string() const noexcept {
+		std::stringstream ss;
+		int holes = _table.get_hole_count();
+
+		ss << "Start\\Finish";
+		for (int target = 1; target <= holes; target++) ss << "\t" << target;
+		ss << std::endl;
+
+		int solvable = 0, classes = 0, pagodas = 0, searched = 0;
+		std::uint64_t nodes = 0;
+		for (const auto& cell : _cells) {
+			if (cell.target == 1) ss << cell.start;
+
+			char mark = '-';
+			if (cell.solvable) mark = 'S';
+			else if (cell.rejection == goal_check::wrong_class) mark = 'c';
+			else if (cell.rejection == goal_check::pagoda) mark = 'p';
+			ss << "\t" << mark;
+			if (cell.target == holes) ss << std::endl;
+
+			solvable += cell.solvable;
+			classes += cell.rejection == goal_check::wrong_class;
+			pagodas += cell.rejection == goal_check::pagoda;
+			searched += cell.rejection == goal_check::possible;
+			nodes += cell.nodes;
+		}
+
+		ss << std::endl;
+		ss << "S = solvable, - = searched and not solvable, c = ruled out by position class, p = ruled out by pagoda" << std::endl;
+		ss << "Pairs: " << _cells.size() << ", Solvable: " << solvable << ", Ruled Out by Class: " << classes
+			<< ", by Pagoda: " << pagodas << ", Searched: " << searched << ", Nodes: " << nodes << std::endl;
+		ss << "Seconds: " << _seconds << std::endl;
+		return ss.str();
+	}
+
+}
@@ -0,0 +1,90 @@
+/**
+ * @file goal_grid.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the goal_grid class, which finds every start and finishing hole pair that can be solved.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_GOAL_GRID__
+#define __H_TRIANGLE_SOLVER_GOAL_GRID__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../include/abstract/printable.h"
+
+#include "jump_table.h"
+#include "goal_filter.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief Whether a game started from one hole can finish with its last peg in another.
+	 */
+	struct goal_cell {
+		int start; //!< The peg number removed first.
+		int target; //!< The peg number the last peg must finish in.
+		goal_check rejection; //!< The invariant that rules the pair out, possible when it was searched.
+		bool solvable; //!< True when a sequence of jumps was found.
+		std::uint64_t nodes; //!< The positions expanded by the search.
+	};
+
+	/**
+	 * @brief The Goal Grid Class, finds for every starting hole and every finishing hole whether
+	 * a game can start by removing the one and finish with its last peg in the other.
+	 *
+	 * Each pair is first checked by a goal_filter, which rules out most unsolvable pairs
+	 * straight away, and the rest are searched for with a bidirectional_solver. The pairs
+	 * are independent, so they are shared out to a pool of threads, each with its own solver.
+	 */
+	class goal_grid : public abstract::printable {
+		public:
+			/**
+			 * @brief Construct a new grid for the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the grid.
+			 */
+			goal_grid(const jump_table& table);
+
+			/**
+			 * @brief Checks every pair of starting and finishing holes.
+			 *
+			 * @param threads The number of threads to use, 0 uses every core.
+			 */
+			void run(unsigned threads = 0);
+
+			/**
+			 * @brief Returns the result of every pair.
+			 *
+			 * @return const std::vector<goal_cell>& The pairs, by start then target.
+			 */
+			const std::vector<goal_cell>& get_cells() const noexcept;
+
+			/**
+			 * @brief Returns the time the last run took.
+			 *
+			 * @return double The time, in seconds.
+			 */
+			double get_seconds() const noexcept;
+
+			/**
+			 * @brief Creates a table with a row for each start and a column for each target.
+			 *
+			 * @return std::string The string representation of the grid.
+			 */
+			std::string to_string() const noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			std::vector<goal_cell> _cells; //!< The result of every pair.
+			double _seconds; //!< The time the last run took.
+	};
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include "hint_service.h"
+#include "../board/trace.h"
+
+namespace TriangleGame {
+
+	hint_service::hint_service(const jump_table& table)
+		: _table(table), _solver(table), _cancel(false), _quit(false),
+		  _has_pending(false), _pending(0), _busy(false), _current(0)
+	{
+		_solver.set_stop_flag(&_cancel);
+		_worker = std::thread(&hint_service::_run, this);
+	}
+
+	hint_service::~hint_service() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_quit = true;
+			_cancel = true;
+		}
+		_work.notify_all();
+		_worker.join();
+	}
+
+	void hint_service::warm(t_state s) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_warm(s);
+	}
+
+	hint hint_service::get_hint(t_state s) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_warm(s);
+		_done.wait(lock, [this, s]() { return _hints.count(s) > 0; });
+		return _hints[s];
+	}
+
+	bool hint_service::is_ready(t_state s) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _hints.count(s) > 0;
+	}
+
+	t_move_ratings hint_service::get_ratings(t_state s) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _ratings.find(s);
+		return it == _ratings.end() ? t_move_ratings() : it->second;
+	}
+
+	void hint_service::set_listener(t_rating_listener listener) {
+		std::lock_guard<std::mutex> lock(_listener_mutex);
+		_listener = std::move(listener);
+	}
+
+	void hint_service::set_hint_listener(t_hint_listener listener) {
+		std::lock_guard<std::mutex> lock(_listener_mutex);
+		_hint_listener = std::move(listener);
+	}
+
+	void hint_service::set_memory_limit(std::size_t bytes) noexcept {
+		_solver.set_memory_limit(bytes);
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	void hint_service::_warm(t_state s) {
+		if (_hints.count(s) > 0) return;
+		//a search that is being cancelled is started again, after the jumps it rated
+		if (_busy && _current == s && !_cancel) return;
+
+		if (_busy) _cancel = true;
+		_pending = s;
+		_has_pending = true;
+		_work.notify_one();
+	}
+
+	void hint_service::_run() {
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true) {
+			_work.wait(lock, [this]() { return _quit || _has_pending; });
+			if (_quit) return;
+
+			_current = _pending;
+			_has_pending = false;
+			_busy = true;
+			_cancel = false;
+			lock.unlock();
+
+			hint h;
+			bool solved = _solve(_current, h);
+
+			lock.lock();
+			_busy = false;
+			if (solved) _hints[_current] = h;
+			_done.notify_all();
+			if (!solved) continue;
+
+			t_state s = _current;
+			lock.unlock();
+			{
+				std::lock_guard<std::mutex> listening(_listener_mutex);
+				if (_hint_listener) _hint_listener(s, h);
+			}
+			lock.lock();
+		}
+	}
+
+	bool hint_service::_solve(t_state s, hint& h) {
+		TRIANGLE_TRACE("hint_service::solve", jump_table::count_pegs(s));
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+		int n = _table.get_legal_jumps(s, legal);
+
+		h.has_jump = false;
+		h.from = h.to = EMPTY_PEG;
+		h.pegs_left = jump_table::count_pegs(s);
+
+		//a cancelled search keeps the jumps it rated, in the order of the legal jumps, so the next one starts after them
+		t_move_ratings rated;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			rated = _ratings[s];
+		}
+
+		//when several jumps are equally good, the first in the jump table is the hint
+		auto consider = [&h](const move_rating& r) {
+			if (!h.has_jump || r.pegs_left < h.pegs_left) {
+				h.has_jump = true;
+				h.from = r.from;
+				h.to = r.to;
+				h.pegs_left = r.pegs_left;
+			}
+		};
+		for (const auto& r : rated)
+			consider(r);
+
+		for (int i = (int)rated.size(); i < n; i++) {
+			int v = _solver.solve(s ^ jumps[legal[i]].flip);
+			if (v == UNSOLVED) return false;
+
+			move_rating r = { jumps[legal[i]].from + 1, jumps[legal[i]].to + 1, v };
+			consider(r);
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_ratings[s].push_back(r);
+			}
+
+			std::lock_guard<std::mutex> lock(_listener_mutex);
+			if (_listener) _listener(s, r);
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,184 @@
+/**
+ * @file hint_service.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the hint_service class, which solves positions in the background.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_HINT_SERVICE__
+#define __H_TRIANGLE_SOLVER_HINT_SERVICE__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "jump_table.h"
+#include "solver.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief A suggested jump, and the best outcome it leads to.
+	 */
+	struct hint {
+		bool has_jump; //!< False when there are no jumps left.
+		int from; //!< The peg number to jump.
+		int to; //!< The peg number to land in.
+		int pegs_left; //!< The fewest pegs that can be left after the jump.
+	};
+
+	/**
+	 * @brief The best outcome of one jump.
+	 */
+	struct move_rating {
+		int from; //!< The peg number to jump.
+		int to; //!< The peg number to land in.
+		int pegs_left; //!< The fewest pegs that can be left after the jump, 1 when it can still be won.
+	};
+
+	typedef std::vector<move_rating> t_move_ratings; //!< The jumps of a position rated so far.
+	typedef std::function<void(t_state, const move_rating&)> t_rating_listener; //!< Called with each jump as soon as it is rated.
+	typedef std::function<void(t_state, const hint&)> t_hint_listener; //!< Called with each position as soon as it is solved.
+
+	/**
+	 * @brief The Hint Service Class, solves positions on a background thread.
+	 *
+	 * The game warms the service with each position as soon as it is shown, and the
+	 * position is solved while the player is thinking. Asking for a hint then only
+	 * waits for whatever is left of that search. A newer position cancels the search of
+	 * an older one, which is safe as the solver's transposition table only holds finished
+	 * positions, and is kept for the life of the service, so undoing back to an earlier
+	 * position is answered straight from the cache.
+	 *
+	 * Each jump of the position is solved in turn, and published as soon as it is, so the
+	 * game can show the rating of every jump while the rest are still being solved.
+	 */
+	class hint_service {
+		public:
+			/**
+			 * @brief Construct a new hint service, and starts its background thread.
+			 *
+			 * @param table The jumps of the board, must outlive the service.
+			 */
+			hint_service(const jump_table& table);
+
+			/**
+			 * @brief Stops the background thread.
+			 */
+			~hint_service();
+
+			hint_service(const hint_service&) = delete;
+			hint_service& operator=(const hint_service&) = delete;
+
+			/**
+			 * @brief Starts solving the given position in the background, if it has not been already.
+			 * Any search of a different position is cancelled.
+			 *
+			 * @param s The position to solve.
+			 */
+			void warm(t_state s);
+
+			/**
+			 * @brief Returns the hint for the given position, waiting for it to be solved if needed.
+			 *
+			 * @param s The position to get the hint for.
+			 * @return hint The best jump, and its outcome.
+			 */
+			hint get_hint(t_state s);
+
+			/**
+			 * @brief Determinds if the hint for the given position is ready, without waiting.
+			 *
+			 * @param s The position to check.
+			 * @return true If get_hint would return straight away.
+			 * @return false Otherwise.
+			 */
+			bool is_ready(t_state s);
+
+			/**
+			 * @brief Returns the jumps of the given position that have been rated so far, without waiting.
+			 *
+			 * @param s The position.
+			 * @return t_move_ratings The rated jumps, in the order they were rated.
+			 */
+			t_move_ratings get_ratings(t_state s);
+
+			/**
+			 * @brief Sets the function called as each jump is rated, on the background thread.
+			 * Once this returns, the old function is never called again.
+			 *
+			 * @param listener The function to call, or nullptr for none.
+			 */
+			void set_listener(t_rating_listener listener);
+
+			/**
+			 * @brief Sets the function called as each position is solved, on the background thread.
+			 * Once this returns, the old function is never called again.
+			 *
+			 * @param listener The function to call, or nullptr for none.
+			 */
+			void set_hint_listener(t_hint_listener listener);
+
+			/**
+			 * @brief Sets the most memory the solver's table can use, before the first position is warmed.
+			 *
+			 * @param bytes The memory limit, or 0 for no limit.
+			 */
+			void set_memory_limit(std::size_t bytes) noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			solver _solver; //!< The solver, only used by the background thread.
+			std::unordered_map<t_state, hint> _hints; //!< The solved positions.
+			std::unordered_map<t_state, t_move_ratings> _ratings; //!< The rated jumps of each position.
+
+			std::mutex _listener_mutex; //!< Held while the listeners are set or called.
+			t_rating_listener _listener; //!< Called as each jump is rated.
+			t_hint_listener _hint_listener; //!< Called as each position is solved.
+
+			std::mutex _mutex; //!< Guards everything below.
+			std::condition_variable _work; //!< Signals the background thread.
+			std::condition_variable _done; //!< Signals a finished search.
+			std::atomic<bool> _cancel; //!< Cancels the current search.
+			bool _quit; //!< Stops the background thread.
+			bool _has_pending; //!< True when _pending is waiting to be solved.
+			t_state _pending; //!< The next position to solve.
+			bool _busy; //!< True while _current is being solved.
+			t_state _current; //!< The position being solved.
+
+			std::thread _worker; //!< The background thread.
+
+			/**
+			 * @brief Queues the position, the mutex must be held.
+			 *
+			 * @param s The position to solve.
+			 */
+			void _warm(t_state s);
+
+			/**
+			 * @brief The background thread's loop.
+			 */
+			void _run();
+
+			/**
+			 * @brief Solves the given position, rating each of its jumps.
+			 *
+			 * @param s The position to solve.
+			 * @param h The returned hint.
+			 * @return true If the position was solved.
+			 * @return false If the search was cancelled.
+			 */
+			bool _solve(t_state s, hint& h);
+	};
+
+}
+
+#endif
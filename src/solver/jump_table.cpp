@@ -0,0 +1,120 @@
+#include "jump_table.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace TriangleGame {
+
+	jump_table::jump_table(int height)
+		: jump_table(topology::triangle(height))
+	{
+
+	}
+
+	jump_table::jump_table(const topology& geometry)
+		: _topology(geometry), _height(geometry.get_rows()), _holes(geometry.get_hole_count())
+	{
+		if (!supports(geometry))
+			throw std::invalid_argument("board does not fit into a t_state");
+
+		for (const auto& t : geometry.get_jumps()) {
+			jump j;
+			j.from = (std::uint8_t)t.from;
+			j.over = (std::uint8_t)t.over;
+			j.to = (std::uint8_t)t.to;
+			j.need = (t_state(1) << j.from) | (t_state(1) << j.over);
+			j.target = t_state(1) << j.to;
+			j.flip = j.need | j.target;
+			_jumps.push_back(j);
+		}
+
+		std::sort(_jumps.begin(), _jumps.end(), [](const jump& a, const jump& b) {
+			return a.to == b.to ? a.from < b.from : a.to < b.to;
+		});
+	}
+
+	const topology& jump_table::get_topology() const noexcept {
+		return _topology;
+	}
+
+	int jump_table::get_height() const noexcept {
+		return _height;
+	}
+
+	int jump_table::get_hole_count() const noexcept {
+		return _holes;
+	}
+
+	const t_jumps& jump_table::get_jumps() const noexcept {
+		return _jumps;
+	}
+
+	t_state jump_table::get_full_state() const noexcept {
+		return _holes == 64 ? ~t_state(0) : (t_state(1) << _holes) - 1;
+	}
+
+	t_state jump_table::get_start_state(int pegNumber) const noexcept {
+		return get_full_state() & ~(t_state(1) << (pegNumber - 1));
+	}
+
+	t_state jump_table::get_state(board& b) const {
+		t_state s = 0;
+		for (int i = 1; i <= _holes; i++) {
+			if (!b.is_peg_removed(i))
+				s |= t_state(1) << (i - 1);
+		}
+		return s;
+	}
+
+	int jump_table::get_legal_jumps(t_state s, t_jump_id* out) const noexcept {
+		int n = 0;
+		for (std::size_t i = 0; i < _jumps.size(); i++) {
+			const auto& j = _jumps[i];
+			out[n] = (t_jump_id)i;
+			n += ((s & j.need) == j.need) & ((s & j.target) == 0);
+		}
+		return n;
+	}
+
+	bool jump_table::has_jump(t_state s) const noexcept {
+		for (const auto& j : _jumps) {
+			if ((s & j.need) == j.need && (s & j.target) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	bool jump_table::find_jump(int fromPegNumber, int toPegNumber, t_jump_id& id) const noexcept {
+		for (std::size_t i = 0; i < _jumps.size(); i++) {
+			if (_jumps[i].from == fromPegNumber - 1 && _jumps[i].to == toPegNumber - 1) {
+				id = (t_jump_id)i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	t_open_moves jump_table::get_open_moves(t_state s) const {
+		auto m = t_open_moves();
+		for (const auto& j : _jumps) {
+			if ((s & j.need) == j.need && (s & j.target) == 0)
+				m[j.to + 1].push_back(j.from + 1);
+		}
+		return m;
+	}
+
+	int jump_table::count_pegs(t_state s) noexcept {
+		return std::popcount(s);
+	}
+
+	bool jump_table::supports(int height) noexcept {
+		return height >= 1 && height <= MAX_STATE_HEIGHT;
+	}
+
+	bool jump_table::supports(const topology& geometry) noexcept {
+		return geometry.get_hole_count() >= 1 && geometry.get_hole_count() <= MAX_STATE_HOLES
+			&& geometry.get_jumps().size() <= (std::size_t)MAX_JUMPS;
+	}
+
+}
@@ -0,0 +1,198 @@
+/**
+ * @file jump_table.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the jump_table class, the precomputed jumps of a board packed into a single word.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_JUMP_TABLE__
+#define __H_TRIANGLE_SOLVER_JUMP_TABLE__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../board/board.h"
+#include "../board/topology.h"
+
+namespace TriangleGame {
+
+	typedef std::uint64_t t_state; //!< A board position, bit (pegNumber - 1) is set when the peg is on the board.
+	typedef std::uint16_t t_jump_id; //!< The index of a jump in the jump table.
+
+	const int MAX_STATE_HEIGHT = 10; //!< The tallest triangle board that fits into a t_state.
+	const int MAX_STATE_HOLES = 64; //!< The most holes a board can have to fit into a t_state.
+	const int MAX_JUMPS = JUMP_DIRECTIONS * 64; //!< The most jumps a t_state board can have, at most six land in each hole.
+	const std::size_t TABLE_ENTRY_BYTES = 32; //!< The memory of one position in a hash table, including the allocator's overhead.
+
+	/**
+	 * @brief A single jump, a peg moving from one hole, over a second, into a third.
+	 * The masks are precomputed so that testing and applying a jump is a couple of instructions.
+	 */
+	struct jump {
+		std::uint8_t from; //!< The hole the peg jumps from.
+		std::uint8_t over; //!< The hole of the peg being jumped over, and removed.
+		std::uint8_t to; //!< The hole the peg lands in.
+		t_state need; //!< The bits of from and over, which must both be set.
+		t_state target; //!< The bit of to, which must be clear.
+		t_state flip; //!< The bits of from, over and to, toggled when the jump is made.
+	};
+
+	typedef std::vector<jump> t_jumps; //!< A list of jumps.
+
+	/**
+	 * @brief The Jump Table Class, every jump possible on a board, packed for searching.
+	 *
+	 * The table is built from a topology, and is the one engine behind playing, move
+	 * generation and solving on every board shape; nothing here knows about triangles.
+	 * Holes are numbered from 0, one less than their peg number. Jumps are ordered
+	 * by the hole they land in and then by the hole they come from, which is the same
+	 * order board::get_all_moves lists them in.
+	 */
+	class jump_table {
+		public:
+			/**
+			 * @brief Construct a new jump table for a triangle board of the given height.
+			 * Throws std::invalid_argument when the height is larger than MAX_STATE_HEIGHT.
+			 *
+			 * @param height The height of the board, the number of rows.
+			 */
+			jump_table(int height);
+
+			/**
+			 * @brief Construct a new jump table for the given board.
+			 * Throws std::invalid_argument when the board has more than MAX_STATE_HOLES holes.
+			 *
+			 * @param geometry The holes and jumps of the board.
+			 */
+			jump_table(const topology& geometry);
+
+			/**
+			 * @brief Returns the geometry the table was built from.
+			 *
+			 * @return const topology& The board's topology.
+			 */
+			const topology& get_topology() const noexcept;
+
+			/**
+			 * @brief Returns the number of rows the board is drawn with,
+			 * for the triangle this is its height.
+			 *
+			 * @return int The height of the board.
+			 */
+			int get_height() const noexcept;
+
+			/**
+			 * @brief Returns the number of holes on the board.
+			 *
+			 * @return int The number of holes.
+			 */
+			int get_hole_count() const noexcept;
+
+			/**
+			 * @brief Returns all the jumps on the board.
+			 *
+			 * @return const t_jumps& The jumps.
+			 */
+			const t_jumps& get_jumps() const noexcept;
+
+			/**
+			 * @brief Returns the state where every hole has a peg.
+			 *
+			 * @return t_state The full board.
+			 */
+			t_state get_full_state() const noexcept;
+
+			/**
+			 * @brief Returns the state where every hole, except the starting hole, has a peg.
+			 *
+			 * @param pegNumber The peg number of the starting hole.
+			 * @return t_state The starting position.
+			 */
+			t_state get_start_state(int pegNumber) const noexcept;
+
+			/**
+			 * @brief Creates the state of the given board's pegs.
+			 *
+			 * @param b The board, which must be the same height as the table.
+			 * @return t_state The position of the board.
+			 */
+			t_state get_state(board& b) const;
+
+			/**
+			 * @brief Finds the legal jumps in the given state.
+			 *
+			 * @param s The position to find the jumps in.
+			 * @param out The returned jump ids, must have room for get_jumps().size() ids.
+			 * @return int The number of legal jumps found.
+			 */
+			int get_legal_jumps(t_state s, t_jump_id* out) const noexcept;
+
+			/**
+			 * @brief Determinds if there are any legal jumps left in the given state.
+			 *
+			 * @param s The position to check.
+			 * @return true If at least one jump can be made.
+			 * @return false If the game is over.
+			 */
+			bool has_jump(t_state s) const noexcept;
+
+			/**
+			 * @brief Finds the id of the jump from one peg number to another.
+			 *
+			 * @param fromPegNumber The peg number jumping.
+			 * @param toPegNumber The peg number being landed in.
+			 * @param id The returned jump id.
+			 * @return true If the jump exists on the board.
+			 * @return false Otherwise.
+			 */
+			bool find_jump(int fromPegNumber, int toPegNumber, t_jump_id& id) const noexcept;
+
+			/**
+			 * @brief Returns all the legal, avaliable moves in the given state.
+			 *
+			 * @param s The position to find the moves in.
+			 * @return t_open_moves The avaliable moves, in the same format as board::get_all_moves.
+			 */
+			t_open_moves get_open_moves(t_state s) const;
+
+			/**
+			 * @brief Counts the pegs in the given state.
+			 *
+			 * @param s The position.
+			 * @return int The number of pegs.
+			 */
+			static int count_pegs(t_state s) noexcept;
+
+			/**
+			 * @brief Determinds if the given height fits into a t_state.
+			 *
+			 * @param height The height of the board.
+			 * @return true If the height is supported.
+			 * @return false Otherwise.
+			 */
+			static bool supports(int height) noexcept;
+
+			/**
+			 * @brief Determinds if the given board fits into a t_state.
+			 *
+			 * @param geometry The board.
+			 * @return true If the board is supported.
+			 * @return false Otherwise.
+			 */
+			static bool supports(const topology& geometry) noexcept;
+
+		private:
+			topology _topology; //!< The geometry of the board.
+			int _height; //!< The number of rows of the board.
+			int _holes; //!< The number of holes on the board.
+			t_jumps _jumps; //!< The jumps on the board.
+	};
+
+}
+
+#endif
@@ -0,0 +1,201 @@
+#include "playout.h"
+#include "batch_simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace TriangleGame {
+
+	//--------------------------------------------------
+	// Playout Result
+	//--------------------------------------------------
+
+	playout_result::playout_result(int holes)
+		: _counts(holes + 1, 0), _total(0), _seconds(0)
+	{
+
+	}
+
+	void playout_result::add(int pegsLeft) noexcept {
+		_counts[pegsLeft]++;
+		_total++;
+	}
+
+	void playout_result::merge(const playout_result& other) {
+		if (other._counts.size() > _counts.size())
+			_counts.resize(other._counts.size(), 0);
+
+		for (std::size_t i = 0; i < other._counts.size(); i++)
+			_counts[i] += other._counts[i];
+		_total += other._total;
+	}
+
+	std::uint64_t playout_result::get_count(int pegsLeft) const {
+		if (pegsLeft < 0 || pegsLeft >= (int)_counts.size()) return 0;
+		return _counts[pegsLeft];
+	}
+
+	std::uint64_t playout_result::get_total() const noexcept {
+		return _total;
+	}
+
+	double playout_result::get_mean() const noexcept {
+		if (_total == 0) return 0;
+		double sum = 0;
+		for (std::size_t i = 0; i < _counts.size(); i++)
+			sum += (double)i * _counts[i];
+		return sum / _total;
+	}
+
+	double playout_result::get_seconds() const noexcept {
+		return _seconds;
+	}
+
+	void playout_result::set_seconds(double seconds) noexcept {
+		_seconds = seconds;
+	}
+
+	std::string playout_result::to_string() const noexcept {
+		std::stringstream ss;
+		ss << "Pegs Left\tPlayouts\tPercent" << std::endl;
+		for (std::size_t i = 0; i < _counts.size(); i++) {
+			if (_counts[i] == 0) continue;
+			ss << i << "\t\t" << _counts[i] << "\t\t"
+				<< std::fixed << std::setprecision(3) << (100.0 * _counts[i] / _total) << "%" << std::endl;
+		}
+		ss << std::endl;
+		ss << "Total Playouts: " << _total << std::endl;
+		ss << "Average Pegs Left: " << std::fixed << std::setprecision(3) << get_mean() << std::endl;
+		if (_seconds > 0)
+			ss << "Playouts/sec: " << std::fixed << std::setprecision(0) << (_total / _seconds) << std::endl;
+		return ss.str();
+	}
+
+	//--------------------------------------------------
+	// Playout Engine
+	//--------------------------------------------------
+
+	playout_engine::playout_engine(const jump_table& table)
+		: _table(table), _policy(playout_policy::uniform), _batch_size(0)
+	{
+
+	}
+
+	void playout_engine::set_policy(playout_policy policy) {
+		_policy = policy;
+		if (_policy != playout_policy::uniform && _weights.empty())
+			_weights = edge_weights(_table);
+	}
+
+	void playout_engine::set_weights(const std::vector<std::uint32_t>& weights) {
+		_weights = weights;
+	}
+
+	void playout_engine::set_batch_size(std::size_t games) noexcept {
+		_batch_size = games;
+	}
+
+	int playout_engine::play(t_state s, fast_random& rng) const noexcept {
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+
+		int n;
+		while ((n = _table.get_legal_jumps(s, legal)) > 0) {
+			t_jump_id pick = legal[0];
+
+			if (_policy == playout_policy::uniform) {
+				pick = legal[rng.bounded(n)];
+			} else if (_policy == playout_policy::greedy) {
+				std::uint32_t best = 0, ties = 0;
+				for (int i = 0; i < n; i++) {
+					std::uint32_t w = _weights[legal[i]];
+					if (w > best || ties == 0) { best = w; ties = 1; }
+					else if (w == best) ties++;
+				}
+
+				std::uint32_t r = rng.bounded(ties);
+				for (int i = 0; i < n; i++) {
+					if (_weights[legal[i]] == best && r-- == 0) {
+						pick = legal[i];
+						break;
+					}
+				}
+			} else {
+				std::uint32_t total = 0;
+				for (int i = 0; i < n; i++)
+					total += _weights[legal[i]];
+
+				if (total > 0) {
+					std::uint32_t r = rng.bounded(total);
+					for (int i = 0; i < n; i++) {
+						if (r < _weights[legal[i]]) {
+							pick = legal[i];
+							break;
+						}
+						r -= _weights[legal[i]];
+					}
+				}
+			}
+
+			s ^= jumps[pick].flip;
+		}
+
+		return jump_table::count_pegs(s);
+	}
+
+	playout_result playout_engine::run(t_state start, std::uint64_t count, unsigned threads, std::uint64_t seed) const {
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+
+		auto begin = std::chrono::steady_clock::now();
+
+		auto results = std::vector<playout_result>(threads, playout_result(_table.get_hole_count()));
+		auto workers = std::vector<std::thread>();
+
+		std::uint64_t seeds = seed;
+		for (unsigned t = 0; t < threads; t++) {
+			std::uint64_t share = count / threads + (t < count % threads ? 1 : 0);
+			std::uint64_t threadSeed = fast_random::split_mix(seeds);
+
+			workers.emplace_back([this, start, share, threadSeed, &result = results[t]]() {
+				fast_random rng(threadSeed);
+				if (_batch_size > 0) {
+					auto batch = batch_simulator(_table, _batch_size);
+					batch.set_weights(_weights);
+					batch.set_policy(_policy);
+					result.merge(batch.run(start, share, rng));
+					return;
+				}
+
+				for (std::uint64_t i = 0; i < share; i++)
+					result.add(play(start, rng));
+			});
+		}
+
+		auto total = playout_result(_table.get_hole_count());
+		for (unsigned t = 0; t < threads; t++) {
+			workers[t].join();
+			total.merge(results[t]);
+		}
+
+		total.set_seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+		return total;
+	}
+
+	std::vector<std::uint32_t> playout_engine::edge_weights(const jump_table& table) {
+		//a hole is on the edge when fewer lines pass through it than through the middle of the board
+		auto lines = std::vector<int>(table.get_hole_count(), 0);
+		for (const auto& j : table.get_jumps())
+			lines[j.over]++;
+		int most = *std::max_element(lines.begin(), lines.end());
+
+		auto weights = std::vector<std::uint32_t>();
+		for (const auto& j : table.get_jumps())
+			weights.push_back(lines[j.over] < most ? 2 : 1);
+		return weights;
+	}
+
+}
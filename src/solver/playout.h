@@ -0,0 +1,190 @@
+/**
+ * @file playout.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the playout_engine class, which plays random games to the end.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_PLAYOUT__
+#define __H_TRIANGLE_SOLVER_PLAYOUT__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../include/abstract/printable.h"
+
+#include "jump_table.h"
+#include "fast_random.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief How a playout picks the next jump.
+	 */
+	enum class playout_policy {
+		uniform,	//!< Every legal jump is equally likely.
+		weighted,	//!< Jumps are picked in proportion to their weight.
+		greedy		//!< The jump with the highest weight, ties are broken at random.
+	};
+
+	/**
+	 * @brief The Playout Result Class, the distribution of final peg counts over many playouts.
+	 */
+	class playout_result : public abstract::printable {
+		public:
+			/**
+			 * @brief Construct a new, empty, result for a board with the given number of holes.
+			 *
+			 * @param holes The number of holes on the board.
+			 */
+			playout_result(int holes);
+
+			/**
+			 * @brief Records a single playout that finished with the given number of pegs.
+			 *
+			 * @param pegsLeft The number of pegs left at the end of the playout.
+			 */
+			void add(int pegsLeft) noexcept;
+
+			/**
+			 * @brief Adds all the playouts of another result into this one.
+			 *
+			 * @param other The result to merge.
+			 */
+			void merge(const playout_result& other);
+
+			/**
+			 * @brief Returns how many playouts finished with the given number of pegs.
+			 *
+			 * @param pegsLeft The number of pegs left.
+			 * @return std::uint64_t The number of playouts.
+			 */
+			std::uint64_t get_count(int pegsLeft) const;
+
+			/**
+			 * @brief Returns the total number of playouts.
+			 *
+			 * @return std::uint64_t The number of playouts.
+			 */
+			std::uint64_t get_total() const noexcept;
+
+			/**
+			 * @brief Returns the average number of pegs left.
+			 *
+			 * @return double The average final peg count.
+			 */
+			double get_mean() const noexcept;
+
+			/**
+			 * @brief Returns the wall clock time taken by the playouts.
+			 *
+			 * @return double The time, in seconds.
+			 */
+			double get_seconds() const noexcept;
+
+			/**
+			 * @brief Sets the wall clock time taken by the playouts.
+			 *
+			 * @param seconds The time, in seconds.
+			 */
+			void set_seconds(double seconds) noexcept;
+
+			/**
+			 * @brief Creates a table of the final peg counts, and the playout rate.
+			 *
+			 * @return std::string The string representation of the result.
+			 */
+			std::string to_string() const noexcept;
+
+		private:
+			std::vector<std::uint64_t> _counts; //!< The number of playouts per final peg count.
+			std::uint64_t _total; //!< The total number of playouts.
+			double _seconds; //!< The wall clock time taken.
+	};
+
+	/**
+	 * @brief The Playout Engine Class, plays random games from a position to the end.
+	 *
+	 * Playouts run on a jump_table with no validation or history, and each thread has
+	 * its own generator. Thread t is seeded with the t-th splitmix64 number after the
+	 * given seed, and the playouts are split between threads the same way every time,
+	 * so a (seed, threads) pair always produces the same result.
+	 */
+	class playout_engine {
+		public:
+			/**
+			 * @brief Construct a new playout engine for the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the engine.
+			 */
+			playout_engine(const jump_table& table);
+
+			/**
+			 * @brief Sets how the next jump is picked.
+			 * The weighted and greedy policies default to edge_weights when no weights have been set.
+			 *
+			 * @param policy The policy to use.
+			 */
+			void set_policy(playout_policy policy);
+
+			/**
+			 * @brief Sets the weight of each jump for the weighted and greedy policies.
+			 *
+			 * @param weights One weight per jump in the jump table, zero disables a jump
+			 * unless it is the only one left.
+			 */
+			void set_weights(const std::vector<std::uint32_t>& weights);
+
+			/**
+			 * @brief Sets how many games each thread plays side by side, with a batch_simulator.
+			 *
+			 * @param games The number of games per batch, 0 plays one game at a time.
+			 */
+			void set_batch_size(std::size_t games) noexcept;
+
+			/**
+			 * @brief Plays a single random game from the given position.
+			 *
+			 * @param start The position to start from.
+			 * @param rng The generator to pick jumps with.
+			 * @return int The number of pegs left at the end.
+			 */
+			int play(t_state start, fast_random& rng) const noexcept;
+
+			/**
+			 * @brief Plays many random games from the given position.
+			 *
+			 * @param start The position to start from.
+			 * @param count The number of playouts.
+			 * @param threads The number of threads to use, 0 uses every core.
+			 * @param seed The seed of the first thread.
+			 * @return playout_result The distribution of final peg counts.
+			 */
+			playout_result run(t_state start, std::uint64_t count, unsigned threads, std::uint64_t seed) const;
+
+			/**
+			 * @brief The default weights of the weighted policy.
+			 * Jumps that remove a peg from the edge of the board get a weight of 2, the rest 1,
+			 * as edge pegs are the hardest ones to clear late in the game. A hole is on the
+			 * edge when fewer jumps pass over it than over the holes in the middle.
+			 *
+			 * @param table The jumps of the board.
+			 * @return std::vector<std::uint32_t> One weight per jump.
+			 */
+			static std::vector<std::uint32_t> edge_weights(const jump_table& table);
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			playout_policy _policy; //!< How the next jump is picked.
+			std::vector<std::uint32_t> _weights; //!< The weight of each jump.
+			std::size_t _batch_size; //!< The number of games per batch, 0 when not batching.
+	};
+
+}
+
+#endif
@@ -0,0 +1,287 @@
+#include "position_evaluator.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <sstream>
+#include <thread>
+
+#include "solver.h"
+
+namespace TriangleGame {
+
+	namespace {
+
+		/**
+		 * @brief A chunk of input lines, and the results written for them.
+		 */
+		struct evaluation_chunk {
+			std::vector<std::string> lines; //!< The lines read.
+			std::string results; //!< The lines written, in the same order.
+			std::uint64_t positions = 0; //!< The positions evaluated.
+			std::uint64_t solvable = 0; //!< The positions that can be won.
+			std::uint64_t invalid = 0; //!< The lines that were not positions.
+			bool stopped = false; //!< True when the chunk was stopped part way, its results end at the last position finished.
+			bool done = false; //!< True once every line has been evaluated.
+		};
+
+		/**
+		 * @brief Adds a number and a space to a line of results, without the cost of a stream.
+		 */
+		void append_number(std::string& line, std::uint64_t value, int base) {
+			char digits[24];
+			auto r = std::to_chars(digits, digits + sizeof(digits), value, base);
+			line.append(digits, r.ptr);
+			line += ' ';
+		}
+
+	}
+
+	position_evaluator::position_evaluator(std::size_t sharedBytes, std::size_t memoryLimit)
+		: _shared_bytes(sharedBytes), _memory_limit(memoryLimit), _shared_used(0), _heights(0), _threads(1), _solver_limit(0), _stop(nullptr),
+		_positions(0), _solvable(0), _invalid(0), _shared_hits(0), _seconds(0), _stopped(false)
+	{
+
+	}
+
+	void position_evaluator::set_stop_flag(const std::atomic<bool>* stop) noexcept {
+		_stop = stop;
+	}
+
+	bool position_evaluator::run(std::istream& in, std::ostream& out, unsigned threads) {
+		TRIANGLE_TRACE("position_evaluator::run");
+		auto begin = std::chrono::steady_clock::now();
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+
+		_positions = _solvable = _invalid = _shared_hits = 0;
+		_thread_positions.assign(threads, 0);
+		_stopped = false;
+		{
+			std::lock_guard<std::mutex> lock(_boards_mutex);
+			_threads = threads;
+			_split_memory();
+		}
+
+		std::mutex mutex;
+		std::condition_variable ready, finished;
+		std::deque<std::unique_ptr<evaluation_chunk>> pending; //every chunk read and not yet written, in order
+		std::deque<evaluation_chunk*> waiting; //the chunks no thread has taken yet
+		bool closed = false;
+
+		auto work = [&](unsigned thread) {
+			std::array<std::unique_ptr<solver>, MAX_STATE_HEIGHT + 1> solvers;
+			std::uint64_t hits = 0;
+
+			while (true) {
+				evaluation_chunk* chunk;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					ready.wait(lock, [&]() { return closed || !waiting.empty(); });
+					if (waiting.empty()) break;
+					chunk = waiting.front();
+					waiting.pop_front();
+				}
+
+				TRIANGLE_TRACE("position_evaluator::chunk", (std::int64_t)chunk->lines.size());
+				for (const auto& line : chunk->lines) {
+					int height;
+					t_state s;
+					if (!_parse(line, height, s)) {
+						chunk->results += line;
+						chunk->results += " E\n";
+						chunk->invalid++;
+						continue;
+					}
+
+					auto& solver = solvers[height];
+					if (!solver) {
+						auto& board = _board(height);
+						solver = std::make_unique<TriangleGame::solver>(*board.jumps);
+						solver->set_stop_flag(_stop);
+						solver->set_shared_table(board.shared.get());
+					}
+
+					//the split shrinks as more heights are read, and a solver over it is copied into a smaller table as it solves
+					solver->set_memory_limit(_solver_limit.load(std::memory_order_relaxed));
+
+					std::uint64_t before = solver->get_shared_hits();
+					int best = solver->solve(s);
+					hits += solver->get_shared_hits() - before;
+					if (best == UNSOLVED) {
+						chunk->stopped = true;
+						break;
+					}
+
+					append_number(chunk->results, height, 10);
+					append_number(chunk->results, s, 16);
+					append_number(chunk->results, (std::uint64_t)best, 10);
+					chunk->results += best == 1 ? "S\n" : "-\n";
+					chunk->positions++;
+					chunk->solvable += best == 1;
+				}
+
+				std::lock_guard<std::mutex> lock(mutex);
+				_thread_positions[thread] += chunk->positions;
+				chunk->done = true;
+				finished.notify_all();
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			_shared_hits += hits;
+		};
+
+		auto workers = std::vector<std::thread>();
+		for (unsigned t = 0; t < threads; t++)
+			workers.emplace_back(work, t);
+
+		//this thread reads ahead of the workers, and writes each chunk once it and every chunk before it are done
+		std::size_t most = EVALUATION_CHUNKS_PER_THREAD * threads;
+		bool reading = true, written = true;
+		while (true) {
+			while (reading && pending.size() < most) {
+				auto chunk = std::make_unique<evaluation_chunk>();
+				std::string line;
+				while (chunk->lines.size() < EVALUATION_CHUNK_LINES && std::getline(in, line)) {
+					if (!line.empty() && line.back() == '\r') line.pop_back();
+					if (line.empty() || line[0] == '#') continue;
+					chunk->lines.push_back(std::move(line));
+				}
+				if (chunk->lines.size() < EVALUATION_CHUNK_LINES) reading = false;
+				if (chunk->lines.empty()) break;
+
+				std::lock_guard<std::mutex> lock(mutex);
+				waiting.push_back(chunk.get());
+				pending.push_back(std::move(chunk));
+				ready.notify_one();
+			}
+
+			std::unique_ptr<evaluation_chunk> chunk;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if (pending.empty()) break;
+				finished.wait(lock, [&]() { return pending.front()->done; });
+				chunk = std::move(pending.front());
+				pending.pop_front();
+			}
+
+			TRIANGLE_TRACE("position_evaluator::write", (std::int64_t)chunk->results.size());
+			written = written && (bool)out.write(chunk->results.data(), (std::streamsize)chunk->results.size());
+			_positions += chunk->positions;
+			_solvable += chunk->solvable;
+			_invalid += chunk->invalid;
+
+			//once a chunk is stopped, the ones after it are not written, so the output is still in order
+			if (chunk->stopped || !written) {
+				_stopped = chunk->stopped;
+				break;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			waiting.clear();
+			closed = true;
+			ready.notify_all();
+		}
+		for (auto& w : workers)
+			w.join();
+
+		written = (bool)out.flush() && written;
+		_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		return written && !_stopped;
+	}
+
+	std::uint64_t position_evaluator::get_positions() const noexcept {
+		return _positions;
+	}
+
+	std::uint64_t position_evaluator::get_solvable() const noexcept {
+		return _solvable;
+	}
+
+	std::uint64_t position_evaluator::get_invalid() const noexcept {
+		return _invalid;
+	}
+
+	const std::vector<std::uint64_t>& position_evaluator::get_thread_positions() const noexcept {
+		return _thread_positions;
+	}
+
+	double position_evaluator::get_seconds() const noexcept {
+		return _seconds;
+	}
+
+	bool position_evaluator::was_stopped() const noexcept {
+		return _stopped;
+	}
+
+	std::string position_evaluator::to_string() const noexcept {
+		std::stringstream ss;
+		ss << "Positions: " << _positions << ", Solvable: " << _solvable << ", Not Positions: " << _invalid
+			<< ", Found in the Shared Tables: " << _shared_hits << std::endl;
+		ss << "Seconds: " << _seconds << ", Positions per Second: " << (std::uint64_t)(_seconds > 0 ? _positions / _seconds : 0) << std::endl;
+
+		ss << "Thread\tPositions" << std::endl;
+		for (std::size_t t = 0; t < _thread_positions.size(); t++)
+			ss << t << "\t" << _thread_positions[t] << std::endl;
+		return ss.str();
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	position_evaluator::board_tables& position_evaluator::_board(int height) {
+		std::lock_guard<std::mutex> lock(_boards_mutex);
+		auto& board = _boards[height];
+		if (!board.jumps) {
+			std::size_t bytes = _shared_bytes;
+			if (_memory_limit > 0)
+				bytes = std::min(bytes, (_memory_limit - std::min(_memory_limit, _shared_used)) / 2);
+
+			board.jumps = std::make_unique<jump_table>(height);
+			board.shared = std::make_unique<shared_table>(bytes);
+			_shared_used += board.shared->get_bytes();
+			_heights++;
+			_split_memory();
+		}
+		return board;
+	}
+
+	void position_evaluator::_split_memory() noexcept {
+		if (_memory_limit == 0) return;
+
+		//a solver's limit of 0 is no limit, so one with nothing left is limited to nothing
+		std::size_t left = _memory_limit - std::min(_memory_limit, _shared_used);
+		std::size_t solvers = (std::size_t)_threads * std::max(_heights, 1);
+		_solver_limit.store(std::max<std::size_t>(left / solvers, 1), std::memory_order_relaxed);
+	}
+
+	bool position_evaluator::_parse(const std::string& line, int& height, t_state& s) noexcept {
+		const char* p = line.data();
+		const char* end = p + line.size();
+
+		auto skip = [&]() { while (p < end && (*p == ' ' || *p == '\t')) p++; };
+		skip();
+		auto r = std::from_chars(p, end, height);
+		if (r.ec != std::errc() || !jump_table::supports(height)) return false;
+		p = r.ptr;
+
+		skip();
+		if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) p += 2;
+		r = std::from_chars(p, end, s, 16);
+		if (r.ec != std::errc()) return false;
+		p = r.ptr;
+		skip();
+		if (p != end) return false;
+
+		//every peg must be in a hole of the board, and there must be at least one
+		int holes = height * (height + 1) / 2;
+		return s != 0 && (s >> holes) == 0;
+	}
+
+}
@@ -0,0 +1,187 @@
+/**
+ * @file position_evaluator.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the position_evaluator class, which solves a stream of positions across a pool of threads.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_POSITION_EVALUATOR__
+#define __H_TRIANGLE_SOLVER_POSITION_EVALUATOR__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../include/abstract/printable.h"
+
+#include "jump_table.h"
+#include "shared_table.h"
+
+namespace TriangleGame {
+
+	const std::size_t EVALUATION_CHUNK_LINES = 256; //!< The lines of input handed to a thread at a time, few enough that a short file of hard positions is still shared out.
+	const std::size_t EVALUATION_CHUNKS_PER_THREAD = 4; //!< The chunks read ahead of the output, for each thread.
+	const std::size_t DEFAULT_SHARED_TABLE_BYTES = (std::size_t)64 << 20; //!< The memory of each board's shared table.
+
+	/**
+	 * @brief The Position Evaluator Class, finds the fewest pegs that can be left from every
+	 * position of a stream, and whether it can be won.
+	 *
+	 * Each line of the input is the height of a triangle board and a position on it, as a
+	 * hexadecimal bitset of the holes with pegs, "5 7ffe". The input is read a chunk of lines
+	 * at a time, which are shared out to a pool of threads, and only a few chunks per thread
+	 * are ever held, so a file of any size streams through in a fixed amount of memory. The
+	 * results are written in the order of the input, "5 7ffe 1 S", where S marks a position
+	 * that can be won and - one that cannot, and a line that is not a position is written
+	 * back with an E. Blank lines and lines starting with # are skipped.
+	 *
+	 * Each thread keeps its own solver for each height, whose table carries over from one
+	 * position to the next, and the threads on the same height share their results through a
+	 * shared_table, so positions from the same games are only searched by the first thread to
+	 * reach them.
+	 *
+	 * The memory limit covers the shared tables and the solvers. Each height's shared table
+	 * takes at most half of what the tables before it left, and the rest is split between
+	 * the solvers of every thread and height in use, which shrink as more heights are read.
+	 */
+	class position_evaluator : public abstract::printable {
+		public:
+			/**
+			 * @brief Construct a new evaluator.
+			 *
+			 * @param sharedBytes The memory of the table shared by the threads, for each height evaluated.
+			 * @param memoryLimit The most memory the shared tables and the solvers can use, in bytes, 0 for no limit.
+			 */
+			position_evaluator(std::size_t sharedBytes = DEFAULT_SHARED_TABLE_BYTES, std::size_t memoryLimit = 0);
+
+			/**
+			 * @brief Sets a flag that stops the evaluation when it becomes true.
+			 * The positions evaluated before it stopped are still written.
+			 *
+			 * @param stop The flag to check, or nullptr to never stop.
+			 */
+			void set_stop_flag(const std::atomic<bool>* stop) noexcept;
+
+			/**
+			 * @brief Evaluates every position of the input, writing a line for each.
+			 *
+			 * @param in The positions.
+			 * @param out The results.
+			 * @param threads The number of threads to use, 0 uses every core.
+			 * @return true If every position was evaluated and written.
+			 * @return false If it was stopped, or the output could not be written.
+			 */
+			bool run(std::istream& in, std::ostream& out, unsigned threads = 0);
+
+			/**
+			 * @brief Returns the number of positions evaluated by the last run.
+			 *
+			 * @return std::uint64_t The number of positions.
+			 */
+			std::uint64_t get_positions() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions that can be won, of the last run.
+			 *
+			 * @return std::uint64_t The number of positions.
+			 */
+			std::uint64_t get_solvable() const noexcept;
+
+			/**
+			 * @brief Returns the number of lines of the last run that were not positions.
+			 *
+			 * @return std::uint64_t The number of lines.
+			 */
+			std::uint64_t get_invalid() const noexcept;
+
+			/**
+			 * @brief Returns the positions each thread of the last run evaluated.
+			 *
+			 * @return const std::vector<std::uint64_t>& The positions, by thread.
+			 */
+			const std::vector<std::uint64_t>& get_thread_positions() const noexcept;
+
+			/**
+			 * @brief Returns the time the last run took.
+			 *
+			 * @return double The time, in seconds.
+			 */
+			double get_seconds() const noexcept;
+
+			/**
+			 * @brief Determinds if the last run was stopped before the end of its input.
+			 */
+			bool was_stopped() const noexcept;
+
+			/**
+			 * @brief Creates a summary of the last run, with its rate and the work of each thread.
+			 *
+			 * @return std::string The string representation of the run.
+			 */
+			std::string to_string() const noexcept;
+
+		private:
+			/**
+			 * @brief The jumps and shared results of one height, made when its first position is read.
+			 */
+			struct board_tables {
+				std::unique_ptr<jump_table> jumps; //!< The jumps of the board.
+				std::unique_ptr<shared_table> shared; //!< The results shared by the threads.
+			};
+
+			std::size_t _shared_bytes; //!< The memory of each shared table.
+			std::size_t _memory_limit; //!< The most memory the shared tables and the solvers can use, 0 for no limit.
+			std::size_t _shared_used; //!< The memory of the shared tables made so far.
+			int _heights; //!< The number of heights whose tables have been made.
+			unsigned _threads; //!< The number of threads of the run.
+			std::atomic<std::size_t> _solver_limit; //!< The memory each solver can use, 0 for no limit.
+			const std::atomic<bool>* _stop; //!< Stops the evaluation when true.
+			std::mutex _boards_mutex; //!< Guards making the tables of a height.
+			std::array<board_tables, MAX_STATE_HEIGHT + 1> _boards; //!< The tables of each height, by height.
+			std::uint64_t _positions; //!< The positions evaluated by the last run.
+			std::uint64_t _solvable; //!< The positions that can be won.
+			std::uint64_t _invalid; //!< The lines that were not positions.
+			std::uint64_t _shared_hits; //!< The positions the threads found in the shared tables.
+			std::vector<std::uint64_t> _thread_positions; //!< The positions each thread evaluated.
+			double _seconds; //!< The time the last run took.
+			bool _stopped; //!< True when the last run was stopped.
+
+			/**
+			 * @brief Returns the tables of a height, making them the first time.
+			 *
+			 * @param height The height of the board, from 1 to MAX_STATE_HEIGHT.
+			 * @return board_tables& The tables.
+			 */
+			board_tables& _board(int height);
+
+			/**
+			 * @brief Splits what the shared tables leave of the memory limit between the solvers
+			 * of every thread and height in use. Must be called with the boards mutex held.
+			 */
+			void _split_memory() noexcept;
+
+			/**
+			 * @brief Reads a line of input as a position.
+			 *
+			 * @param line The line.
+			 * @param height The returned height of the board.
+			 * @param s The returned position.
+			 * @return true If the line is a position on a supported board.
+			 * @return false Otherwise.
+			 */
+			static bool _parse(const std::string& line, int& height, t_state& s) noexcept;
+	};
+
+}
+
+#endif
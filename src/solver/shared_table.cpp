@@ -0,0 +1,26 @@
+#include "shared_table.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace TriangleGame {
+
+	shared_table::shared_table(std::size_t bytes) {
+		std::size_t slots = std::bit_floor(std::max<std::size_t>(bytes / sizeof(slot), 1));
+		_slots = std::make_unique<slot[]>(slots);
+		_mask = slots - 1;
+		for (std::size_t i = 0; i < slots; i++) {
+			_slots[i].data.store(0, std::memory_order_relaxed);
+			_slots[i].check.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	std::size_t shared_table::get_slots() const noexcept {
+		return _mask + 1;
+	}
+
+	std::size_t shared_table::get_bytes() const noexcept {
+		return (_mask + 1) * sizeof(slot);
+	}
+
+}
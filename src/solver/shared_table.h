@@ -0,0 +1,122 @@
+/**
+ * @file shared_table.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the shared_table class, a fixed size table of solved positions that many threads can use at once without locks.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_SHARED_TABLE__
+#define __H_TRIANGLE_SOLVER_SHARED_TABLE__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "jump_table.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief The Shared Table Class, the fewest pegs that can be left from solved positions,
+	 * shared by every thread solving on the same board.
+	 *
+	 * Each slot is two words, written and read without a lock: the result with the
+	 * position's hash above it, and the position xored with the first word. A read only
+	 * hits when the two words agree, so a slot torn by two threads writing at once reads as
+	 * a miss, as the hash bits would have to match by chance. A position's slot is picked
+	 * by the bits of its hash above the result, and a new position always replaces the old, so the table is lossy, and
+	 * never grows past the size it was made with.
+	 */
+	class shared_table {
+		public:
+			/**
+			 * @brief Construct a new, empty, table.
+			 *
+			 * @param bytes The memory to use, rounded down to a power of two slots, at least one.
+			 */
+			shared_table(std::size_t bytes);
+
+			/**
+			 * @brief Looks up a position.
+			 *
+			 * @param s The position.
+			 * @param best The returned fewest pegs that can be left, when found.
+			 * @return true If the position was found.
+			 * @return false Otherwise.
+			 */
+			bool find(t_state s, int& best) const noexcept {
+				std::uint64_t h = _hash(s);
+				const auto& entry = _slots[(h >> 8) & _mask];
+				std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+				std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+				if ((check ^ data) != s || (data & ~RESULT_MASK) != (h & ~RESULT_MASK)) return false;
+
+				best = (int)(data & RESULT_MASK);
+				return true;
+			}
+
+			/**
+			 * @brief Stores a position, replacing whichever position was in its slot.
+			 *
+			 * @param s The position.
+			 * @param best The fewest pegs that can be left from it.
+			 */
+			void store(t_state s, int best) noexcept {
+				std::uint64_t h = _hash(s);
+				auto& entry = _slots[(h >> 8) & _mask];
+				std::uint64_t data = (h & ~RESULT_MASK) | (std::uint64_t)best;
+				entry.data.store(data, std::memory_order_relaxed);
+				entry.check.store(s ^ data, std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Returns the number of slots.
+			 *
+			 * @return std::size_t The number of positions the table can hold.
+			 */
+			std::size_t get_slots() const noexcept;
+
+			/**
+			 * @brief Returns the memory used by the table.
+			 *
+			 * @return std::size_t The memory, in bytes.
+			 */
+			std::size_t get_bytes() const noexcept;
+
+		private:
+			static const std::uint64_t RESULT_MASK = 0x7F; //!< The bits of a slot's first word holding the result.
+
+			/**
+			 * @brief A slot, a position and its result, in two words that are checked against each other.
+			 */
+			struct slot {
+				std::atomic<std::uint64_t> data; //!< The result, with the position's hash above it, 0 when empty.
+				std::atomic<std::uint64_t> check; //!< The position xored with data.
+			};
+
+			std::unique_ptr<slot[]> _slots; //!< The slots.
+			std::size_t _mask; //!< The number of slots, less one.
+
+			/**
+			 * @brief Returns the hash of a position, mixed, since positions of a game share most of their bits.
+			 */
+			static std::uint64_t _hash(t_state s) noexcept {
+				s ^= s >> 30;
+				s *= 0xbf58476d1ce4e5b9ULL;
+				s ^= s >> 27;
+				s *= 0x94d049bb133111ebULL;
+				s ^= s >> 31;
+
+				//never 0 above the result, so an empty slot never matches
+				return s | (RESULT_MASK + 1);
+			}
+	};
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "solution_stream.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief A position of the walk, and the jumps from it still to try.
+	 */
+	struct solution_frame {
+		t_state state; //!< The position.
+		int count; //!< The number of legal jumps.
+		int next; //!< The index of the next jump to try.
+		t_jump_id legal[MAX_JUMPS]; //!< The legal jumps, in the order of the jump table.
+	};
+
+	solution_stream::solution_stream(const jump_table& table)
+		: _table(table), _solver(table), _stopped(false), _count(0), _walked(0), _dead_ends(0)
+	{
+
+	}
+
+	void solution_stream::set_stop_flag(const std::atomic<bool>* stop) noexcept {
+		_solver.set_stop_flag(stop);
+	}
+
+	void solution_stream::set_memory_limit(std::size_t bytes) noexcept {
+		_solver.set_memory_limit(bytes);
+	}
+
+	generator<std::vector<t_jump_id>> solution_stream::solutions(t_state s) {
+		_stopped = false;
+		_count = 0;
+		_walked = 0;
+		_dead_ends = 0;
+		if (!_winnable(s)) co_return;
+
+		const auto& jumps = _table.get_jumps();
+		auto path = std::vector<t_jump_id>();
+		if (jump_table::count_pegs(s) == 1) {
+			_count++;
+			co_yield path;
+			co_return;
+		}
+
+		//the stack holds a frame for the start and each jump of the path
+		auto stack = std::vector<solution_frame>(1);
+		stack[0].state = s;
+		stack[0].count = _table.get_legal_jumps(s, stack[0].legal);
+		stack[0].next = 0;
+
+		while (!stack.empty()) {
+			auto& top = stack.back();
+			if (top.next == top.count) {
+				stack.pop_back();
+				if (!stack.empty()) path.pop_back();
+				continue;
+			}
+
+			t_jump_id id = top.legal[top.next++];
+			t_state child = top.state ^ jumps[id].flip;
+			if (!_winnable(child)) {
+				if (_stopped) co_return;
+				_dead_ends++;
+				continue;
+			}
+
+			_walked++;
+			path.push_back(id);
+			if (jump_table::count_pegs(child) == 1) {
+				_count++;
+				co_yield path;
+				path.pop_back();
+				continue;
+			}
+
+			auto& frame = stack.emplace_back();
+			frame.state = child;
+			frame.count = _table.get_legal_jumps(child, frame.legal);
+			frame.next = 0;
+		}
+	}
+
+	bool solution_stream::was_stopped() const noexcept {
+		return _stopped;
+	}
+
+	std::uint64_t solution_stream::get_count() const noexcept {
+		return _count;
+	}
+
+	std::uint64_t solution_stream::get_walked() const noexcept {
+		return _walked;
+	}
+
+	std::uint64_t solution_stream::get_dead_ends() const noexcept {
+		return _dead_ends;
+	}
+
+	std::size_t solution_stream::get_table_size() const noexcept {
+		return _solver.get_table_size();
+	}
+
+	std::size_t solution_stream::get_peak_memory() const noexcept {
+		return _solver.get_peak_memory();
+	}
+
+	const std::vector<std::string>& solution_stream::get_memory_events() const noexcept {
+		return _solver.get_memory_events();
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	bool solution_stream::_winnable(t_state s) {
+		int best = _solver.solve(s);
+		if (best == UNSOLVED) _stopped = true;
+		return best == 1;
+	}
+
+}
@@ -0,0 +1,144 @@
+/**
+ * @file solution_stream.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the solution_stream class, which yields every sequence of jumps that leaves a single peg, one at a time.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_SOLUTION_STREAM__
+#define __H_TRIANGLE_SOLVER_SOLUTION_STREAM__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "jump_table.h"
+#include "solver.h"
+#include "generator.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief The Solution Stream Class, yields every sequence of jumps that leaves a single
+	 * peg, one at a time, without holding more than the one being yielded.
+	 *
+	 * The solutions are walked depth first, trying the jumps of each position in the order
+	 * of the jump table, so they always come out in the same order. Before a jump is made,
+	 * the position it reaches is solved, and it is only walked into when a single peg can
+	 * still be left, so every branch walked ends in at least one solution, and no losing
+	 * position is ever expanded. The solver keeps its table between positions, so a dead
+	 * position is only searched the first time it is reached.
+	 *
+	 * The walk is a coroutine that only runs when the next solution is asked for, so a
+	 * caller that writes each one out before asking for the next never gets ahead of its
+	 * output, however many solutions there are.
+	 */
+	class solution_stream {
+		public:
+			/**
+			 * @brief Construct a new solution stream for the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the stream.
+			 */
+			solution_stream(const jump_table& table);
+
+			/**
+			 * @brief Sets a flag that stops the walk when it becomes true.
+			 *
+			 * @param stop The flag to check, or nullptr to never stop.
+			 */
+			void set_stop_flag(const std::atomic<bool>* stop) noexcept;
+
+			/**
+			 * @brief Sets the most memory the table of solved positions can use.
+			 *
+			 * @param bytes The memory limit, or 0 for no limit.
+			 */
+			void set_memory_limit(std::size_t bytes) noexcept;
+
+			/**
+			 * @brief Walks every sequence of jumps from the given position that leaves a single peg.
+			 * The stream must outlive the generator, and only one walk can run at a time.
+			 *
+			 * @param s The position to start from.
+			 * @return generator<std::vector<t_jump_id>> The solutions, each only valid until the next is asked for.
+			 */
+			generator<std::vector<t_jump_id>> solutions(t_state s);
+
+			/**
+			 * @brief Determinds if the last walk was stopped before it finished.
+			 *
+			 * @return true If the walk was stopped.
+			 * @return false Otherwise.
+			 */
+			bool was_stopped() const noexcept;
+
+			/**
+			 * @brief Returns the number of solutions yielded by the last walk.
+			 *
+			 * @return std::uint64_t The number of solutions.
+			 */
+			std::uint64_t get_count() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions walked into by the last walk.
+			 *
+			 * @return std::uint64_t The number of positions.
+			 */
+			std::uint64_t get_walked() const noexcept;
+
+			/**
+			 * @brief Returns the number of jumps the last walk did not make, as they reach a position that can not be won.
+			 *
+			 * @return std::uint64_t The number of jumps.
+			 */
+			std::uint64_t get_dead_ends() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions solved, kept between walks.
+			 *
+			 * @return std::size_t The number of positions stored.
+			 */
+			std::size_t get_table_size() const noexcept;
+
+			/**
+			 * @brief Returns the most memory the table of solved positions has used.
+			 *
+			 * @return std::size_t The peak memory, in bytes.
+			 */
+			std::size_t get_peak_memory() const noexcept;
+
+			/**
+			 * @brief Returns a line for each step the table was degraded by, to stay in the memory limit.
+			 *
+			 * @return const std::vector<std::string>& The steps, in the order they happened.
+			 */
+			const std::vector<std::string>& get_memory_events() const noexcept;
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			solver _solver; //!< Finds the positions that can still be won.
+			bool _stopped; //!< True when the last walk was stopped.
+			std::uint64_t _count; //!< The number of solutions yielded.
+			std::uint64_t _walked; //!< The number of positions walked into.
+			std::uint64_t _dead_ends; //!< The number of jumps not made.
+
+			/**
+			 * @brief Determinds if a single peg can be left from a position.
+			 *
+			 * @param s The position.
+			 * @return true If it can.
+			 * @return false If it can not, or the walk was stopped.
+			 */
+			bool _winnable(t_state s);
+	};
+
+}
+
+#endif
@@ -0,0 +1,477 @@
+#include "solver.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace TriangleGame {
+
+	namespace {
+
+		const char CHECKPOINT_MAGIC[4] = { 'T', 'G', 'C', 'K' };
+		const char CHECKPOINT_VERSION = 2; //!< Version 2 adds the positions reached by the partial order reduction.
+		const std::uint64_t TICK_NODES = 0x3FFF; //!< Progress and checkpoints are checked every 16384 nodes.
+
+		void write_u64(std::ostream& out, std::uint64_t v) {
+			char buf[8];
+			for (int i = 0; i < 8; i++)
+				buf[i] = (char)(v >> (8 * i));
+			out.write(buf, 8);
+		}
+
+		bool read_u64(std::istream& in, std::uint64_t& v) {
+			unsigned char buf[8];
+			if (!in.read((char*)buf, 8)) return false;
+			v = 0;
+			for (int i = 0; i < 8; i++)
+				v |= (std::uint64_t)buf[i] << (8 * i);
+			return true;
+		}
+
+		/**
+		 * @brief A hash of the board's jumps, so a checkpoint is never loaded into a different board.
+		 */
+		std::uint64_t fingerprint(const jump_table& table) {
+			std::uint64_t h = (std::uint64_t)table.get_hole_count();
+			for (const auto& j : table.get_jumps())
+				h ^= j.flip + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+			return h;
+		}
+
+	}
+
+	solver::solver(const jump_table& table)
+		: _table(table), _stop(nullptr), _shared(nullptr), _shared_hits(0), _reduction(false), _best(0), _nodes(0), _pruned(0), _probes(0),
+		_memory_limit(0), _memory_noted(false), _root(0), _words((table.get_jumps().size() + 63) / 64), _depth(0), _solving(false),
+		_seconds(0), _checkpoint_seconds(0), _next_checkpoint(0),
+		_progress(nullptr), _progress_seconds(0), _next_progress(0), _progress_nodes(0)
+	{
+		//a search is never deeper than the board has holes, so the stack never grows past the memory limit
+		_stack.reserve(table.get_hole_count());
+
+		//two jumps commute when they touch different holes
+		const auto& jumps = table.get_jumps();
+		_commuting.resize(jumps.size() * _words);
+		for (std::size_t a = 0; a < jumps.size(); a++) {
+			for (std::size_t b = 0; b < jumps.size(); b++) {
+				if ((jumps[a].flip & jumps[b].flip) == 0)
+					_commuting[a * _words + b / 64] |= std::uint64_t(1) << (b % 64);
+			}
+		}
+		_sleep.resize((table.get_hole_count() + 1) * _words);
+	}
+
+	void solver::set_stop_flag(const std::atomic<bool>* stop) noexcept {
+		_stop = stop;
+	}
+
+	void solver::set_shared_table(shared_table* table) noexcept {
+		_shared = table;
+	}
+
+	std::uint64_t solver::get_shared_hits() const noexcept {
+		return _shared_hits;
+	}
+
+	void solver::set_reduction(bool on) noexcept {
+		_reduction = on;
+	}
+
+	void solver::set_memory_limit(std::size_t bytes) noexcept {
+		if (bytes != _memory_limit) _memory_noted = false;
+		_memory_limit = bytes;
+	}
+
+	int solver::solve(t_state s) {
+		TRIANGLE_TRACE("solver::solve", jump_table::count_pegs(s));
+		//the positions reached only count towards the root they were reached from
+		if (_reduction && (s != _root || _reached.empty())) {
+			_reached.clear();
+			_best = jump_table::count_pegs(s);
+		}
+
+		_apply_memory_limit();
+		_root = s;
+		_depth = 0;
+		_solving = true;
+		_started = std::chrono::steady_clock::now();
+		_next_checkpoint = _seconds + _checkpoint_seconds;
+		_next_progress = _seconds + _progress_seconds;
+		_progress_nodes = _nodes;
+
+		int result = UNSOLVED;
+		if (!_reduction) {
+			result = _search(s);
+		} else {
+			//nothing sleeps at the root
+			std::fill_n(_sleep.begin(), _words, 0);
+			if (_reach(s)) result = _best;
+		}
+
+		_seconds = get_seconds();
+		_solving = false;
+		if (!_checkpoint_path.empty())
+			save_checkpoint(_checkpoint_path);
+		return result;
+	}
+
+	bool solver::get_best_jump(t_state s, t_jump_id& id, int& pegsLeft) {
+		TRIANGLE_TRACE("solver::get_best_jump", jump_table::count_pegs(s));
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+		int n = _table.get_legal_jumps(s, legal);
+
+		pegsLeft = jump_table::count_pegs(s);
+		if (n == 0) return false;
+
+		_apply_memory_limit();
+		_depth = 0;
+		int best = UNSOLVED;
+		for (int i = 0; i < n; i++) {
+			int v = _search(s ^ jumps[legal[i]].flip);
+			if (v == UNSOLVED) return false;
+
+			if (best == UNSOLVED || v < best) {
+				best = v;
+				id = legal[i];
+			}
+		}
+
+		pegsLeft = best;
+		return true;
+	}
+
+	void solver::set_checkpoint(const std::string& path, double seconds) {
+		_checkpoint_path = path;
+		_checkpoint_seconds = seconds;
+	}
+
+	void solver::set_progress(std::ostream* out, double seconds) {
+		_progress = out;
+		_progress_seconds = seconds;
+	}
+
+	bool solver::save_checkpoint(const std::string& path) const {
+		TRIANGLE_TRACE("solver::save_checkpoint");
+		std::string temp = path + ".tmp";
+		{
+			std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+			if (!out) return false;
+
+			out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+			out.put(CHECKPOINT_VERSION);
+			write_u64(out, fingerprint(_table));
+			write_u64(out, _root);
+			write_u64(out, _nodes);
+			write_u64(out, (std::uint64_t)(get_seconds() * 1000));
+
+			write_u64(out, (std::uint64_t)_depth);
+			for (int d = 0; d < _depth; d++)
+				write_u64(out, ((std::uint64_t)_stack[d].first << 16) | _stack[d].second);
+
+			write_u64(out, _tt.size());
+			_tt.for_each([&](t_state state, std::uint8_t best) {
+				write_u64(out, state);
+				out.put((char)best);
+			});
+
+			write_u64(out, (std::uint64_t)_best);
+			write_u64(out, _reached.size());
+			_reached.for_each([&](t_state state, std::uint64_t skipped) {
+				write_u64(out, state);
+				write_u64(out, skipped);
+			});
+
+			out.flush();
+			if (!out.good()) return false;
+		}
+
+		return std::rename(temp.c_str(), path.c_str()) == 0;
+	}
+
+	bool solver::load_checkpoint(const std::string& path, t_state& root) {
+		TRIANGLE_TRACE("solver::load_checkpoint");
+		std::ifstream in(path, std::ios::binary);
+		if (!in) return false;
+
+		char magic[sizeof(CHECKPOINT_MAGIC)];
+		if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) return false;
+		int version = in.get();
+		if (version != 1 && version != CHECKPOINT_VERSION) return false;
+
+		std::uint64_t print, r, nodes, millis, depth, size;
+		if (!read_u64(in, print) || print != fingerprint(_table)) return false;
+		if (!read_u64(in, r) || !read_u64(in, nodes) || !read_u64(in, millis)) return false;
+		if ((r & ~_table.get_full_state()) != 0) return false;
+
+		if (!read_u64(in, depth) || depth > (std::uint64_t)_table.get_hole_count()) return false;
+		auto stack = std::vector<std::pair<std::uint16_t, std::uint16_t> >();
+		for (std::uint64_t d = 0; d < depth; d++) {
+			std::uint64_t v;
+			if (!read_u64(in, v)) return false;
+			stack.push_back({ (std::uint16_t)(v >> 16), (std::uint16_t)v });
+		}
+
+		if (!read_u64(in, size)) return false;
+		//the checkpoint may have been written under a bigger limit, so the tables keep the positions with the most pegs
+		auto tt = t_transposition_table();
+		tt.set_limit(_table_limit());
+		for (std::uint64_t i = 0; i < size; i++) {
+			std::uint64_t state;
+			int value = 0;
+			if (!read_u64(in, state) || (value = in.get()) == EOF) return false;
+			if (state != 0) tt.store(state, (std::uint8_t)value);
+		}
+
+		//version 1 checkpoints were written before the partial order reduction
+		std::uint64_t best = 0;
+		auto reached = t_reached_table();
+		reached.set_limit(_table_limit());
+		if (version >= 2) {
+			if (!read_u64(in, best) || !read_u64(in, size)) return false;
+			for (std::uint64_t i = 0; i < size; i++) {
+				std::uint64_t state, skipped;
+				if (!read_u64(in, state) || !read_u64(in, skipped)) return false;
+				if (state != 0) reached.store(state, skipped);
+			}
+		}
+
+		_tt = std::move(tt);
+		_reached = std::move(reached);
+		_best = (int)best;
+		_root = root = r;
+		_nodes = nodes;
+		_seconds = millis / 1000.0;
+		_stack = stack;
+		_depth = (int)depth;
+		return true;
+	}
+
+	double solver::get_progress() const noexcept {
+		double done = 0, share = 1;
+		for (int d = 0; d < _depth; d++) {
+			if (_stack[d].second == 0) break;
+			share /= _stack[d].second;
+			done += share * _stack[d].first;
+		}
+		return done;
+	}
+
+	double solver::get_seconds() const noexcept {
+		if (!_solving) return _seconds;
+		return _seconds + std::chrono::duration<double>(std::chrono::steady_clock::now() - _started).count();
+	}
+
+	std::uint64_t solver::get_nodes() const noexcept {
+		return _nodes;
+	}
+
+	std::size_t solver::get_table_size() const noexcept {
+		return _reduction ? _reached.size() : _tt.size();
+	}
+
+	std::size_t solver::get_memory_used() const noexcept {
+		return _tt.get_bytes() + _reached.get_bytes() + _stack.capacity() * sizeof(_stack[0]);
+	}
+
+	std::size_t solver::get_peak_memory() const noexcept {
+		return _tt.get_peak_bytes() + _reached.get_peak_bytes() + _stack.capacity() * sizeof(_stack[0]);
+	}
+
+	const std::vector<std::string>& solver::get_memory_events() const noexcept {
+		return _memory_events;
+	}
+
+	std::uint64_t solver::get_pruned() const noexcept {
+		return _pruned;
+	}
+
+	std::uint64_t solver::get_probes() const noexcept {
+		return _probes;
+	}
+
+	void solver::clear() {
+		TRIANGLE_TRACE("solver::clear");
+		_tt.clear();
+		_reached.clear();
+	}
+
+	//--------------------------------------------------
+	// Private Methods
+	//--------------------------------------------------
+
+	int solver::_search(t_state s) {
+		_probes++;
+		const auto* known = _tt.find(s);
+		if (known != nullptr)
+			return *known;
+
+		int pegs = jump_table::count_pegs(s);
+		bool shared = _shared != nullptr && pegs >= SHARED_MIN_PEGS;
+		int found;
+		if (shared && _shared->find(s, found)) {
+			_shared_hits++;
+			return found;
+		}
+
+		if (_stop != nullptr && _stop->load(std::memory_order_relaxed))
+			return UNSOLVED;
+
+		_nodes++;
+		if ((_nodes & TICK_NODES) == 0 && _solving)
+			_tick();
+
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+		int n = _table.get_legal_jumps(s, legal);
+
+		if (_depth >= (int)_stack.size())
+			_stack.resize(_depth + 1);
+
+		int best = pegs;
+		for (int i = 0; i < n && best > 1; i++) {
+			_stack[_depth] = { (std::uint16_t)i, (std::uint16_t)n };
+			_depth++;
+			int v = _search(s ^ jumps[legal[i]].flip);
+
+			//a stopped search leaves the stack where it stopped, for the checkpoint
+			if (v == UNSOLVED) return UNSOLVED;
+			_depth--;
+			if (v < best) best = v;
+		}
+
+		//a position with jumps left can always do better than its own peg count,
+		//so starting best at the peg count is only ever kept for finished games.
+		if (shared) _shared->store(s, best);
+		_store(_tt, s, (std::uint8_t)best);
+		return best;
+	}
+
+	bool solver::_reach(t_state s) {
+		_probes++;
+		const auto* stored = _reached.find(s);
+		if (stored != nullptr && *stored == 0)
+			return true;
+
+		if (_stop != nullptr && _stop->load(std::memory_order_relaxed))
+			return false;
+
+		const auto& jumps = _table.get_jumps();
+		t_jump_id legal[MAX_JUMPS];
+		int n = _table.get_legal_jumps(s, legal);
+
+		//only the first 64 legal jumps are tracked, the rest are always made
+		const std::uint64_t* sleep = &_sleep[_depth * _words];
+		std::uint64_t asleep = 0;
+		for (int i = 0; i < n && i < 64; i++) {
+			if (sleep[legal[i] / 64] >> (legal[i] % 64) & 1)
+				asleep |= std::uint64_t(1) << i;
+		}
+
+		//a position reached before only makes the jumps that were asleep every time, and are awake now,
+		//and the jumps it made then are searched, so they do not sleep below it
+		std::uint64_t make = ~asleep;
+		std::uint64_t keep = asleep;
+		if (stored != nullptr) {
+			make = *stored & ~asleep;
+			if (make == 0) return true;
+			keep &= *stored;
+			_pruned -= __builtin_popcountll(make);
+		} else {
+			_pruned += __builtin_popcountll(asleep);
+		}
+
+		std::uint64_t sleeping[MAX_JUMPS / 64] = {};
+		for (int i = 0; i < n && i < 64; i++) {
+			if (keep >> i & 1)
+				sleeping[legal[i] / 64] |= std::uint64_t(1) << (legal[i] % 64);
+		}
+
+		_nodes++;
+		if ((_nodes & TICK_NODES) == 0 && _solving)
+			_tick();
+
+		if (_depth >= (int)_stack.size())
+			_stack.resize(_depth + 1);
+
+		_best = std::min(_best, jump_table::count_pegs(s));
+		for (int i = 0; i < n && _best > 1; i++) {
+			if (i < 64 && !(make >> i & 1)) continue;
+
+			//the jumps asleep here, or searched before this one, sleep below it while they commute with it
+			std::uint64_t* next = &_sleep[(_depth + 1) * _words];
+			const std::uint64_t* commuting = &_commuting[legal[i] * _words];
+			for (std::size_t w = 0; w < _words; w++)
+				next[w] = sleeping[w] & commuting[w];
+
+			_stack[_depth] = { (std::uint16_t)i, (std::uint16_t)n };
+			_depth++;
+
+			//a stopped search leaves the stack where it stopped, for the checkpoint
+			if (!_reach(s ^ jumps[legal[i]].flip)) return false;
+			_depth--;
+			sleeping[legal[i] / 64] |= std::uint64_t(1) << (legal[i] % 64);
+		}
+
+		//positions are only kept once every jump they make has been searched, and the search
+		//below may have replaced this one, so it is looked up again
+		auto* kept = _reached.find(s);
+		if (kept != nullptr)
+			*kept &= asleep;
+		else
+			_store(_reached, s, asleep);
+		return true;
+	}
+
+	template<typename T, typename V>
+	void solver::_store(T& table, t_state s, V value) {
+		table.store(s, value);
+		if (!table.is_full() || _memory_noted) return;
+
+		std::stringstream ss;
+		ss << "At " << _nodes << " nodes, the table filled up with " << table.size()
+			<< " positions, and new positions now replace ones with fewer pegs";
+		_memory_events.push_back(ss.str());
+		_memory_noted = true;
+	}
+
+	std::size_t solver::_table_limit() const noexcept {
+		std::size_t stack = _stack.capacity() * sizeof(_stack[0]);
+		if (_memory_limit == 0) return 0;
+		return _memory_limit > stack ? _memory_limit - stack : 1;
+	}
+
+	void solver::_apply_memory_limit() {
+		_tt.set_limit(_table_limit());
+		_reached.set_limit(_table_limit());
+		if (_memory_limit == 0 || _tt.get_max_slots() != 0 || _memory_noted) return;
+
+		_memory_events.push_back("The memory limit leaves no room for any position, searching without a table");
+		_memory_noted = true;
+	}
+
+	void solver::_tick() {
+		double now = get_seconds();
+
+		if (_progress != nullptr && _progress_seconds > 0 && now >= _next_progress) {
+			double rate = (_nodes - _progress_nodes) / (_progress_seconds + now - _next_progress);
+			*_progress << "[" << std::fixed << std::setprecision(0) << now << "s] "
+				<< _nodes << " nodes, " << rate << " nodes/sec, "
+				<< get_table_size() << " positions stored, "
+				<< std::setprecision(3) << (100.0 * get_progress()) << "% done" << std::endl;
+
+			_progress_nodes = _nodes;
+			_next_progress = now + _progress_seconds;
+		}
+
+		if (!_checkpoint_path.empty() && _checkpoint_seconds > 0 && now >= _next_checkpoint) {
+			save_checkpoint(_checkpoint_path);
+			_next_checkpoint = get_seconds() + _checkpoint_seconds;
+		}
+	}
+
+}
@@ -0,0 +1,326 @@
+/**
+ * @file solver.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the solver class, which finds the best achievable outcome of a position.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_SOLVER__
+#define __H_TRIANGLE_SOLVER_SOLVER__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "bounded_table.h"
+#include "jump_table.h"
+#include "shared_table.h"
+
+namespace TriangleGame {
+
+	const int UNSOLVED = -1; //!< Returned by the solver when the search was stopped before it finished.
+	const int SHARED_MIN_PEGS = 6; //!< Positions with fewer pegs are not shared, they are quicker to search again.
+
+	typedef bounded_table<t_state, std::uint8_t, state_hash> t_transposition_table; //!< Positions mapped to the fewest pegs that can be left.
+	typedef bounded_table<t_state, std::uint64_t, state_hash> t_reached_table; //!< Positions mapped to the jumps asleep every time they were reached, by their index in the legal jumps.
+
+	/**
+	 * @brief The Solver Class, finds the fewest pegs that can be left from a position.
+	 *
+	 * The search is a depth first search over the jump table, every finished position is
+	 * stored in a transposition table, which is kept between searches. Positions are only
+	 * stored once they have been fully searched, so a search that is stopped part way
+	 * leaves the table correct, and the next search carries on from where it got to.
+	 *
+	 * The same property makes long solves resumable: a checkpoint is the root position,
+	 * the counters, the current search stack and the transposition table, and resuming
+	 * loads the table and searches the root again, walking straight back down the stack
+	 * through positions that are already solved. Checkpoints are written to a temporary
+	 * file and renamed over the old one, so a crash while writing keeps the last one.
+	 *
+	 * Two jumps that touch different holes commute, both orders reach the same position,
+	 * and the table only catches the second order once it has been generated. With the
+	 * partial order reduction on, solve instead carries a sleep set down the search: once
+	 * a jump has been searched, it sleeps in the positions reached by the jumps after it,
+	 * for as long as it commutes with every jump made, as making it there would only reach
+	 * a position the search has already been through. The fewest pegs left is the fewest
+	 * pegs of any position reached, and every position is still reached, but a position's
+	 * own result then only covers the jumps it made, so it can not be kept as exact.
+	 * Instead each position keeps the jumps that were asleep every time it was reached,
+	 * and reaching it again only makes the ones that are awake now, as in a sleep set
+	 * search with state caching.
+	 *
+	 * With a memory limit, the tables never grow past it. Once a table is as big as the
+	 * limit lets it be, a new position replaces one with fewer pegs, which is cheaper to
+	 * search again, so the table stays full of the most expensive positions. A limit too
+	 * small for any table leaves the search without one. The results are the same, only slower.
+	 * Solvers on different threads can share their results through a shared_table: a
+	 * position missing from the solver's own table is looked up in the shared one before
+	 * it is searched, and every position searched is added to it.
+	 */
+	class solver {
+		public:
+			/**
+			 * @brief Construct a new solver for the given board.
+			 *
+			 * @param table The jumps of the board, must outlive the solver.
+			 */
+			solver(const jump_table& table);
+
+			/**
+			 * @brief Sets a flag that stops the search when it becomes true.
+			 *
+			 * @param stop The flag to check, or nullptr to never stop.
+			 */
+			void set_stop_flag(const std::atomic<bool>* stop) noexcept;
+
+			/**
+			 * @brief Turns the partial order reduction of solve on or off, it is off by default.
+			 * get_best_jump always searches every jump, as it needs the result of each one.
+			 *
+			 * @param on True to skip the orders of commuting jumps that are reached another way.
+			 */
+			void set_reduction(bool on) noexcept;
+
+			/**
+			 * @brief Sets the most memory the solver's tables can use.
+			 *
+			 * @param bytes The memory limit, or 0 for no limit.
+			 */
+			void set_memory_limit(std::size_t bytes) noexcept;
+
+			/**
+			 * @brief Shares the results of solve with other solvers on the same board.
+			 * Only positions with SHARED_MIN_PEGS or more pegs are shared, and the partial
+			 * order reduction does not use the table.
+			 *
+			 * @param table The table to share, must outlive the solver, or nullptr to not share.
+			 */
+			void set_shared_table(shared_table* table) noexcept;
+
+			/**
+			 * @brief Returns the number of positions found in the shared table, since the solver was created.
+			 *
+			 * @return std::uint64_t The number of positions found.
+			 */
+			std::uint64_t get_shared_hits() const noexcept;
+
+			/**
+			 * @brief Finds the fewest pegs that can be left from the given position.
+			 *
+			 * @param s The position to search.
+			 * @return int The fewest pegs that can be left, or UNSOLVED if the search was stopped.
+			 */
+			int solve(t_state s);
+
+			/**
+			 * @brief Finds the jump that leads to the fewest pegs left.
+			 * When several jumps are equally good, the first in the jump table is returned.
+			 *
+			 * @param s The position to search.
+			 * @param id The returned jump, not set when there are no jumps left.
+			 * @param pegsLeft The returned fewest pegs that can be left.
+			 * @return true If a jump was found.
+			 * @return false If there are no jumps left, or the search was stopped.
+			 */
+			bool get_best_jump(t_state s, t_jump_id& id, int& pegsLeft);
+
+			/**
+			 * @brief Writes a checkpoint to the given file every interval, while solving.
+			 *
+			 * @param path The file to write, or empty to not write checkpoints.
+			 * @param seconds The time between checkpoints.
+			 */
+			void set_checkpoint(const std::string& path, double seconds);
+
+			/**
+			 * @brief Writes a progress line to the given stream every interval, while solving.
+			 *
+			 * @param out The stream to write to, or nullptr to not report progress.
+			 * @param seconds The time between progress lines.
+			 */
+			void set_progress(std::ostream* out, double seconds);
+
+			/**
+			 * @brief Writes the solve to a checkpoint file.
+			 *
+			 * @param path The file to write.
+			 * @return true If the checkpoint was written.
+			 * @return false Otherwise.
+			 */
+			bool save_checkpoint(const std::string& path) const;
+
+			/**
+			 * @brief Loads a checkpoint written by save_checkpoint, for the same board.
+			 * The transposition table and counters are replaced by the checkpoint's.
+			 *
+			 * @param path The file to read.
+			 * @param root The returned position being solved.
+			 * @return true If the checkpoint was loaded.
+			 * @return false If the file could not be read, or is for a different board.
+			 */
+			bool load_checkpoint(const std::string& path, t_state& root);
+
+			/**
+			 * @brief Estimates how much of the current solve is done, from the position in
+			 * the search stack. Each jump of a position is assumed to be the same amount of work.
+			 *
+			 * @return double The fraction done, between 0 and 1.
+			 */
+			double get_progress() const noexcept;
+
+			/**
+			 * @brief Returns the time spent solving, including the time before a checkpoint was loaded.
+			 *
+			 * @return double The time, in seconds.
+			 */
+			double get_seconds() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions expanded since the solver was created.
+			 *
+			 * @return std::uint64_t The number of positions expanded.
+			 */
+			std::uint64_t get_nodes() const noexcept;
+
+			/**
+			 * @brief Returns the number of positions stored, in the transposition table, or
+			 * the table of positions reached when the partial order reduction is on.
+			 *
+			 * @return std::size_t The number of positions stored.
+			 */
+			std::size_t get_table_size() const noexcept;
+
+			/**
+			 * @brief Returns the estimated memory used by the solver's tables.
+			 *
+			 * @return std::size_t The memory used, in bytes.
+			 */
+			std::size_t get_memory_used() const noexcept;
+
+			/**
+			 * @brief Returns the most memory the solver's tables have used.
+			 *
+			 * @return std::size_t The peak memory, in bytes.
+			 */
+			std::size_t get_peak_memory() const noexcept;
+
+			/**
+			 * @brief Returns a line for each step the search was degraded by, to stay in the memory limit.
+			 *
+			 * @return const std::vector<std::string>& The steps, in the order they happened.
+			 */
+			const std::vector<std::string>& get_memory_events() const noexcept;
+
+			/**
+			 * @brief Returns the number of jumps never made by the partial order reduction, since the solver was created.
+			 *
+			 * @return std::uint64_t The number of jumps skipped.
+			 */
+			std::uint64_t get_pruned() const noexcept;
+
+			/**
+			 * @brief Returns the number of table lookups, since the solver was created.
+			 *
+			 * @return std::uint64_t The number of lookups.
+			 */
+			std::uint64_t get_probes() const noexcept;
+
+			/**
+			 * @brief Empties the transposition table.
+			 */
+			void clear();
+
+		private:
+			const jump_table& _table; //!< The jumps of the board.
+			const std::atomic<bool>* _stop; //!< Stops the search when true.
+			t_transposition_table _tt; //!< The solved positions.
+			t_reached_table _reached; //!< The positions reached by the partial order reduction.
+			shared_table* _shared; //!< The table shared with other solvers, or nullptr.
+			std::uint64_t _shared_hits; //!< The number of positions found in the shared table.
+			bool _reduction; //!< True when solve skips the orders of commuting jumps.
+			int _best; //!< The fewest pegs of any position reached by the partial order reduction.
+			std::uint64_t _nodes; //!< The number of positions expanded.
+			std::uint64_t _pruned; //!< The number of jumps skipped.
+			std::uint64_t _probes; //!< The number of table lookups.
+
+			std::size_t _memory_limit; //!< The most memory the tables can use, 0 for no limit.
+			bool _memory_noted; //!< True once the table filling up to the limit has been noted.
+			std::vector<std::string> _memory_events; //!< The steps the search was degraded by.
+			t_state _root; //!< The position being solved.
+
+			std::vector<std::pair<std::uint16_t, std::uint16_t> > _stack; //!< The jump being searched, and the jump count, at each depth.
+			std::size_t _words; //!< The words of a set of jumps, with a bit for each jump.
+			std::vector<std::uint64_t> _commuting; //!< The set of jumps each jump commutes with.
+			std::vector<std::uint64_t> _sleep; //!< The set of jumps asleep at each depth, for the partial order reduction.
+			int _depth; //!< The depth of the position being searched.
+			bool _solving; //!< True while solve is running.
+
+			double _seconds; //!< The time spent solving before the current solve started.
+			std::chrono::steady_clock::time_point _started; //!< When the current solve started.
+
+			std::string _checkpoint_path; //!< The checkpoint file, or empty.
+			double _checkpoint_seconds; //!< The time between checkpoints.
+			double _next_checkpoint; //!< When the next checkpoint is due, in solve seconds.
+			std::ostream* _progress; //!< Where progress is reported, or nullptr.
+			double _progress_seconds; //!< The time between progress lines.
+			double _next_progress; //!< When the next progress line is due, in solve seconds.
+			std::uint64_t _progress_nodes; //!< The node count of the last progress line.
+
+			/**
+			 * @brief Searches the given position.
+			 *
+			 * @param s The position to search.
+			 * @return int The fewest pegs that can be left, or UNSOLVED.
+			 */
+			int _search(t_state s);
+
+			/**
+			 * @brief Reaches every position from the given one, without the jumps in its
+			 * sleep set, and keeps the fewest pegs seen.
+			 *
+			 * @param s The position to search, its sleep set is the one at the current depth.
+			 * @return true If the search finished.
+			 * @return false If the search was stopped.
+			 */
+			bool _reach(t_state s);
+
+			/**
+			 * @brief Stores a position in a table, noting when the table has filled up to the memory limit.
+			 *
+			 * @param table The table to add to, _tt or _reached.
+			 * @param s The position.
+			 * @param value The position's value.
+			 */
+			template<typename T, typename V>
+			void _store(T& table, t_state s, V value);
+
+			/**
+			 * @brief Returns the memory the memory limit leaves the tables, after the search stack.
+			 *
+			 * @return std::size_t The memory, in bytes, 0 for no limit.
+			 */
+			std::size_t _table_limit() const noexcept;
+
+			/**
+			 * @brief Limits the tables to the memory left by the search stack, before a search.
+			 */
+			void _apply_memory_limit();
+
+			/**
+			 * @brief Writes progress and checkpoints that are due, called every few thousand nodes.
+			 */
+			void _tick();
+	};
+
+}
+
+#endif
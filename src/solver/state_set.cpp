@@ -0,0 +1,278 @@
+#include "state_set.h"
+#include "../board/trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <queue>
+
+namespace TriangleGame {
+
+	namespace {
+
+		const std::size_t IO_BUFFER_BYTES = 1 << 16; //!< The size of the read and write buffers.
+
+		void put_varint(std::vector<char>& out, std::uint64_t v) {
+			while (v >= 0x80) {
+				out.push_back((char)(v | 0x80));
+				v >>= 7;
+			}
+			out.push_back((char)v);
+		}
+
+	}
+
+	//--------------------------------------------------
+	// State Set
+	//--------------------------------------------------
+
+	state_set::state_set()
+		: _size(0), _bytes(0)
+	{
+
+	}
+
+	state_set::state_set(std::vector<t_state>&& states)
+		: _states(std::move(states)), _size(0), _bytes(0)
+	{
+		_size = _states.size();
+	}
+
+	state_set::state_set(state_set&& other) noexcept
+		: _states(std::move(other._states)), _path(std::move(other._path)), _size(other._size), _bytes(other._bytes)
+	{
+		other._path.clear();
+		other._size = 0;
+		other._bytes = 0;
+	}
+
+	state_set& state_set::operator=(state_set&& other) noexcept {
+		if (this != &other) {
+			clear();
+			_states = std::move(other._states);
+			_path = std::move(other._path);
+			_size = other._size;
+			_bytes = other._bytes;
+			other._path.clear();
+			other._size = 0;
+			other._bytes = 0;
+		}
+		return *this;
+	}
+
+	state_set::~state_set() {
+		clear();
+	}
+
+	std::uint64_t state_set::size() const noexcept {
+		return _size;
+	}
+
+	bool state_set::on_disk() const noexcept {
+		return !_path.empty();
+	}
+
+	std::uint64_t state_set::get_file_bytes() const noexcept {
+		return _bytes;
+	}
+
+	state_set::reader state_set::read() const {
+		return reader(*this);
+	}
+
+	void state_set::clear() {
+		if (!_path.empty())
+			std::remove(_path.c_str());
+		_path.clear();
+		_states.clear();
+		_states.shrink_to_fit();
+		_size = 0;
+		_bytes = 0;
+	}
+
+	bool state_set::move_to_disk(const std::string& path) {
+		TRIANGLE_TRACE("state_set::move_to_disk");
+		if (on_disk()) return true;
+
+		std::size_t i = 0;
+		auto written = state_set();
+		bool ok = _write(path, [this, &i](t_state& s) -> bool {
+			if (i == _states.size()) return false;
+			s = _states[i++];
+			return true;
+		}, written);
+
+		if (!ok) return false;
+		*this = std::move(written);
+		return true;
+	}
+
+	//--------------------------------------------------
+	// State Set Reader
+	//--------------------------------------------------
+
+	state_set::reader::reader(const state_set& set)
+		: _set(set), _index(0), _last(0), _pos(0), _end(0)
+	{
+		if (_set.on_disk()) {
+			_in = std::make_unique<std::ifstream>(_set._path, std::ios::binary);
+			_buffer.resize(IO_BUFFER_BYTES);
+		}
+	}
+
+	bool state_set::reader::next(t_state& s) {
+		if (_index >= _set._size) return false;
+
+		if (!_set.on_disk()) {
+			s = _set._states[_index++];
+			return true;
+		}
+
+		std::uint64_t delta = 0;
+		unsigned char c;
+		for (int shift = 0; shift < 64; shift += 7) {
+			if (!_get(c)) return false;
+			delta |= (std::uint64_t)(c & 0x7F) << shift;
+			if (!(c & 0x80)) break;
+		}
+
+		_last += delta;
+		s = _last;
+		_index++;
+		return true;
+	}
+
+	bool state_set::reader::_get(unsigned char& c) {
+		if (_pos == _end) {
+			if (!_in || !*_in) return false;
+			_in->read(_buffer.data(), _buffer.size());
+			_end = (std::size_t)_in->gcount();
+			_pos = 0;
+			if (_end == 0) return false;
+		}
+		c = (unsigned char)_buffer[_pos++];
+		return true;
+	}
+
+	//--------------------------------------------------
+	// State Set Writer
+	//--------------------------------------------------
+
+	state_set_writer::state_set_writer(const std::string& path, std::size_t memoryLimit)
+		: _path(path), _limit(std::max<std::size_t>(memoryLimit / sizeof(t_state), 1024))
+	{
+
+	}
+
+	bool state_set_writer::add(t_state s) {
+		_buffer.push_back(s);
+		if (_buffer.size() < _limit) return true;
+
+		//duplicates are common, so only spill when sorting does not free enough room
+		_sort_buffer();
+		if (_buffer.size() < _limit / 2) return true;
+		return _spill();
+	}
+
+	bool state_set_writer::finish(state_set& set) {
+		_sort_buffer();
+
+		if (_runs.empty()) {
+			set = state_set(std::move(_buffer));
+			_buffer = std::vector<t_state>();
+			return true;
+		}
+
+		if (!_buffer.empty() && !_spill()) return false;
+
+		//k-way merge of the runs, dropping duplicates
+		auto readers = std::vector<state_set::reader>();
+		for (const auto& run : _runs)
+			readers.emplace_back(run);
+
+		typedef std::pair<t_state, std::size_t> t_head;
+		auto heads = std::priority_queue<t_head, std::vector<t_head>, std::greater<t_head> >();
+		for (std::size_t r = 0; r < readers.size(); r++) {
+			t_state s;
+			if (readers[r].next(s)) heads.push({ s, r });
+		}
+
+		bool first = true;
+		t_state last = 0;
+		bool ok = state_set::_write(_path, [&](t_state& s) -> bool {
+			while (!heads.empty()) {
+				auto head = heads.top();
+				heads.pop();
+
+				t_state following;
+				if (readers[head.second].next(following))
+					heads.push({ following, head.second });
+
+				if (first || head.first != last) {
+					first = false;
+					last = s = head.first;
+					return true;
+				}
+			}
+			return false;
+		}, set);
+
+		readers.clear();
+		_runs.clear();
+		return ok;
+	}
+
+	void state_set_writer::_sort_buffer() {
+		std::sort(_buffer.begin(), _buffer.end());
+		_buffer.erase(std::unique(_buffer.begin(), _buffer.end()), _buffer.end());
+	}
+
+	bool state_set_writer::_spill() {
+		TRIANGLE_TRACE("state_set_writer::spill");
+		std::size_t i = 0;
+		auto run = state_set();
+		std::string path = _path + ".run" + std::to_string(_runs.size());
+
+		_sort_buffer();
+		bool ok = state_set::_write(path, [this, &i](t_state& s) -> bool {
+			if (i == _buffer.size()) return false;
+			s = _buffer[i++];
+			return true;
+		}, run);
+
+		_buffer.clear();
+		_runs.push_back(std::move(run));
+		return ok;
+	}
+
+	bool state_set::_write(const std::string& path, const std::function<bool(t_state&)>& next, state_set& set) {
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out) return false;
+
+		auto buffer = std::vector<char>();
+		buffer.reserve(IO_BUFFER_BYTES + 10);
+
+		auto written = state_set();
+		written._path = path;
+
+		t_state last = 0, s;
+		while (next(s)) {
+			put_varint(buffer, s - last);
+			last = s;
+			written._size++;
+
+			if (buffer.size() >= IO_BUFFER_BYTES) {
+				out.write(buffer.data(), buffer.size());
+				written._bytes += buffer.size();
+				buffer.clear();
+			}
+		}
+
+		out.write(buffer.data(), buffer.size());
+		written._bytes += buffer.size();
+		out.close();
+
+		set = std::move(written);
+		return out.good();
+	}
+
+}
@@ -0,0 +1,218 @@
+/**
+ * @file state_set.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the state_set class, a sorted set of positions that can spill to disk.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_STATE_SET__
+#define __H_TRIANGLE_SOLVER_STATE_SET__
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "jump_table.h"
+
+namespace TriangleGame {
+
+	/**
+	 * @brief The State Set Class, a sorted list of unique positions, in memory or in a file.
+	 *
+	 * Sets that are written to disk are delta encoded: each position is stored as the
+	 * varint of its difference from the one before, which for a sorted set of similar
+	 * positions is usually two or three bytes instead of eight.
+	 */
+	class state_set {
+		public:
+			/**
+			 * @brief Reads a state_set from the start, in sorted order.
+			 */
+			class reader {
+				public:
+					/**
+					 * @brief Construct a new reader for the given set.
+					 *
+					 * @param set The set to read, must outlive the reader.
+					 */
+					reader(const state_set& set);
+
+					/**
+					 * @brief Reads the next position.
+					 *
+					 * @param s The returned position.
+					 * @return true If a position was read.
+					 * @return false If the end of the set was reached.
+					 */
+					bool next(t_state& s);
+
+				private:
+					const state_set& _set; //!< The set being read.
+					std::uint64_t _index; //!< The number of positions read.
+					t_state _last; //!< The last position read, the base of the next delta.
+					std::unique_ptr<std::ifstream> _in; //!< The file, when the set is on disk.
+					std::vector<char> _buffer; //!< The unread bytes of the file.
+					std::size_t _pos; //!< The next byte of the buffer.
+					std::size_t _end; //!< The number of bytes in the buffer.
+
+					/**
+					 * @brief Reads the next byte of the file.
+					 *
+					 * @param c The returned byte.
+					 * @return true If a byte was read.
+					 * @return false At the end of the file.
+					 */
+					bool _get(unsigned char& c);
+			};
+
+			/**
+			 * @brief Construct a new, empty, set in memory.
+			 */
+			state_set();
+
+			/**
+			 * @brief Construct a new set in memory from sorted, unique, positions.
+			 *
+			 * @param states The positions.
+			 */
+			state_set(std::vector<t_state>&& states);
+
+			state_set(const state_set&) = delete; //!< Sets own their file, so they can only be moved.
+			state_set(state_set&& other) noexcept;
+			state_set& operator=(const state_set&) = delete;
+			state_set& operator=(state_set&& other) noexcept;
+
+			/**
+			 * @brief Destroy the set, and delete its file.
+			 */
+			~state_set();
+
+			/**
+			 * @brief Returns the number of positions in the set.
+			 *
+			 * @return std::uint64_t The number of positions.
+			 */
+			std::uint64_t size() const noexcept;
+
+			/**
+			 * @brief Determinds if the set is stored in a file.
+			 *
+			 * @return true If the set is on disk.
+			 * @return false If the set is in memory.
+			 */
+			bool on_disk() const noexcept;
+
+			/**
+			 * @brief Returns the size of the set's file.
+			 *
+			 * @return std::uint64_t The number of bytes, 0 when the set is in memory.
+			 */
+			std::uint64_t get_file_bytes() const noexcept;
+
+			/**
+			 * @brief Starts reading the set.
+			 *
+			 * @return reader A reader at the first position.
+			 */
+			reader read() const;
+
+			/**
+			 * @brief Empties the set, and deletes its file.
+			 */
+			void clear();
+
+			/**
+			 * @brief Moves a set that is in memory into a file, to free its memory.
+			 *
+			 * @param path The file to write.
+			 * @return true If the set is on disk.
+			 * @return false If the file could not be written.
+			 */
+			bool move_to_disk(const std::string& path);
+
+		private:
+			std::vector<t_state> _states; //!< The positions, when the set is in memory.
+			std::string _path; //!< The file, when the set is on disk.
+			std::uint64_t _size; //!< The number of positions.
+			std::uint64_t _bytes; //!< The size of the file.
+
+			friend class state_set_writer;
+
+			/**
+			 * @brief Writes sorted, unique, positions to a file.
+			 *
+			 * @param path The file to write.
+			 * @param next Called for each position, returns false after the last one.
+			 * @param set The returned set.
+			 * @return true If the file was written.
+			 * @return false Otherwise.
+			 */
+			static bool _write(const std::string& path, const std::function<bool(t_state&)>& next, state_set& set);
+	};
+
+	/**
+	 * @brief The State Set Writer Class, builds a state_set from positions in any order, with duplicates.
+	 *
+	 * Positions are collected in memory until the memory limit, then sorted, deduplicated
+	 * and spilled to a run file. Finishing merges the runs into a single file, or, when
+	 * nothing was spilled, keeps the set in memory.
+	 */
+	class state_set_writer {
+		public:
+			/**
+			 * @brief Construct a new writer.
+			 *
+			 * @param path The file to write the set to, if it does not fit in memory.
+			 * @param memoryLimit The most bytes of positions to hold in memory.
+			 */
+			state_set_writer(const std::string& path, std::size_t memoryLimit);
+
+			/**
+			 * @brief Adds a position to the set.
+			 *
+			 * @param s The position.
+			 * @return true If the position was added.
+			 * @return false If a run could not be written.
+			 */
+			bool add(t_state s);
+
+			/**
+			 * @brief Sorts and merges every position added into a set.
+			 *
+			 * @param set The returned set.
+			 * @return true If the set was built.
+			 * @return false If a file could not be written.
+			 */
+			bool finish(state_set& set);
+
+		private:
+			std::string _path; //!< The file of the finished set.
+			std::size_t _limit; //!< The most positions to hold in memory.
+			std::vector<t_state> _buffer; //!< The positions not yet spilled.
+			std::vector<state_set> _runs; //!< The spilled runs.
+
+			/**
+			 * @brief Sorts and deduplicates the buffer.
+			 */
+			void _sort_buffer();
+
+			/**
+			 * @brief Spills the buffer to a new run file.
+			 *
+			 * @return true If the run was written.
+			 * @return false Otherwise.
+			 */
+			bool _spill();
+	};
+
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "symmetry_group.h"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+
+namespace TriangleGame {
+
+	namespace {
+
+		const std::uint64_t SEARCH_LIMIT = 1 << 22; //!< Gives up on boards with too many partial symmetries, keeping only the identity.
+
+	}
+
+	symmetry_group::symmetry_group(const jump_table& table) {
+		const auto& jumps = table.get_jumps();
+		const int n = table.get_hole_count();
+
+		auto has = std::vector<bool>((std::size_t)n * n * n, false);
+		auto roles = std::vector<std::tuple<int, int, int> >(n, { 0, 0, 0 });
+		auto touching = std::vector<std::vector<int> >(n);
+		for (int k = 0; k < (int)jumps.size(); k++) {
+			const auto& j = jumps[k];
+			has[((std::size_t)j.from * n + j.over) * n + j.to] = true;
+			std::get<0>(roles[j.from])++;
+			std::get<1>(roles[j.over])++;
+			std::get<2>(roles[j.to])++;
+			for (int h : { (int)j.from, (int)j.over, (int)j.to })
+				touching[h].push_back(k);
+		}
+
+		//map holes in breadth first order, so each hole shares a jump with holes already mapped
+		auto order = std::vector<int>();
+		auto seen = std::vector<bool>(n, false);
+		for (int root = 0; root < n; root++) {
+			if (seen[root]) continue;
+			seen[root] = true;
+			order.push_back(root);
+			for (std::size_t q = order.size() - 1; q < order.size(); q++) {
+				for (int k : touching[order[q]]) {
+					for (int h : { (int)jumps[k].from, (int)jumps[k].over, (int)jumps[k].to }) {
+						if (!seen[h]) { seen[h] = true; order.push_back(h); }
+					}
+				}
+			}
+		}
+
+		auto map = t_hole_map(n, -1);
+		auto used = std::vector<bool>(n, false);
+		std::uint64_t steps = 0;
+
+		std::function<bool(int)> search = [&](int pos) -> bool {
+			if (++steps > SEARCH_LIMIT) return false;
+			if (pos == n) {
+				_maps.push_back(map);
+				return true;
+			}
+
+			int h = order[pos];
+			for (int v = 0; v < n; v++) {
+				if (used[v] || roles[v] != roles[h]) continue;
+				map[h] = v;
+
+				//every jump whose holes are all mapped must map onto a jump
+				bool ok = true;
+				for (int k : touching[h]) {
+					int a = map[jumps[k].from], b = map[jumps[k].over], c = map[jumps[k].to];
+					if (a < 0 || b < 0 || c < 0) continue;
+					if (!has[((std::size_t)a * n + b) * n + c]) { ok = false; break; }
+				}
+
+				if (ok) {
+					used[v] = true;
+					bool finished = search(pos + 1);
+					used[v] = false;
+					if (!finished) return false;
+				}
+			}
+			map[h] = -1;
+			return true;
+		};
+
+		if (!search(0) || _maps.empty()) {
+			_maps.clear();
+			auto identity = t_hole_map(n);
+			for (int h = 0; h < n; h++) identity[h] = h;
+			_maps.push_back(identity);
+		}
+
+		//keep the identity first, so canonical can skip it
+		auto identity = std::find_if(_maps.begin(), _maps.end(), [](const t_hole_map& m) {
+			for (int h = 0; h < (int)m.size(); h++)
+				if (m[h] != h) return false;
+			return true;
+		});
+		std::iter_swap(_maps.begin(), identity);
+
+		for (const auto& m : _maps) {
+			auto bytes = t_byte_maps();
+			for (int byte = 0; byte < 8; byte++) {
+				for (int value = 0; value < 256; value++) {
+					t_state mapped = 0;
+					for (int bit = 0; bit < 8; bit++) {
+						int h = byte * 8 + bit;
+						if ((value >> bit & 1) && h < n)
+							mapped |= t_state(1) << m[h];
+					}
+					bytes[byte][value] = mapped;
+				}
+			}
+			_bytes.push_back(bytes);
+		}
+	}
+
+	int symmetry_group::size() const noexcept {
+		return (int)_maps.size();
+	}
+
+	const std::vector<t_hole_map>& symmetry_group::get_maps() const noexcept {
+		return _maps;
+	}
+
+	t_state symmetry_group::apply(t_state s, int symmetry) const noexcept {
+		const auto& bytes = _bytes[symmetry];
+		t_state mapped = 0;
+		for (int byte = 0; byte < 8; byte++)
+			mapped |= bytes[byte][(s >> (8 * byte)) & 0xFF];
+		return mapped;
+	}
+
+	t_state symmetry_group::canonical(t_state s) const noexcept {
+		t_state best = s;
+		for (int g = 1; g < (int)_bytes.size(); g++)
+			best = std::min(best, apply(s, g));
+		return best;
+	}
+
+}
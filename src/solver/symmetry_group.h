@@ -0,0 +1,83 @@
+/**
+ * @file symmetry_group.h
+ * @author James Little <james@jameslittle.org>
+ * @brief This file contains the symmetry_group class, which finds the symmetries of a board.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+#ifndef __H_TRIANGLE_SOLVER_SYMMETRY_GROUP__
+#define __H_TRIANGLE_SOLVER_SYMMETRY_GROUP__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "jump_table.h"
+
+namespace TriangleGame {
+
+	typedef std::vector<int> t_hole_map; //!< A symmetry, the hole each hole is mapped to.
+
+	/**
+	 * @brief The Symmetry Group Class, every way the holes can be renumbered without changing the jumps.
+	 *
+	 * The symmetries are found from the jump table alone, by searching for the hole
+	 * permutations that map every jump onto a jump, so they also work for boards read
+	 * from a file. The triangle has 6, the English and European boards 8, and the hexagon 12.
+	 * Positions that are symmetric have the same outcome, so searches only need to
+	 * visit one of them, the canonical position.
+	 */
+	class symmetry_group {
+		public:
+			/**
+			 * @brief Finds the symmetries of the given board.
+			 *
+			 * @param table The jumps of the board.
+			 */
+			symmetry_group(const jump_table& table);
+
+			/**
+			 * @brief Returns the number of symmetries, including the identity.
+			 *
+			 * @return int The number of symmetries.
+			 */
+			int size() const noexcept;
+
+			/**
+			 * @brief Returns the symmetries.
+			 *
+			 * @return const std::vector<t_hole_map>& The symmetries, the identity first.
+			 */
+			const std::vector<t_hole_map>& get_maps() const noexcept;
+
+			/**
+			 * @brief Maps a position through one of the symmetries.
+			 *
+			 * @param s The position.
+			 * @param symmetry The index of the symmetry.
+			 * @return t_state The mapped position.
+			 */
+			t_state apply(t_state s, int symmetry) const noexcept;
+
+			/**
+			 * @brief Returns the canonical position, the smallest of the position's symmetric positions.
+			 *
+			 * @param s The position.
+			 * @return t_state The canonical position.
+			 */
+			t_state canonical(t_state s) const noexcept;
+
+		private:
+			typedef std::array<std::array<t_state, 256>, 8> t_byte_maps; //!< A symmetry as the mapped bits of each byte value.
+
+			std::vector<t_hole_map> _maps; //!< The symmetries.
+			std::vector<t_byte_maps> _bytes; //!< The symmetries, as byte lookup tables.
+	};
+
+}
+
+#endif